@@ -273,10 +273,10 @@ inline int FloatToString(char* ptr, float f, int afterpoint)
 inline bool aStartsWith(const char** curr, const char* str)
 {
     const char* currStart = *curr;
-    while (IsWhitespace(**curr)) curr++;
-    if (**curr != *str) return false;
+    while (IsWhitespace(**curr)) (*curr)++;
+    if (**curr != *str) { *curr = currStart; return false; }
     while (*str && **curr == *str)
-        *curr++, str++;
+        (*curr)++, str++;
     bool isEqual = *str == 0;
     if (!isEqual) *curr = currStart;
     return isEqual;
@@ -348,7 +348,8 @@ static inline void aCopyInt32(int* dst, const int* src, int n)
         dst[i] = src[i];
 }
 
-#define StrCMP16(_str, _otr) StrCmp16(_str, _otr, sizeof(_otr)) 
+#define StrCMP16(_str, _otr) StrCmp16(_str, _otr, sizeof(_otr)) // exact compare, null terminator included
+#define StrPrefixCMP16(_str, _otr) StrCmp16(_str, _otr, sizeof(_otr) - 1) // prefix compare, without null terminator
  
 #if defined(AX_SUPPORT_SSE)
 static inline bool StrCmp16(const char* a, const char* b, uint64_t n)
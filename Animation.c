@@ -17,6 +17,7 @@
 // #include "SceneRenderer.h"
 #include "Platform.h"
 #include "Algorithm.h"
+#include "JobSystem.h"
 #include "Math/Half.h"
 
 // <<<<<<<        prefab         >>>>>>>>>>>>
@@ -67,13 +68,120 @@ int Prefab_FindNodeFromName(SceneBundle* prefab, const char* name)
 }
 
 
+void Prefab_FindSubtreeRange(SceneBundle* prefab, int nodeIndex, int* begin, int* end)
+{
+    const int* order   = prefab->nodeOrder;
+    const int* parents = prefab->nodeParents;
+    int i = 0;
+    while (order[i] != nodeIndex) i++;
+    *begin = i;
+
+    // depth first order, subtree ends at the first node whose parent is not in the subtree
+    uint8_t* inSubtree = rpcalloc(prefab->numNodes, 1);
+    inSubtree[nodeIndex] = 1;
+    for (i = i + 1; i < prefab->numNodes && parents[i] != -1 && inSubtree[parents[i]]; i++)
+        inSubtree[order[i]] = 1;
+    
+    *end = i;
+    rpfree(inSubtree);
+}
+
+void NodeTransforms_Create(ANodeTransforms* transforms, SceneBundle* prefab)
+{
+    int numNodes = prefab->numNodes;
+    transforms->numNodes     = numNodes;
+    transforms->translations = AllocAligned(sizeof(Vector4x32f) * numNodes * 3, 16);
+    transforms->rotations    = transforms->translations + numNodes;
+    transforms->scales       = transforms->rotations + numNodes;
+    transforms->dirty.size    = (numNodes + 63) / 64;
+    transforms->dirty.numBits = numNodes;
+    transforms->dirty.bits    = rpmalloc(sizeof(uint64_t) * transforms->dirty.size);
+    for (int i = 0; i < transforms->dirty.size; i++)
+        transforms->dirty.bits[i] = ~0ull; // all of the world matrices has to be calculated first time
+
+    for (int i = 0; i < numNodes; i++)
+    {
+        ANode* node = &prefab->nodes[prefab->nodeOrder[i]];
+        transforms->translations[i] = VecLoad(node->translation);
+        transforms->rotations[i]    = VecLoad(node->rotation);
+        transforms->scales[i]       = VecLoad(node->scale);
+    }
+}
+
+void NodeTransforms_Destroy(ANodeTransforms* transforms)
+{
+    if (transforms->translations) FreeAligned(transforms->translations);
+    if (transforms->dirty.bits) rpfree(transforms->dirty.bits);
+    MemsetZero(transforms, sizeof(ANodeTransforms));
+}
+
+void NodeTransforms_Set(ANodeTransforms* transforms, SceneBundle* prefab, int index, Vector4x32f translation, Vector4x32f rotation, Vector4x32f scale)
+{
+    transforms->translations[index] = translation;
+    transforms->rotations[index]    = rotation;
+    transforms->scales[index]       = scale;
+    Bitset_Set(&transforms->dirty, prefab->nodeOrder[index]);
+}
+
+int UpdateWorldMatrices(Matrix4* worldMatrices, ANodeTransforms* locals, SceneBundle* prefab, int begin, int end, Matrix4 parentMatrix)
+{
+    const int* order   = prefab->nodeOrder;
+    const int* parents = prefab->nodeParents;
+    Bitset* dirty = &locals->dirty;
+    int numUpdated = 0;
+
+    for (int i = begin; i < end; i++)
+    {
+        bool isRoot = i == begin || parents[i] == -1;
+        // parents are visited first, so a dirty parent marks the whole subtree
+        if (!Bitset_Get(dirty, order[i]) && (isRoot || !Bitset_Get(dirty, parents[i])))
+            continue;
+
+        Bitset_Set(dirty, order[i]);
+        Matrix4 local = PositionRotationScalePtr((const float*)&locals->translations[i], (const float*)&locals->rotations[i], (const float*)&locals->scales[i]);
+        Matrix4 parent = isRoot ? parentMatrix : worldMatrices[parents[i]];
+        worldMatrices[order[i]] = Matrix4Multiply(parent, local);
+        numUpdated++;
+    }
+
+    for (int i = begin; i < end && numUpdated > 0; i++)
+        Bitset_Reset(dirty, order[i]);
+    return numUpdated;
+}
+
 void StartAnimationSystem()
 { }
 
-static void SetBoneNode(SceneBundle* prefab, ANode** node, int* index, const char* name)
+static void InitPose(Pose* pose, ANode* nodes, int numNodes)
+{
+    for (int i = 0; i < numNodes; i++)
+    {
+        pose[i].translation = VecLoad(nodes[i].translation);
+        pose[i].rotation    = VecLoad(nodes[i].rotation);
+        // pose[i].scale    = VecLoad(nodes[i].scale);
+    }
+}
+
+// nodes after numNodes are processed by the blend kernels, identity doesn't produce nans when they are normalized
+static void ClearPoseSoAPadding(PoseSoA* pose, int numNodes)
 {
-    *index = Prefab_FindNodeFromName(prefab, name);
-    *node = &prefab->nodes[*index];
+    for (int end = (numNodes + PoseSoAPadding - 1) & ~(PoseSoAPadding - 1); numNodes < end; numNodes++)
+    {
+        pose->tx[numNodes] = pose->ty[numNodes] = pose->tz[numNodes] = 0.0f;
+        pose->rx[numNodes] = pose->ry[numNodes] = pose->rz[numNodes] = 0.0f;
+        pose->rw[numNodes] = 1.0f;
+    }
+}
+
+static void InitPoseSoA(PoseSoA* pose, const ANode* nodes, int numNodes)
+{
+    for (int i = 0; i < numNodes; i++)
+    {
+        pose->tx[i] = nodes[i].translation[0]; pose->ty[i] = nodes[i].translation[1]; pose->tz[i] = nodes[i].translation[2];
+        pose->rx[i] = nodes[i].rotation[0]; pose->ry[i] = nodes[i].rotation[1];
+        pose->rz[i] = nodes[i].rotation[2]; pose->rw[i] = nodes[i].rotation[3];
+    }
+    ClearPoseSoAPadding(pose, numNodes);
 }
 
 void AnimationController_Create(SceneBundle* prefab, AnimationController* result, bool humanoid, int lowerBodyStart)
@@ -95,81 +203,300 @@ void AnimationController_Create(SceneBundle* prefab, AnimationController* result
     result->lowerBodyIdxStart = lowerBodyStart;
 
     ASSERT(result->mRootNodeIndex < MaxBonePoses);
+    ASSERT(prefab->numNodes <= MaxBonePoses); // bone matrices and dirty bits are indexed with node index
+    result->mDirtyNodes = BitSet128_Ones();
     ASSERT(GetNodePtr(prefab, result->mRootNodeIndex)->numChildren > 0); // root node has to have children nodes
+    Prefab_FindSubtreeRange(prefab, result->mRootNodeIndex, &result->mHierarchyBegin, &result->mHierarchyEnd);
+
+    result->mKeyCursorOffsets = rpmalloc(sizeof(int) * (prefab->numAnimations + 1));
+    result->mKeyCursorOffsets[0] = 0;
+    for (int i = 0; i < prefab->numAnimations; i++)
+        result->mKeyCursorOffsets[i + 1] = result->mKeyCursorOffsets[i] + prefab->animations[i].numChannels;
+    result->mKeyCursors = rpcalloc(MMAX(result->mKeyCursorOffsets[prefab->numAnimations], 1), sizeof(uint16_t));
+    result->mClips = NULL;
+    result->mCompressedClips = NULL;
+    result->mKeyPairs = NULL;
+    result->mSpineNodeIdx = -1;
+    result->mNeckNodeIdx  = -1;
+    result->mSpineXAngle = result->mSpineYAngle = 0.0f;
+    result->mNeckXAngle  = result->mNeckYAngle  = 0.0f;
+    result->mSpineRotated = result->mNeckRotated = false;
+    InitPose(result->mNodePose, prefab->nodes, prefab->numNodes);
+    for (int i = 0; i < MaxBonePoses; i++)
+        result->mUpperBodyWeights[i] = i < lowerBodyStart ? 1.0f : 0.0f;
     
     if (!humanoid)
         return;
     
-    SetBoneNode(prefab, &result->mSpineNode, &result->mSpineNodeIdx, "mixamorig:Spine");
-    SetBoneNode(prefab, &result->mNeckNode , &result->mNeckNodeIdx , "mixamorig:Neck");
+    result->mSpineNodeIdx = Prefab_FindNodeFromName(prefab, "mixamorig:Spine");
+    result->mNeckNodeIdx  = Prefab_FindNodeFromName(prefab, "mixamorig:Neck");
 }
 
-static inline void RotateNode(ANode* node, float xAngle, float yAngle)
+static inline bool AdditiveRotationEnabled(int nodeIndex, float xAngle, float yAngle)
 {
-    Quaternion q = QMul(QMul(QFromXAngle(xAngle), QFromYAngle(yAngle)), VecLoad(node->rotation));
-    VecStore(node->rotation, q);
+    return nodeIndex != -1 && Absf(xAngle) + Absf(yAngle) > MATH_Epsilon;
 }
 
-purefn Matrix4 GetNodeMatrix(ANode* node)
+// spine and neck rotations are applied to a copy of the local rotation, pose is not accumulated
+static inline Quaternion AdditiveRotate(Quaternion rotation, float xAngle, float yAngle)
 {
-    return PositionRotationScalePtr(node->translation, node->rotation, node->scale);
+    return QMul(QMul(QFromXAngle(xAngle), QFromYAngle(yAngle)), rotation);
 }
 
-void AnimationController_RecurseBoneMatrices(AnimationController* ac, ANode* node, Matrix4 parentMatrix)
+// one forward loop over the subtree in SceneBundle::nodeOrder, parents are visited before their children,
+// so the model matrix of the parent is ready. reads mNodePose and writes mBoneMatrices, nothing else is modified
+bool AnimationController_UpdateBoneMatrices(AnimationController* ac)
 {
-    for (int c = 0; c < node->numChildren; c++)
-    {
-        int childIndex = node->children[c];
-        ANode* children = &ac->mPrefab->nodes[childIndex];
+    const ANode* nodes = ac->mPrefab->nodes;
+    const Pose*  pose  = ac->mNodePose;
+    const int* order   = ac->mPrefab->nodeOrder;
+    const int* parents = ac->mPrefab->nodeParents;
+    BitSet128* dirty = &ac->mDirtyNodes;
+    bool rotateSpine = AdditiveRotationEnabled(ac->mSpineNodeIdx, ac->mSpineXAngle, ac->mSpineYAngle);
+    bool rotateNeck  = AdditiveRotationEnabled(ac->mNeckNodeIdx , ac->mNeckXAngle , ac->mNeckYAngle);
+    // turning the rotation off changes the node as well, even if the pose is same
+    bool spineChanged = rotateSpine || ac->mSpineRotated;
+    bool neckChanged  = rotateNeck  || ac->mNeckRotated;
+
+    if (BitSet128_IsZero(*dirty) && !spineChanged && !neckChanged)
+        return false;
+
+    if (spineChanged) BitSet128_Set(dirty, ac->mSpineNodeIdx);
+    if (neckChanged)  BitSet128_Set(dirty, ac->mNeckNodeIdx);
+    ac->mSpineRotated = rotateSpine;
+    ac->mNeckRotated  = rotateNeck;
+
+    int rootIndex = ac->mRootNodeIndex;
+    if (BitSet128_Test(dirty, rootIndex))
+        ac->mBoneMatrices[rootIndex] = PositionRotationScalePtr((const float*)&pose[rootIndex].translation, 
+                                                                (const float*)&pose[rootIndex].rotation, nodes[rootIndex].scale);
 
-        if (children == ac->mSpineNode && Absf(ac->mSpineYAngle) + Absf(ac->mSpineXAngle) > MATH_Epsilon) { RotateNode(children, ac->mSpineXAngle, ac->mSpineYAngle); }
-        if (children == ac->mNeckNode && Absf(ac->mNeckYAngle) + Absf(ac->mSpineXAngle) > MATH_Epsilon) { RotateNode(children, ac->mNeckXAngle, ac->mNeckYAngle); }
+    for (int i = ac->mHierarchyBegin + 1; i < ac->mHierarchyEnd; i++)
+    {
+        int nodeIndex = order[i];
+        // parents are visited first, so a dirty parent marks the whole subtree
+        if (!BitSet128_Test(dirty, nodeIndex) && !BitSet128_Test(dirty, parents[i]))
+            continue;
 
-        ac->mBoneMatrices[childIndex] = Matrix4Multiply(parentMatrix, GetNodeMatrix(children));
+        AX_ALIGN(16) float rotation[4];
+        Quaternion q = pose[nodeIndex].rotation;
+        if (rotateSpine && nodeIndex == ac->mSpineNodeIdx) q = AdditiveRotate(q, ac->mSpineXAngle, ac->mSpineYAngle);
+        if (rotateNeck  && nodeIndex == ac->mNeckNodeIdx)  q = AdditiveRotate(q, ac->mNeckXAngle , ac->mNeckYAngle);
+        VecStore(rotation, q);
 
-        AnimationController_RecurseBoneMatrices(ac, children, ac->mBoneMatrices[childIndex]);
+        BitSet128_Set(dirty, nodeIndex);
+        Matrix4 local = PositionRotationScalePtr((const float*)&pose[nodeIndex].translation, rotation, nodes[nodeIndex].scale);
+        ac->mBoneMatrices[nodeIndex] = Matrix4Multiply(ac->mBoneMatrices[parents[i]], local);
     }
+    *dirty = BitSet128_Zero();
+    return true;
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              Pose Blending                               */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+// estimate and one newton step, faster than the division and precise enough for the normalization
+static inline Vector4x32f InvLength4(Vector4x32f x, Vector4x32f y, Vector4x32f z, Vector4x32f w)
+{
+    Vector4x32f lengthSq = VecFmadd(x, x, VecFmadd(y, y, VecFmadd(z, z, VecMul(w, w))));
+    Vector4x32f r = VecRsqrt(lengthSq);
+    return VecMul(VecMul(r, VecSet1(0.5f)), VecSub(VecSet1(3.0f), VecMul(lengthSq, VecMul(r, r))));
+}
+
+// nlerp of the four nodes starting from i
+static inline void BlendNodes4(PoseSoA* a, const PoseSoA* b, int i, Vector4x32f t)
+{
+    Vector4x32f ax = VecLoadA(a->rx + i), ay = VecLoadA(a->ry + i), az = VecLoadA(a->rz + i), aw = VecLoadA(a->rw + i);
+    Vector4x32f bx = VecLoadA(b->rx + i), by = VecLoadA(b->ry + i), bz = VecLoadA(b->rz + i), bw = VecLoadA(b->rw + i);
+    
+    // shortest path, q and -q are the same rotation
+    Vector4x32f dot = VecFmadd(ax, bx, VecFmadd(ay, by, VecFmadd(az, bz, VecMul(aw, bw))));
+    Vector4x32f negate = VecCmpLt(dot, VecZero());
+    bx = VecSelect(bx, VecNeg(bx), negate);
+    by = VecSelect(by, VecNeg(by), negate);
+    bz = VecSelect(bz, VecNeg(bz), negate);
+    bw = VecSelect(bw, VecNeg(bw), negate);
+
+    Vector4x32f x = VecFmadd(VecSub(bx, ax), t, ax);
+    Vector4x32f y = VecFmadd(VecSub(by, ay), t, ay);
+    Vector4x32f z = VecFmadd(VecSub(bz, az), t, az);
+    Vector4x32f w = VecFmadd(VecSub(bw, aw), t, aw);
+    Vector4x32f invLength = InvLength4(x, y, z, w);
+    VecStoreA(a->rx + i, VecMul(x, invLength));
+    VecStoreA(a->ry + i, VecMul(y, invLength));
+    VecStoreA(a->rz + i, VecMul(z, invLength));
+    VecStoreA(a->rw + i, VecMul(w, invLength));
+
+    Vector4x32f tx = VecLoadA(a->tx + i), ty = VecLoadA(a->ty + i), tz = VecLoadA(a->tz + i);
+    VecStoreA(a->tx + i, VecFmadd(VecSub(VecLoadA(b->tx + i), tx), t, tx));
+    VecStoreA(a->ty + i, VecFmadd(VecSub(VecLoadA(b->ty + i), ty), t, ty));
+    VecStoreA(a->tz + i, VecFmadd(VecSub(VecLoadA(b->tz + i), tz), t, tz));
+}
+
+#if defined(AX_SUPPORT_AVX2)
+// same as the 4 wide versions above. PoseSoA is 16 byte aligned, so the loads and stores are unaligned
+static inline __m256 InvLength8(__m256 x, __m256 y, __m256 z, __m256 w)
+{
+    __m256 lengthSq = _mm256_fmadd_ps(x, x, _mm256_fmadd_ps(y, y, _mm256_fmadd_ps(z, z, _mm256_mul_ps(w, w))));
+    __m256 r = _mm256_rsqrt_ps(lengthSq);
+    return _mm256_mul_ps(_mm256_mul_ps(r, _mm256_set1_ps(0.5f)), _mm256_sub_ps(_mm256_set1_ps(3.0f), _mm256_mul_ps(lengthSq, _mm256_mul_ps(r, r))));
+}
+
+static inline __m256 Lerp8(const float* a, const float* b, __m256 t)
+{
+    __m256 av = _mm256_loadu_ps(a);
+    return _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(b), av), t, av);
+}
+
+static inline void BlendNodes8(PoseSoA* a, const PoseSoA* b, int i, __m256 t)
+{
+    __m256 ax = _mm256_loadu_ps(a->rx + i), ay = _mm256_loadu_ps(a->ry + i), az = _mm256_loadu_ps(a->rz + i), aw = _mm256_loadu_ps(a->rw + i);
+    __m256 bx = _mm256_loadu_ps(b->rx + i), by = _mm256_loadu_ps(b->ry + i), bz = _mm256_loadu_ps(b->rz + i), bw = _mm256_loadu_ps(b->rw + i);
+    
+    // shortest path, sign bit of the dot product flips the sign of b
+    __m256 dot = _mm256_fmadd_ps(ax, bx, _mm256_fmadd_ps(ay, by, _mm256_fmadd_ps(az, bz, _mm256_mul_ps(aw, bw))));
+    __m256 sign = _mm256_and_ps(dot, _mm256_set1_ps(-0.0f));
+    bx = _mm256_xor_ps(bx, sign); by = _mm256_xor_ps(by, sign);
+    bz = _mm256_xor_ps(bz, sign); bw = _mm256_xor_ps(bw, sign);
+
+    __m256 x = _mm256_fmadd_ps(_mm256_sub_ps(bx, ax), t, ax);
+    __m256 y = _mm256_fmadd_ps(_mm256_sub_ps(by, ay), t, ay);
+    __m256 z = _mm256_fmadd_ps(_mm256_sub_ps(bz, az), t, az);
+    __m256 w = _mm256_fmadd_ps(_mm256_sub_ps(bw, aw), t, aw);
+    __m256 invLength = InvLength8(x, y, z, w);
+    _mm256_storeu_ps(a->rx + i, _mm256_mul_ps(x, invLength));
+    _mm256_storeu_ps(a->ry + i, _mm256_mul_ps(y, invLength));
+    _mm256_storeu_ps(a->rz + i, _mm256_mul_ps(z, invLength));
+    _mm256_storeu_ps(a->rw + i, _mm256_mul_ps(w, invLength));
+
+    _mm256_storeu_ps(a->tx + i, Lerp8(a->tx + i, b->tx + i, t));
+    _mm256_storeu_ps(a->ty + i, Lerp8(a->ty + i, b->ty + i, t));
+    _mm256_storeu_ps(a->tz + i, Lerp8(a->tz + i, b->tz + i, t));
+}
+#endif
+
+void PoseSoA_Blend(PoseSoA* a, const PoseSoA* b, float t, int numNodes)
+{
+#if defined(AX_SUPPORT_AVX2)
+    __m256 tv = _mm256_set1_ps(t);
+    for (int i = 0; i < numNodes; i += 8)
+        BlendNodes8(a, b, i, tv);
+#else
+    Vector4x32f tv = VecSet1(t);
+    for (int i = 0; i < numNodes; i += 4)
+        BlendNodes4(a, b, i, tv);
+#endif
+}
+
+void PoseSoA_BlendMasked(PoseSoA* a, const PoseSoA* b, const float* weights, int numNodes)
+{
+#if defined(AX_SUPPORT_AVX2)
+    for (int i = 0; i < numNodes; i += 8)
+        BlendNodes8(a, b, i, _mm256_loadu_ps(weights + i));
+#else
+    for (int i = 0; i < numNodes; i += 4)
+        BlendNodes4(a, b, i, VecLoad(weights + i));
+#endif
+}
+
+static inline bool NodeVecChanged(const float* current, Vector4x32f v)
+{
+    AX_ALIGN(16) float next[4];
+    VecStore(next, v);
+    return current[0] != next[0] || current[1] != next[1] || current[2] != next[2] || current[3] != next[3];
 }
 
-static void MergeAnims(Pose* pose0, Pose* pose1, float animBlend, int numNodes)
+// copies the pose to the controller's node pose, nodes that are different than the pose are marked as dirty.
+// w of the translation is kept, so it doesn't mark the nodes as dirty
+static void InitNodes(Pose* nodePose, BitSet128* dirty, const PoseSoA* pose, int numNodes)
 {
     for (int i = 0; i < numNodes; i++)
     {
-        pose0[i].rotation    = QNLerp(pose0[i].rotation, pose1[i].rotation, animBlend); // slerp+norm?
-        pose0[i].translation = VecLerp(pose0[i].translation, pose1[i].translation, animBlend);
-        // pose0[i].scale    = VecLerp(pose0[i].scale, pose1[i].scale, animBlend);
+        Vector4x32f translation = VecSetR(pose->tx[i], pose->ty[i], pose->tz[i], VecGetW(nodePose[i].translation));
+        Vector4x32f rotation    = VecSetR(pose->rx[i], pose->ry[i], pose->rz[i], pose->rw[i]);
+        if (NodeVecChanged((const float*)&nodePose[i].translation, translation) || 
+            NodeVecChanged((const float*)&nodePose[i].rotation, rotation))
+            BitSet128_Set(dirty, i);
+
+        nodePose[i].translation = translation;
+        nodePose[i].rotation    = rotation;
     }
 }
 
-static void InitNodes(ANode* nodes, Pose* pose, int begin, int numNodes)
+// returns the begin index of the segment that contains the time, last segment if time is after the last key.
+// cursor is the result of the previous call, it is a hint, result is same with or without it.
+static inline int FindKeyIndex(const float* input, int count, float time, uint16_t* cursor)
 {
-    numNodes += begin;
-    for (int i = begin; i < numNodes; i++)
+    int last = MMAX(count - 2, 0);
+    if (cursor != NULL)
+    {
+        int i = *cursor;
+        if (i <= last && input[i] <= time)
+        {
+            // forward playback moves zero or a few keys per frame
+            for (int step = 0; step < 4 && i < last && input[i + 1] <= time; step++)
+                i++;
+            
+            if (i == last || input[i + 1] > time) {
+                *cursor = (uint16_t)i;
+                return i;
+            }
+        }
+    }
+    
+    // seek or reverse playback, branchless binary search: last key that is <= time
+    const float* base = input;
+    int n = count;
+    while (n > 1)
     {
-        VecStore(nodes[i].translation, pose[i].translation);
-        VecStore(nodes[i].rotation, pose[i].rotation);
-        // VecStore(nodes[i].scale, pose[i].scale);
+        int half = n >> 1;
+        base = base[half] <= time ? base + half : base; // cmov
+        n -= half;
     }
+    int i = MMIN((int)(base - input), last);
+    if (cursor != NULL) *cursor = (uint16_t)i;
+    return i;
 }
 
-static void InitPose(Pose* pose, ANode* nodes, int numNodes)
+// samplers write to one of the poses, the other one is null.
+// controllers sample to SoA poses for the blend kernels, crowd and the resampler uses AoS poses
+typedef struct APoseOutput_
 {
-    for (int i = 0; i < numNodes; i++)
-    {
-        pose[i].translation = VecLoad(nodes[i].translation);
-        pose[i].rotation    = VecLoad(nodes[i].rotation);
-        // pose[i].scale    = VecLoad(nodes[i].scale);
+    Pose* pose;
+    PoseSoA* soa;
+} APoseOutput;
+
+static inline void PoseOutput_SetTranslation(APoseOutput out, int node, Vector4x32f translation)
+{
+    if (out.soa == NULL) {
+        out.pose[node].translation = translation;
+        return;
     }
+    AX_ALIGN(16) float t[4];
+    VecStoreA(t, translation);
+    out.soa->tx[node] = t[0]; out.soa->ty[node] = t[1]; out.soa->tz[node] = t[2];
 }
 
-void AnimationController_SampleAnimationPose(AnimationController* ac, Pose* pose, int animIdx, float normTime)
+static inline void PoseOutput_SetRotation(APoseOutput out, int node, Quaternion rotation)
+{
+    if (out.soa == NULL) {
+        out.pose[node].rotation = rotation;
+        return;
+    }
+    AX_ALIGN(16) float r[4];
+    VecStoreA(r, rotation);
+    out.soa->rx[node] = r[0]; out.soa->ry[node] = r[1]; out.soa->rz[node] = r[2]; out.soa->rw[node] = r[3];
+}
+
+// pose has to be initialized, nodes that doesn't have a channel in the animation keeps their transform.
+// cursors are per channel, can be null. negative normTime is mapped to 1 - |normTime| and interpolated forward
+static void SampleAnimationChannels(const AAnimation* animation, APoseOutput out, float normTime, uint16_t* cursors)
 {
-    AAnimation* animation = &ac->mPrefab->animations[animIdx];
     bool reverse = normTime < 0.0f;
     normTime = Absf(normTime);
     if (reverse) normTime = MMAX(1.0f - normTime, 0.0f);
 
-    InitPose(pose, ac->mPrefab->nodes, ac->mPrefab->numNodes);
     float realTime = normTime * animation->duration;
     
     for (int c = 0; c < animation->numChannels; c++)
@@ -182,34 +509,24 @@ void AnimationController_SampleAnimationPose(AnimationController* ac, Pose* pose
         if (channel->targetPath == AAnimTargetPath_Weight)
             continue;
     
-        // maybe binary search
-        int beginIdx = 0, endIdx;
-        while (realTime >= sampler->input[beginIdx + 1])
-            beginIdx++;
-        
-        beginIdx = Minf(beginIdx, sampler->count - 1);
-        endIdx   = beginIdx + 1;
-
-        if (reverse) XSWAP(int, beginIdx, endIdx);
+        int beginIdx = FindKeyIndex(sampler->input, sampler->count, realTime, cursors ? cursors + c : NULL);
+        int endIdx   = MMIN(beginIdx + 1, sampler->count - 1);
 
         Vector4x32f begin = ((Vector4x32f*)sampler->output)[beginIdx];
         Vector4x32f end   = ((Vector4x32f*)sampler->output)[endIdx];
     
-        float beginTime = Minf(0.0001f, realTime - sampler->input[beginIdx]);
+        float beginTime = Maxf(0.0f, realTime - sampler->input[beginIdx]);
         float endTime   = Maxf(0.0001f, sampler->input[endIdx] - sampler->input[beginIdx]);
-        
-        if (reverse) XSWAP(float, beginTime, endTime);
-        
         float t = Clamp01f(beginTime / endTime);
 
         switch (channel->targetPath)
         {
             case AAnimTargetPath_Translation:
-                pose[targetNode].translation = VecLerp(begin, end, t);
+                PoseOutput_SetTranslation(out, targetNode, VecLerp(begin, end, t));
                 break;
             case AAnimTargetPath_Rotation:
                 Quaternion rot = QSlerp(begin, end, t);
-                pose[targetNode].rotation = QNorm(rot); // QNormEst maybe
+                PoseOutput_SetRotation(out, targetNode, QNorm(rot)); // QNormEst maybe
                 break;
         //  case AAnimTargetPath_Scale:
         //      pose[targetNode].scale = VecLerp(begin, end, t);
@@ -218,6 +535,32 @@ void AnimationController_SampleAnimationPose(AnimationController* ac, Pose* pose
     }
 }
 
+static AKeyPairCache* CreateKeyPairCache(int count)
+{
+    AKeyPairCache* keyPairs = AllocAligned(sizeof(AKeyPairCache) * MMAX(count, 1), 16);
+    for (int i = 0; i < count; i++)
+        keyPairs[i].key = -1;
+    return keyPairs;
+}
+
+void AnimationController_SampleAnimationPose(AnimationController* ac, PoseSoA* pose, int animIdx, float normTime)
+{
+    if (ac->mClips != NULL) {
+        ResampledClip_SampleSoA(&ac->mClips[animIdx], pose, normTime);
+        return;
+    }
+    InitPoseSoA(pose, ac->mPrefab->nodes, ac->mPrefab->numNodes);
+    uint16_t* cursors = ac->mKeyCursors + ac->mKeyCursorOffsets[animIdx];
+    if (ac->mCompressedClips != NULL)
+    {
+        if (ac->mKeyPairs == NULL)
+            ac->mKeyPairs = CreateKeyPairCache(ac->mKeyCursorOffsets[ac->mPrefab->numAnimations]);
+        CompressedClip_SampleSoA(&ac->mCompressedClips[animIdx], pose, normTime, cursors, ac->mKeyPairs + ac->mKeyCursorOffsets[animIdx]);
+    }
+    else
+        SampleAnimationChannels(&ac->mPrefab->animations[animIdx], (APoseOutput){ NULL, pose }, normTime, cursors);
+}
+
 // send matrices to GPU
 void AnimationController_UploadBoneMatrices(AnimationController* ac)
 {
@@ -238,36 +581,27 @@ void AnimationController_UploadBoneMatrices(AnimationController* ac)
     rUpdateTexture(ac->mMatrixTex, ac->mOutMatrices);
 }
 
-void AnimationController_UploadPose(AnimationController* ac, Pose* pose)
+void AnimationController_UploadPose(AnimationController* ac, const PoseSoA* pose)
 {
-    InitNodes(ac->mPrefab->nodes, pose, 0, ac->mPrefab->numNodes);
-
-    ANode* rootNode = GetNodePtr(ac->mPrefab, ac->mRootNodeIndex);
-    ac->mBoneMatrices[ac->mRootNodeIndex] = GetNodeMatrix(rootNode);
+    InitNodes(ac->mNodePose, &ac->mDirtyNodes, pose, ac->mPrefab->numNodes);
 
-    AnimationController_RecurseBoneMatrices(ac, rootNode, ac->mBoneMatrices[ac->mRootNodeIndex]);
-    AnimationController_UploadBoneMatrices(ac);
+    // idle or paused characters doesn't change the pose, nothing to update and upload
+    if (AnimationController_UpdateBoneMatrices(ac))
+        AnimationController_UploadBoneMatrices(ac);
 }
 
 // when we want to play different animations with lower body and upper body
-void AnimationController_UploadPoseUpperLower(AnimationController* ac, Pose* lowerPose, Pose* uperPose)
+void AnimationController_UploadPoseUpperLower(AnimationController* ac, PoseSoA* lowerPose, const PoseSoA* uperPose)
 {
-    // apply posess to lower body and upper body seperately, so both of it has diferrent animations
-    InitNodes(ac->mPrefab->nodes, lowerPose, ac->lowerBodyIdxStart, ac->mPrefab->numNodes - ac->lowerBodyIdxStart);
-    InitNodes(ac->mPrefab->nodes, uperPose, 0, ac->lowerBodyIdxStart);
-
-    ANode* rootNode = GetNodePtr(ac->mPrefab, ac->mRootNodeIndex);
-    Matrix4 rootMatrix = GetNodeMatrix(rootNode);
-    ac->mBoneMatrices[ac->mRootNodeIndex] = rootMatrix;
-
-    AnimationController_RecurseBoneMatrices(ac, rootNode, rootMatrix);
-    AnimationController_UploadBoneMatrices(ac);
+    // upper body weights are 1, so both of the body parts has diferrent animations
+    PoseSoA_BlendMasked(lowerPose, uperPose, ac->mUpperBodyWeights, ac->mNumNodes);
+    AnimationController_UploadPose(ac, lowerPose);
 }
 
 void AnimationController_PlayAnim(AnimationController* ac, int index, float norm)
 {
-    AnimationController_SampleAnimationPose(ac, ac->mAnimPoseA, index, norm);
-    AnimationController_UploadPose(ac, ac->mAnimPoseA);
+    AnimationController_SampleAnimationPose(ac, &ac->mAnimPoseA, index, norm);
+    AnimationController_UploadPose(ac, &ac->mAnimPoseA);
 }
 
 bool AnimationController_TriggerAnim(AnimationController* ac, int index, float transitionInTime, float transitionOutTime, eAnimTriggerOpt triggerOpt)
@@ -285,7 +619,7 @@ bool AnimationController_TriggerAnim(AnimationController* ac, int index, float t
     }
 
     ac->mState = AnimState_TriggerIn;
-    SmallMemCpy(ac->mAnimPoseC, ac->mAnimPoseA, sizeof(ac->mAnimPoseA));
+    SmallMemCpy(&ac->mAnimPoseC, &ac->mAnimPoseA, sizeof(PoseSoA));
     if ((triggerOpt & eAnimTriggerOpt_ReverseOut))
         ac->mAnimTime.y = 0.0f;
     return true;
@@ -295,8 +629,8 @@ bool AnimationController_TriggerTransition(AnimationController* ac, float deltaT
 {
     float newNorm   = Clamp01f((ac->mTransitionTime - ac->mCurTransitionTime) / ac->mTransitionTime);
     float animDelta = Clamp01f(deltaTime * (1.0f / MMAX(1.0f - newNorm, MATH_Epsilon)));
-    AnimationController_SampleAnimationPose(ac, ac->mAnimPoseD, targetAnim, ac->mAnimTime.y);
-    MergeAnims(ac->mAnimPoseC, ac->mAnimPoseD, animDelta, ac->mNumNodes);
+    AnimationController_SampleAnimationPose(ac, &ac->mAnimPoseD, targetAnim, ac->mAnimTime.y);
+    PoseSoA_Blend(&ac->mAnimPoseC, &ac->mAnimPoseD, animDelta, ac->mNumNodes);
     ac->mCurTransitionTime -= deltaTime;
     return ac->mCurTransitionTime <= 0.0f;
 }
@@ -321,7 +655,7 @@ void AnimationController_EvaluateLocomotion(AnimationController* ac, float x, fl
         }
         else 
         {
-            AnimationController_SampleAnimationPose(ac, ac->mAnimPoseC, ac->mTriggerredAnim, -ac->mTrigerredNorm);
+            AnimationController_SampleAnimationPose(ac, &ac->mAnimPoseC, ac->mTriggerredAnim, -ac->mTrigerredNorm);
             float animStep = 1.0f / ac->mPrefab->animations[ac->mTriggerredAnim].duration;
             ac->mTrigerredNorm = Clamp01f(ac->mTrigerredNorm + (animSpeed * animStep * deltaTime));
             if (ac->mTrigerredNorm >= 1.0f)
@@ -330,7 +664,7 @@ void AnimationController_EvaluateLocomotion(AnimationController* ac, float x, fl
     }
     else if (ac->mState == AnimState_TriggerPlaying)
     {
-        AnimationController_SampleAnimationPose(ac, ac->mAnimPoseC, ac->mTriggerredAnim, ac->mTrigerredNorm);
+        AnimationController_SampleAnimationPose(ac, &ac->mAnimPoseC, ac->mTriggerredAnim, ac->mTrigerredNorm);
 
         float animStep = 1.0f / ac->mPrefab->animations[ac->mTriggerredAnim].duration;
         ac->mTrigerredNorm = Clamp01f(ac->mTrigerredNorm + (animSpeed * animStep * deltaTime));
@@ -355,15 +689,15 @@ void AnimationController_EvaluateLocomotion(AnimationController* ac, float x, fl
         ASSERTR(yi <= 3, return); // must be between 1 and 4
         yIndex = AnimationController_GetAnim(ac, aMiddle, yi);
 
-        AnimationController_SampleAnimationPose(ac, ac->mAnimPoseA, yIndex, ac->mAnimTime.y);
+        AnimationController_SampleAnimationPose(ac, &ac->mAnimPoseA, yIndex, ac->mAnimTime.y);
         float yBlend = Fractf(y);
 
         bool shouldAnimBlendY = yi != 3 && yBlend > 0.00002f;
         if (shouldAnimBlendY)
         {
             yIndex = AnimationController_GetAnim(ac, aMiddle, yi + 1);
-            AnimationController_SampleAnimationPose(ac, ac->mAnimPoseB, yIndex, ac->mAnimTime.y);
-            MergeAnims(ac->mAnimPoseA, ac->mAnimPoseB, EaseOut(yBlend), ac->mNumNodes);
+            AnimationController_SampleAnimationPose(ac, &ac->mAnimPoseB, yIndex, ac->mAnimTime.y);
+            PoseSoA_Blend(&ac->mAnimPoseA, &ac->mAnimPoseB, EaseOut(yBlend), ac->mNumNodes);
         }
 
         // if anim is two seconds animStep is 0.5 because we are using normalized value
@@ -374,21 +708,691 @@ void AnimationController_EvaluateLocomotion(AnimationController* ac, float x, fl
     ac->mLastAnim = yIndex;
 
     if (!wasTriggerState) {
-        AnimationController_UploadPose(ac, ac->mAnimPoseA);
+        AnimationController_UploadPose(ac, &ac->mAnimPoseA);
     }
     else {
         if (!!(ac->mTriggerOpt & eAnimTriggerOpt_Standing) && y > 0.001f)
-            AnimationController_UploadPoseUpperLower(ac, ac->mAnimPoseA, ac->mAnimPoseC);
+            AnimationController_UploadPoseUpperLower(ac, &ac->mAnimPoseA, &ac->mAnimPoseC);
         else
-            AnimationController_UploadPose(ac, ac->mAnimPoseC);
+            AnimationController_UploadPose(ac, &ac->mAnimPoseC);
     }
 }
 
 void AnimationController_Clear(AnimationController* animSystem)
 {
     rDeleteTexture(animSystem->mMatrixTex);
+    if (animSystem->mKeyCursors) rpfree(animSystem->mKeyCursors);
+    if (animSystem->mKeyCursorOffsets) rpfree(animSystem->mKeyCursorOffsets);
+    if (animSystem->mKeyPairs) FreeAligned(animSystem->mKeyPairs);
+    animSystem->mKeyCursors = NULL;
+    animSystem->mKeyCursorOffsets = NULL;
+    animSystem->mKeyPairs = NULL;
 }
 
 void DestroyAnimationSystem()
 { }
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                                 Crowd                                    */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+bool Crowd_Create(ACrowd* crowd, SceneBundle* prefab, int capacity)
+{
+    MemsetZero(crowd, sizeof(ACrowd));
+    if (prefab->skins == NULL || prefab->numAnimations == 0) {
+        AX_WARN("crowd prefab has to have skin and animations %s", prefab->path); return false;
+    }
+    ASkin* skin = &prefab->skins[0];
+    if (skin->numJoints > MaxBonePoses || prefab->numNodes > MaxBonePoses) {
+        AX_WARN("number of joints is greater than max capacity %s", prefab->path); 
+        return false; 
+    }
+
+    crowd->mPrefab    = prefab;
+    crowd->mCapacity  = capacity;
+    crowd->mNumJoints = skin->numJoints;
+    crowd->mRootNodeIndex = Prefab_FindAnimRootNodeIndex(prefab);
+    Prefab_FindSubtreeRange(prefab, crowd->mRootNodeIndex, &crowd->mHierarchyBegin, &crowd->mHierarchyEnd);
+
+    crowd->mRestPose    = AllocAligned(sizeof(Pose) * prefab->numNodes, 16);
+    crowd->mOutMatrices = rpcalloc(capacity * skin->numJoints, sizeof(Matrix3x4f16));
+    crowd->mAnimIndices = rpmalloc(sizeof(int) * capacity);
+    crowd->mAnimTimes   = rpmalloc(sizeof(float) * capacity);
+    crowd->mAnimSpeeds  = rpmalloc(sizeof(float) * capacity);
+    for (int i = 0; i < prefab->numAnimations; i++)
+        crowd->mMaxChannels = MMAX(crowd->mMaxChannels, prefab->animations[i].numChannels);
+    crowd->mKeyCursors  = rpcalloc(MMAX(capacity * crowd->mMaxChannels, 1), sizeof(uint16_t));
+    InitPose(crowd->mRestPose, prefab->nodes, prefab->numNodes);
+
+    crowd->mMatrixTex = rCreateTexture(skin->numJoints * 3, capacity, NULL, SG_PIXELFORMAT_RGBA16F, TexFlags_StreamUpdate, "CrowdMatrixTex");
+    return true;
+}
+
+void Crowd_Destroy(ACrowd* crowd)
+{
+    if (crowd->mPrefab == NULL)
+        return;
+    rDeleteTexture(crowd->mMatrixTex);
+    FreeAligned(crowd->mRestPose);
+    rpfree(crowd->mOutMatrices);
+    rpfree(crowd->mAnimIndices);
+    rpfree(crowd->mAnimTimes);
+    rpfree(crowd->mAnimSpeeds);
+    rpfree(crowd->mKeyCursors);
+    if (crowd->mKeyPairs) FreeAligned(crowd->mKeyPairs);
+    MemsetZero(crowd, sizeof(ACrowd));
+}
+
+int Crowd_Add(ACrowd* crowd, int animIndex, float normTime, float animSpeed)
+{
+    if (crowd->mNumCharacters >= crowd->mCapacity)
+        return -1;
+
+    int index = crowd->mNumCharacters++;
+    crowd->mAnimIndices[index] = animIndex;
+    crowd->mAnimTimes[index]   = normTime;
+    crowd->mAnimSpeeds[index]  = animSpeed;
+    MemsetZero(crowd->mKeyCursors + index * crowd->mMaxChannels, sizeof(uint16_t) * crowd->mMaxChannels);
+    for (int i = 0; crowd->mKeyPairs != NULL && i < crowd->mMaxChannels; i++)
+        crowd->mKeyPairs[index * crowd->mMaxChannels + i].key = -1;
+    return index;
+}
+
+static void Crowd_UpdateBatch(void* data, int begin, int end)
+{
+    ACrowd* crowd = (ACrowd*)data;
+    SceneBundle* prefab = crowd->mPrefab;
+    const int* order   = prefab->nodeOrder;
+    const int* parents = prefab->nodeParents;
+    ASkin* skin = &prefab->skins[0];
+    Matrix4* invMatrices = (Matrix4*)skin->inverseBindMatrices;
+    // scratch memory of the worker, AnimationController stores these per character
+    Pose pose[MaxBonePoses];
+    Matrix4 boneMatrices[MaxBonePoses];
+
+    for (int c = begin; c < end; c++)
+    {
+        AAnimation* animation = &prefab->animations[crowd->mAnimIndices[c]];
+        float animStep = 1.0f / MMAX(animation->duration, MATH_Epsilon);
+        float normTime = crowd->mAnimTimes[c];
+        crowd->mAnimTimes[c] = Fractf(normTime + crowd->mAnimSpeeds[c] * animStep * crowd->mDeltaTime);
+
+        if (crowd->mClips != NULL)
+        {
+            ResampledClip_Sample(&crowd->mClips[crowd->mAnimIndices[c]], pose, normTime);
+        }
+        else
+        {
+            MemCpy(pose, crowd->mRestPose, sizeof(Pose) * prefab->numNodes, 16);
+            uint16_t* cursors = crowd->mKeyCursors + c * crowd->mMaxChannels;
+            if (crowd->mCompressedClips != NULL)
+                CompressedClip_Sample(&crowd->mCompressedClips[crowd->mAnimIndices[c]], pose, normTime, cursors, crowd->mKeyPairs + c * crowd->mMaxChannels);
+            else
+                SampleAnimationChannels(animation, (APoseOutput){ pose, NULL }, normTime, cursors);
+        }
+
+        // parents are calculated before their children, root is not multiplied with its parent like the AnimationController
+        for (int i = crowd->mHierarchyBegin; i < crowd->mHierarchyEnd; i++)
+        {
+            int nodeIndex = order[i];
+            Matrix4 local = PositionRotationScalePtr((const float*)&pose[nodeIndex].translation, (const float*)&pose[nodeIndex].rotation, prefab->nodes[nodeIndex].scale);
+            boneMatrices[nodeIndex] = i == crowd->mHierarchyBegin ? local : Matrix4Multiply(boneMatrices[parents[i]], local);
+        }
+
+        Matrix3x4f16* outMatrices = crowd->mOutMatrices + c * crowd->mNumJoints;
+        for (int i = 0; i < skin->numJoints; i++)
+        {
+            Matrix4 mat = Matrix4Multiply(boneMatrices[skin->joints[i]], invMatrices[i]);
+            mat = Matrix4Transpose(mat);
+            ConvertFloat8ToHalf8(outMatrices[i].x, &mat.m[0][0]);
+            ConvertFloat4ToHalf4(outMatrices[i].z, &mat.m[2][0]);
+        }
+    }
+}
+
+void Crowd_Update(ACrowd* crowd, float deltaTime)
+{
+    crowd->mDeltaTime = deltaTime;
+    // allocated here because the workers can't allocate it
+    if (crowd->mCompressedClips != NULL && crowd->mKeyPairs == NULL)
+        crowd->mKeyPairs = CreateKeyPairCache(crowd->mCapacity * crowd->mMaxChannels);
+    JobSystem_ParallelFor(crowd->mNumCharacters, 0, Crowd_UpdateBatch, crowd);
+}
+
+void Crowd_Upload(ACrowd* crowd)
+{
+    if (crowd->mNumCharacters > 0)
+        rUpdateTexture(crowd->mMatrixTex, crowd->mOutMatrices);
+}
+    
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                            Resampled Clips                               */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+AResampledClip* Prefab_ResampleAnimations(SceneBundle* prefab, float frameRate)
+{
+    int numNodes = prefab->numNodes;
+    AResampledClip* clips = rpcalloc(MMAX(prefab->numAnimations, 1), sizeof(AResampledClip));
+    Pose* pose = AllocAligned(sizeof(Pose) * numNodes, 16);
+    uint16_t* cursors = NULL;
+    
+    for (int a = 0; a < prefab->numAnimations; a++)
+    {
+        AAnimation* animation = &prefab->animations[a];
+        AResampledClip* clip = &clips[a];
+        clip->numNodes  = numNodes;
+        clip->numFrames = MMAX((int)(animation->duration * frameRate + 0.999f), 1) + 1; // first and last keys are included
+        clip->rotations    = AllocAligned(sizeof(Vector4x32f) * numNodes * clip->numFrames * 2, 16);
+        clip->translations = clip->rotations + numNodes * clip->numFrames;
+        
+        cursors = rprealloc(cursors, sizeof(uint16_t) * MMAX(animation->numChannels, 1));
+        MemsetZero(cursors, sizeof(uint16_t) * MMAX(animation->numChannels, 1));
+
+        for (int f = 0; f < clip->numFrames; f++)
+        {
+            InitPose(pose, prefab->nodes, numNodes);
+            // frames are sampled in order, cursors moves a key at most
+            SampleAnimationChannels(animation, (APoseOutput){ pose, NULL }, (float)f / (float)(clip->numFrames - 1), cursors);
+
+            Vector4x32f* rotations    = clip->rotations    + f * numNodes;
+            Vector4x32f* translations = clip->translations + f * numNodes;
+            for (int n = 0; n < numNodes; n++)
+            {
+                Vector4x32f rotation = pose[n].rotation;
+                // same hemisphere with the previous frame, so sampling can lerp without checking the sign
+                if (f > 0 && VecDotf(rotation, rotations[n - numNodes]) < 0.0f)
+                    rotation = VecNeg(rotation);
+                rotations[n]    = rotation;
+                translations[n] = pose[n].translation;
+            }
+        }
+    }
+    
+    if (cursors) rpfree(cursors);
+    FreeAligned(pose);
+    return clips;
+}
+
+void Prefab_FreeResampledAnimations(AResampledClip* clips, int numClips)
+{
+    for (int i = 0; i < numClips; i++)
+        FreeAligned(clips[i].rotations); // translations are in the same allocation
+    rpfree(clips);
+}
+
+// returns the first frame of the two frames that the time is between, t is the blend factor between them
+static int ResampledClip_FindFrame(const AResampledClip* clip, float normTime, float* t)
+{
+    bool reverse = normTime < 0.0f;
+    normTime = Clamp01f(Absf(normTime));
+    if (reverse) normTime = 1.0f - normTime;
+
+    float frame = normTime * (float)(clip->numFrames - 1);
+    int frame0 = MMIN((int)frame, clip->numFrames - 1);
+    *t = frame - (float)frame0;
+    return frame0;
+}
+
+void ResampledClip_Sample(const AResampledClip* clip, Pose* pose, float normTime)
+{
+    float alpha;
+    int frame0 = ResampledClip_FindFrame(clip, normTime, &alpha);
+    int frame1 = MMIN(frame0 + 1, clip->numFrames - 1);
+    Vector4x32f t = VecSet1(alpha);
+
+    const Vector4x32f* rotations0    = clip->rotations    + frame0 * clip->numNodes;
+    const Vector4x32f* rotations1    = clip->rotations    + frame1 * clip->numNodes;
+    const Vector4x32f* translations0 = clip->translations + frame0 * clip->numNodes;
+    const Vector4x32f* translations1 = clip->translations + frame1 * clip->numNodes;
+
+    for (int i = 0; i < clip->numNodes; i++)
+    {
+        Vector4x32f rotation = VecFmadd(VecSub(rotations1[i], rotations0[i]), t, rotations0[i]);
+        pose[i].rotation    = VecNormEst(rotation);
+        pose[i].translation = VecFmadd(VecSub(translations1[i], translations0[i]), t, translations0[i]);
+    }
+}
+
+// frames are AoS, four nodes of the both frames are transposed, then interpolated like the blend kernels
+static inline Matrix4 LerpTransposed4(const Vector4x32f* a, const Vector4x32f* b, Vector4x32f t)
+{
+    Matrix4 ta = Matrix4Transpose((Matrix4){ .r = { a[0], a[1], a[2], a[3] } });
+    Matrix4 tb = Matrix4Transpose((Matrix4){ .r = { b[0], b[1], b[2], b[3] } });
+    for (int j = 0; j < 4; j++)
+        ta.r[j] = VecFmadd(VecSub(tb.r[j], ta.r[j]), t, ta.r[j]);
+    return ta;
+}
+
+void ResampledClip_SampleSoA(const AResampledClip* clip, PoseSoA* pose, float normTime)
+{
+    float alpha;
+    int frame0 = ResampledClip_FindFrame(clip, normTime, &alpha);
+    int frame1 = MMIN(frame0 + 1, clip->numFrames - 1);
+    Vector4x32f t = VecSet1(alpha);
+
+    const Vector4x32f* rotations0    = clip->rotations    + frame0 * clip->numNodes;
+    const Vector4x32f* rotations1    = clip->rotations    + frame1 * clip->numNodes;
+    const Vector4x32f* translations0 = clip->translations + frame0 * clip->numNodes;
+    const Vector4x32f* translations1 = clip->translations + frame1 * clip->numNodes;
+
+    int i = 0;
+    for (; i + 4 <= clip->numNodes; i += 4)
+    {
+        // rotations are in the same hemisphere with the previous frame, no sign check
+        Matrix4 r = LerpTransposed4(rotations0 + i, rotations1 + i, t);
+        Vector4x32f invLength = InvLength4(r.r[0], r.r[1], r.r[2], r.r[3]);
+        VecStoreA(pose->rx + i, VecMul(r.r[0], invLength));
+        VecStoreA(pose->ry + i, VecMul(r.r[1], invLength));
+        VecStoreA(pose->rz + i, VecMul(r.r[2], invLength));
+        VecStoreA(pose->rw + i, VecMul(r.r[3], invLength));
+
+        Matrix4 tr = LerpTransposed4(translations0 + i, translations1 + i, t);
+        VecStoreA(pose->tx + i, tr.r[0]);
+        VecStoreA(pose->ty + i, tr.r[1]);
+        VecStoreA(pose->tz + i, tr.r[2]);
+    }
+    
+    APoseOutput out = { NULL, pose };
+    for (; i < clip->numNodes; i++)
+    {
+        Vector4x32f rotation = VecFmadd(VecSub(rotations1[i], rotations0[i]), t, rotations0[i]);
+        PoseOutput_SetRotation(out, i, VecNormEst(rotation));
+        PoseOutput_SetTranslation(out, i, VecFmadd(VecSub(translations1[i], translations0[i]), t, translations0[i]));
+    }
+    ClearPoseSoAPadding(pose, clip->numNodes);
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                            Compressed Clips                              */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+static void EncodeSmallestThree(Quaternion q, uint16_t out[3])
+{
+    AX_ALIGN(16) float v[4];
+    VecStore(v, q);
+    int largest = 0;
+    for (int i = 1; i < 4; i++)
+        if (Absf(v[i]) > Absf(v[largest])) largest = i;
+
+    // q and -q are the same rotation, dropped component is always positive
+    float sign = v[largest] < 0.0f ? -1.0f : 1.0f;
+    uint16_t c[3];
+    for (int i = 0, k = 0; i < 4; i++)
+    {
+        if (i == largest) continue;
+        float normalized = (v[i] * sign * MATH_Sqrt2 + 1.0f) * 0.5f; // [-1/sqrt2, 1/sqrt2] -> [0, 1]
+        c[k++] = (uint16_t)MMIN(MMAX((int)(normalized * 32767.0f + 0.5f), 0), 32767);
+    }
+    out[0] = c[0] | (uint16_t)((largest & 1) << 15);
+    out[1] = c[1] | (uint16_t)((largest >> 1) << 15);
+    out[2] = c[2];
+}
+
+static Quaternion DecodeSmallestThree(const uint16_t in[3])
+{
+    int largest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+    float c[3];
+    for (int k = 0; k < 3; k++)
+        c[k] = ((float)(in[k] & 0x7FFF) * (2.0f / 32767.0f) - 1.0f) * (1.0f / MATH_Sqrt2);
+
+    AX_ALIGN(16) float v[4];
+    for (int i = 0, k = 0; i < 4; i++)
+        v[i] = i == largest ? 0.0f : c[k++];
+    v[largest] = Sqrtf(MMAX(1.0f - (c[0] * c[0] + c[1] * c[1] + c[2] * c[2]), 0.0f));
+    return VecLoad(v);
+}
+
+static float KeyError(Vector4x32f a, Vector4x32f b, bool rotation)
+{
+    if (rotation) 
+    {
+        // interpolated quaternions are normalized with the estimate, acos(dot) is not precise for small angles with floats.
+        // distance of the unit quaternions is 2 * sin(angle / 4), approximately half of the angle
+        a = VecMul(a, VecSet1(1.0f / Sqrtf(VecDotf(a, a))));
+        b = VecMul(b, VecSet1(1.0f / Sqrtf(VecDotf(b, b))));
+        if (VecDotf(a, b) < 0.0f) b = VecNeg(b);
+        Vector4x32f diff = VecSub(a, b);
+        return 2.0f * Sqrtf(VecDotf(diff, diff));
+    }
+    Vector4x32f diff = VecSub(a, b);
+    VecSetW(diff, 0.0f);
+    return Sqrtf(VecDotf(diff, diff));
+}
+
+static Vector4x32f InterpolateKey(Vector4x32f a, Vector4x32f b, float t, bool rotation)
+{
+    return rotation ? QNLerp(a, b, t) : VecLerp(a, b, t);
+}
+
+// greedy reduction, a key is removed if the line from the last kept key to the next key passes through the removed keys.
+// writes the indices of the kept keys, first and last keys are always kept, returns the number of kept keys
+static int ReduceKeys(const float* times, const Vector4x32f* values, int count, float tolerance, bool rotation, int* kept)
+{
+    int numKept = 0;
+    kept[numKept++] = 0;
+    int anchor = 0;
+    for (int i = 1; i < count - 1; i++)
+    {
+        float span = MMAX(times[i + 1] - times[anchor], MATH_Epsilon);
+        for (int k = anchor + 1; k <= i; k++)
+        {
+            float t = (times[k] - times[anchor]) / span;
+            if (KeyError(InterpolateKey(values[anchor], values[i + 1], t, rotation), values[k], rotation) > tolerance)
+            {
+                kept[numKept++] = i;
+                anchor = i;
+                break;
+            }
+        }
+    }
+    if (count > 1) kept[numKept++] = count - 1;
+    return numKept;
+}
+
+ACompressedClip* Prefab_CompressAnimations(SceneBundle* prefab, float translationTolerance, float rotationTolerance)
+{
+    ACompressedClip* clips = rpcalloc(MMAX(prefab->numAnimations, 1), sizeof(ACompressedClip));
+    
+    for (int a = 0; a < prefab->numAnimations; a++)
+    {
+        AAnimation* animation = &prefab->animations[a];
+        ACompressedClip* clip = &clips[a];
+        float invDuration = 1.0f / MMAX(animation->duration, MATH_Epsilon);
+
+        // upper bound of the keys, scale and morph channels are not supported by the sampler
+        int maxKeys = 0, maxTrackKeys = 1;
+        for (int c = 0; c < animation->numChannels; c++)
+        {
+            int count = animation->samplers[animation->channels[c].sampler].count;
+            maxKeys += count;
+            maxTrackKeys = MMAX(maxTrackKeys, count);
+        }
+
+        uint64_t tracksSize = sizeof(ACompressedTrack) * MMAX(animation->numChannels, 1);
+        uint64_t timesSize  = (sizeof(uint16_t) * maxKeys + 7) & ~7ull;
+        uint64_t valuesSize = sizeof(uint16_t) * 3 * maxKeys;
+        char* memory = rpmalloc(tracksSize + timesSize + valuesSize);
+        clip->tracks = (ACompressedTrack*)memory;
+        clip->times  = (uint16_t*)(memory + tracksSize);
+        clip->values = (uint16_t(*)[3])(memory + tracksSize + timesSize);
+        int* kept = rpmalloc(sizeof(int) * maxTrackKeys);
+
+        for (int c = 0; c < animation->numChannels; c++)
+        {
+            AAnimChannel* channel = &animation->channels[c];
+            AAnimSampler* sampler = &animation->samplers[channel->sampler];
+            if (channel->targetPath != AAnimTargetPath_Translation && channel->targetPath != AAnimTargetPath_Rotation)
+                continue;
+            
+            bool rotation = channel->targetPath == AAnimTargetPath_Rotation;
+            const Vector4x32f* values = (const Vector4x32f*)sampler->output;
+            int numKept = ReduceKeys(sampler->input, values, sampler->count, rotation ? rotationTolerance : translationTolerance, rotation, kept);
+
+            ACompressedTrack* track = &clip->tracks[clip->numTracks++];
+            track->targetNode = (uint16_t)channel->targetNode;
+            track->targetPath = (uint16_t)channel->targetPath;
+            track->firstKey   = clip->numKeys;
+            track->numKeys    = numKept;
+
+            if (!rotation)
+            {
+                Vector4x32f min = values[0], max = values[0];
+                for (int k = 1; k < sampler->count; k++)
+                    min = VecMin(min, values[k]), max = VecMax(max, values[k]);
+                Vec3Store(track->rangeMin, min);
+                Vec3Store(track->rangeScale, VecMul(VecSub(max, min), VecSet1(1.0f / 65535.0f)));
+            }
+
+            for (int k = 0; k < numKept; k++)
+            {
+                int key = clip->numKeys++;
+                float time = Clamp01f(sampler->input[kept[k]] * invDuration);
+                clip->times[key] = (uint16_t)(time * 65535.0f + 0.5f);
+                if (rotation)
+                {
+                    EncodeSmallestThree(values[kept[k]], clip->values[key]);
+                    continue;
+                }
+                AX_ALIGN(16) float v[4];
+                VecStore(v, values[kept[k]]);
+                for (int i = 0; i < 3; i++)
+                {
+                    float normalized = track->rangeScale[i] > 0.0f ? (v[i] - track->rangeMin[i]) / track->rangeScale[i] : 0.0f;
+                    clip->values[key][i] = (uint16_t)MMIN(MMAX((int)(normalized + 0.5f), 0), 65535);
+                }
+            }
+        }
+        rpfree(kept);
+
+        // memory was allocated for all of the keys, move the kept keys to exact sized memory
+        uint64_t usedTracksSize = sizeof(ACompressedTrack) * MMAX(clip->numTracks, 1);
+        uint64_t usedTimesSize  = (sizeof(uint16_t) * clip->numKeys + 7) & ~7ull;
+        uint64_t usedValuesSize = sizeof(uint16_t) * 3 * clip->numKeys;
+        char* compact = rpmalloc(usedTracksSize + usedTimesSize + usedValuesSize);
+        SmallMemCpy(compact, clip->tracks, sizeof(ACompressedTrack) * clip->numTracks);
+        SmallMemCpy(compact + usedTracksSize, clip->times, sizeof(uint16_t) * clip->numKeys);
+        SmallMemCpy(compact + usedTracksSize + usedTimesSize, clip->values, usedValuesSize);
+        rpfree(memory);
+        clip->tracks = (ACompressedTrack*)compact;
+        clip->times  = (uint16_t*)(compact + usedTracksSize);
+        clip->values = (uint16_t(*)[3])(compact + usedTracksSize + usedTimesSize);
+        clip->sizeInBytes = (int)(usedTracksSize + usedTimesSize + usedValuesSize);
+    }
+    return clips;
+}
+
+void Prefab_FreeCompressedAnimations(ACompressedClip* clips, int numClips)
+{
+    for (int i = 0; i < numClips; i++)
+        rpfree(clips[i].tracks); // times and values are in the same allocation
+    rpfree(clips);
+}
+
+// same as the FindKeyIndex but with the quantized times
+static inline int FindKeyIndex16(const uint16_t* times, int count, uint32_t time, uint16_t* cursor)
+{
+    int last = MMAX(count - 2, 0);
+    if (cursor != NULL)
+    {
+        int i = *cursor;
+        if (i <= last && times[i] <= time)
+        {
+            for (int step = 0; step < 4 && i < last && times[i + 1] <= time; step++)
+                i++;
+            
+            if (i == last || times[i + 1] > time) {
+                *cursor = (uint16_t)i;
+                return i;
+            }
+        }
+    }
+    
+    const uint16_t* base = times;
+    int n = count;
+    while (n > 1)
+    {
+        int half = n >> 1;
+        base = base[half] <= time ? base + half : base; // cmov
+        n -= half;
+    }
+    int i = MMIN((int)(base - times), last);
+    if (cursor != NULL) *cursor = (uint16_t)i;
+    return i;
+}
+
+static inline Vector4x32f DecodeTranslation(const ACompressedTrack* track, const uint16_t in[3])
+{
+    return VecSetR(track->rangeMin[0] + (float)in[0] * track->rangeScale[0],
+                   track->rangeMin[1] + (float)in[1] * track->rangeScale[1],
+                   track->rangeMin[2] + (float)in[2] * track->rangeScale[2], 1.0f);
+}
+
+static void SampleCompressedTracks(const ACompressedClip* clip, APoseOutput out, float normTime, uint16_t* cursors, AKeyPairCache* keyPairs)
+{
+    bool reverse = normTime < 0.0f;
+    normTime = Clamp01f(Absf(normTime));
+    if (reverse) normTime = 1.0f - normTime;
+    float time = normTime * 65535.0f;
     
+    for (int t = 0; t < clip->numTracks; t++)
+    {
+        const ACompressedTrack* track = &clip->tracks[t];
+        const uint16_t* times = clip->times + track->firstKey;
+        const uint16_t (*values)[3] = (const uint16_t(*)[3])clip->values + track->firstKey;
+        
+        int beginIdx = FindKeyIndex16(times, track->numKeys, (uint32_t)time, cursors ? cursors + t : NULL);
+        int endIdx   = MMIN(beginIdx + 1, track->numKeys - 1);
+        float span   = MMAX((float)(times[endIdx] - times[beginIdx]), 1.0f);
+        float alpha  = Clamp01f((time - (float)times[beginIdx]) / span);
+        bool rotation = track->targetPath == AAnimTargetPath_Rotation;
+
+        Vector4x32f begin, end;
+        AKeyPairCache* cache = keyPairs ? keyPairs + t : NULL;
+        if (cache != NULL && cache->key == beginIdx)
+        {
+            begin = cache->begin;
+            end   = cache->end;
+        }
+        else
+        {
+            // moved to the next key, old end key is the new begin key
+            if (cache != NULL && cache->key >= 0 && cache->key + 1 == beginIdx)
+                begin = cache->end;
+            else
+                begin = rotation ? DecodeSmallestThree(values[beginIdx]) : DecodeTranslation(track, values[beginIdx]);
+            end = rotation ? DecodeSmallestThree(values[endIdx]) : DecodeTranslation(track, values[endIdx]);
+            if (cache != NULL)
+            {
+                cache->begin = begin;
+                cache->end   = end;
+                cache->key   = beginIdx;
+            }
+        }
+
+        if (rotation)
+            PoseOutput_SetRotation(out, track->targetNode, QNLerp(begin, end, alpha));
+        else
+            PoseOutput_SetTranslation(out, track->targetNode, VecLerp(begin, end, alpha));
+    }
+}
+
+void CompressedClip_Sample(const ACompressedClip* clip, Pose* pose, float normTime, uint16_t* cursors, AKeyPairCache* keyPairs)
+{
+    SampleCompressedTracks(clip, (APoseOutput){ pose, NULL }, normTime, cursors, keyPairs);
+}
+
+void CompressedClip_SampleSoA(const ACompressedClip* clip, PoseSoA* pose, float normTime, uint16_t* cursors, AKeyPairCache* keyPairs)
+{
+    SampleCompressedTracks(clip, (APoseOutput){ NULL, pose }, normTime, cursors, keyPairs);
+}
+
+#ifdef AX_ANIMATION_SAMPLE_BENCHMARK
+static int NumNodesChanged(const PoseSoA* a, const PoseSoA* b, int numNodes)
+{
+    int numChanged = 0;
+    for (int n = 0; n < numNodes; n++)
+        numChanged += a->tx[n] != b->tx[n] || a->ty[n] != b->ty[n] || a->tz[n] != b->tz[n] ||
+                      a->rx[n] != b->rx[n] || a->ry[n] != b->ry[n] || a->rz[n] != b->rz[n] || a->rw[n] != b->rw[n];
+    return numChanged;
+}
+
+// define AX_ANIMATION_SAMPLE_BENCHMARK and call after the character is loaded, creates its own controller.
+// cursors are reset before each sample for the binary search only timings
+void AnimationSampleBenchmark(SceneBundle* prefab)
+{
+    const int numSamples = 4096;
+    AnimationController* ac = rpcalloc(1, sizeof(AnimationController));
+    AnimationController_Create(prefab, ac, false, 0);
+    PoseSoA* poseCursor = &ac->mAnimPoseA;
+    PoseSoA* poseSearch = &ac->mAnimPoseB;
+    int numCursors = ac->mKeyCursorOffsets[prefab->numAnimations];
+    float* times = rpmalloc(sizeof(float) * numSamples);
+    AResampledClip* clips = Prefab_ResampleAnimations(prefab, 30.0f);
+    ACompressedClip* compressed = Prefab_CompressAnimations(prefab, 0.001f, 0.002f);
+    uint16_t* compressedCursors = rpcalloc(MMAX(numCursors, 1), sizeof(uint16_t)); // tracks are subset of the channels
+    AKeyPairCache* compressedKeys = CreateKeyPairCache(numCursors);
+
+    uint64_t rawSize = 0, compressedSize = 0;
+    for (int a = 0; a < prefab->numAnimations; a++)
+    {
+        for (int j = 0; j < prefab->animations[a].numSamplers; j++)
+            rawSize += (sizeof(float) + sizeof(Vector4x32f)) * prefab->animations[a].samplers[j].count;
+        compressedSize += compressed[a].sizeInBytes;
+    }
+    printf("animation clips raw: %.1f KB, compressed: %.1f KB\n", rawSize / 1024.0, compressedSize / 1024.0);
+
+    // random, sequential and reverse sequential times. reverse playback uses negative normalized times
+    const char* modeNames[3] = { "random", "sequential", "reverse" };
+    for (int mode = 0; mode < 3; mode++)
+    {
+        uint32_t seed = 0x9E3779B9u;
+        for (int i = 0; i < numSamples; i++)
+        {
+            seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+            times[i] = mode == 0 ? (float)(seed >> 8) / (float)(1 << 24) : (float)i / (float)numSamples;
+            if (mode == 2) times[i] = -(float)(i + 1) / (float)numSamples; // -0 would be forward
+        }
+
+        double cursorTime = 1e9, searchTime = 1e9, resampledTime = 1e9, compressedTime = 1e9;
+        int numMismatch = 0;
+        for (int r = 0; r < 5; r++)
+        {
+            double start = TimeSinceStartup();
+            for (int a = 0; a < prefab->numAnimations; a++)
+            for (int i = 0; i < numSamples; i++)
+                AnimationController_SampleAnimationPose(ac, poseCursor, a, times[i]);
+            
+            double mid = TimeSinceStartup();
+            for (int a = 0; a < prefab->numAnimations; a++)
+            for (int i = 0; i < numSamples; i++)
+            {
+                MemsetZero(ac->mKeyCursors, sizeof(uint16_t) * numCursors);
+                AnimationController_SampleAnimationPose(ac, poseSearch, a, times[i]);
+            }
+            double end = TimeSinceStartup();
+            for (int a = 0; a < prefab->numAnimations; a++)
+            for (int i = 0; i < numSamples; i++)
+                ResampledClip_SampleSoA(&clips[a], poseSearch, times[i]);
+
+            double resampledEnd = TimeSinceStartup();
+            for (int a = 0; a < prefab->numAnimations; a++)
+            for (int i = 0; i < numSamples; i++)
+                CompressedClip_SampleSoA(&compressed[a], poseSearch, times[i], compressedCursors + ac->mKeyCursorOffsets[a], compressedKeys + ac->mKeyCursorOffsets[a]);
+
+            double compressedEnd = TimeSinceStartup();
+            compressedTime = MMIN(compressedTime, compressedEnd - resampledEnd);
+            cursorTime = MMIN(cursorTime, mid - start);
+            searchTime = MMIN(searchTime, end - mid);
+            resampledTime = MMIN(resampledTime, resampledEnd - end);
+        }
+
+        // cursors are only hints, poses has to be same with the binary search
+        for (int a = 0; a < prefab->numAnimations; a++)
+        for (int i = 0; i < numSamples; i += 64)
+        {
+            AnimationController_SampleAnimationPose(ac, poseCursor, a, times[i]);
+            MemsetZero(ac->mKeyCursors, sizeof(uint16_t) * numCursors);
+            AnimationController_SampleAnimationPose(ac, poseSearch, a, times[i]);
+            numMismatch += NumNodesChanged(poseCursor, poseSearch, prefab->numNodes);
+
+            // reverse sample has to be same with the forward sample at the mirrored time
+            if (mode != 2) continue;
+            AnimationController_SampleAnimationPose(ac, poseCursor, a, 1.0f + times[i]);
+            numMismatch += NumNodesChanged(poseCursor, poseSearch, prefab->numNodes);
+        }
+
+        int total = numSamples * prefab->numAnimations;
+        printf("animation sample %s times, %d poses, cursor: %.2f M poses/s, binary search: %.2f M poses/s, resampled 30fps: %.2f M poses/s, compressed: %.2f M poses/s, mismatch: %d\n",
+               modeNames[mode], total, total / cursorTime * 1e-6, total / searchTime * 1e-6, total / resampledTime * 1e-6, total / compressedTime * 1e-6, numMismatch);
+    }
+
+    rpfree(times);
+    Prefab_FreeResampledAnimations(clips, prefab->numAnimations);
+    Prefab_FreeCompressedAnimations(compressed, prefab->numAnimations);
+    rpfree(compressedCursors);
+    FreeAligned(compressedKeys);
+    AnimationController_Clear(ac);
+    rpfree(ac);
+}
+#endif // AX_ANIMATION_SAMPLE_BENCHMARK
@@ -4,6 +4,7 @@
 
 #include "Graphics.h"
 #include "Math/Matrix.h"
+#include "Bitset.h"
 
 enum eAnimLocation_
 {
@@ -43,6 +44,50 @@ typedef struct Pose_
     // Vector4x32f scale;
 } Pose;
 
+// animation resampled to a fixed frame rate, transforms of all nodes are stored for each frame,
+// rotations of frame N are contiguous. sampling is a lerp between two rows, keys are not searched.
+// nodes that are not animated by the clip has their rest transform
+typedef struct AResampledClip_
+{
+    Vector4x32f* rotations;    // [numFrames][numNodes], quaternions are in the same hemisphere with the previous frame
+    Vector4x32f* translations; // [numFrames][numNodes]
+    int numFrames;
+    int numNodes;
+} AResampledClip;
+
+// keys of one channel after the keyframe reduction, values are in ACompressedClip::values.
+// rotations are smallest three: largest component is dropped, other three are 15 bits,
+// index of the dropped component is in the high bits of the first two values.
+// translations are quantized to 16 bits in the range of the track
+typedef struct ACompressedTrack_
+{
+    uint16_t targetNode;
+    uint16_t targetPath; // AAnimTargetPath_Translation or AAnimTargetPath_Rotation
+    int firstKey;
+    int numKeys;
+    float rangeMin[3];   // translation only
+    float rangeScale[3]; // (max - min) / 65535
+} ACompressedTrack;
+
+typedef struct ACompressedClip_
+{
+    ACompressedTrack* tracks;
+    uint16_t* times;       // normalized time of the keys [0, 65535]
+    uint16_t (*values)[3]; // 48 bit per key
+    int numTracks;
+    int numKeys;
+    int sizeInBytes;       // tracks, times and values are in one allocation
+} ACompressedClip;
+
+// decoded keys around the cursor of a compressed track, one per track like the cursors.
+// keys are decoded again only when the cursor moves, forward playback decodes one key each time it moves to the next key
+typedef struct AKeyPairCache_
+{
+    Vector4x32f begin;
+    Vector4x32f end;
+    int key; // index of the begin key, -1 until the first sample
+} AKeyPairCache;
+
 typedef struct Matrix3x4f16_
 {
     half x[4];
@@ -51,9 +96,38 @@ typedef struct Matrix3x4f16_
 } Matrix3x4f16;
 
 
+// local transforms of the nodes in SceneBundle::nodeOrder order, structure of arrays
+// so the world matrices are calculated in one linear loop, see UpdateWorldMatrices
+typedef struct ANodeTransforms_
+{
+    Vector4x32f* translations;
+    Vector4x32f* rotations;
+    Vector4x32f* scales;
+    Bitset dirty; // indexed with node index, set when the local transform changes. world matrices of the dirty nodes and their children are recalculated
+    int numNodes;
+} ANodeTransforms;
+
 // make 192 or 256 if we use more joints
 #define MaxBonePoses  128
 
+// blend kernels process 4 nodes per instruction, 8 with AVX2. nodes after numNodes are processed up to the multiple of this,
+// samplers keep them as identity. MaxBonePoses has to be multiple of it
+#define PoseSoAPadding 8
+
+// structure of arrays pose, same components of the nodes are contiguous so the blend kernels process 4 or 8 nodes per instruction.
+// translation w and the scale are not stored, they are read from the nodes
+typedef struct PoseSoA_
+{
+    AX_ALIGN(16) float tx[MaxBonePoses];
+    float ty[MaxBonePoses];
+    float tz[MaxBonePoses];
+    float rx[MaxBonePoses];
+    float ry[MaxBonePoses];
+    float rz[MaxBonePoses];
+    float rw[MaxBonePoses];
+} PoseSoA;
+STATIC_ASSERT(MaxBonePoses % PoseSoAPadding == 0, "kernels would process the nodes after the MaxBonePoses");
+
 typedef struct AnimationController_
 {
     Texture mMatrixTex;
@@ -62,6 +136,25 @@ typedef struct AnimationController_
 
     int mRootNodeIndex;
     int mNumNodes;
+    // bones are the subtree of the root node, range in SceneBundle::nodeOrder
+    int mHierarchyBegin;
+    int mHierarchyEnd;
+    // nodes whose local transform changed after the last bone matrix update, indexed with node index
+    BitSet128 mDirtyNodes;
+    // local transforms that the bone matrices are calculated from, indexed with node index.
+    // prefab nodes are only read (rest pose and scale), so many controllers can share one prefab
+    Pose mNodePose[MaxBonePoses];
+
+    // last sampled key of each channel of each animation, channels of animation i starts from mKeyCursorOffsets[i]
+    // forward playback moves the cursors a few keys per frame instead of searching from the first key
+    uint16_t* mKeyCursors;
+    int* mKeyCursorOffsets;
+    // optional, one clip per animation, see Prefab_ResampleAnimations. sampling uses them instead of the keys when set
+    const AResampledClip* mClips;
+    // optional, one clip per animation, see Prefab_CompressAnimations. used when mClips is null
+    const ACompressedClip* mCompressedClips;
+    // same layout as the mKeyCursors, allocated when the compressed clips are sampled the first time
+    AKeyPairCache* mKeyPairs;
 
     Vec2f mAnimTime;
 
@@ -73,10 +166,7 @@ typedef struct AnimationController_
     int mLastAnim;
     eAnimTriggerOpt mTriggerOpt;
 
-    ANode* mSpineNode; // < upper body root bone 
-    ANode* mNeckNode;
-
-    int mSpineNodeIdx;
+    int mSpineNodeIdx; // < upper body root bone, -1 if not humanoid
     int mNeckNodeIdx;
 
     // lower body bones are starting from 60th with Brute character and 58 with mixamo Paladin Character
@@ -93,13 +183,19 @@ typedef struct AnimationController_
     float mNeckYAngle;
     float mSpineXAngle; // < will rotate around this axis (normalized) default vec3::up
     float mNeckXAngle;  // < will rotate around this axis (normalized) default vec3::up
+    // additive rotation is in the last bone matrices, node is recalculated once more when the angles return to zero
+    bool mSpineRotated;
+    bool mNeckRotated;
 
-    // two posses for blending
-    Pose mAnimPoseA[MaxBonePoses]; // < the result bone array that we send to GPU
-    Pose mAnimPoseB[MaxBonePoses]; // < blend target
+    // two posses for blending, sampled and blended in SoA form, converted once when they are uploaded
+    PoseSoA mAnimPoseA; // < the result pose that we send to GPU
+    PoseSoA mAnimPoseB; // < blend target
     
-    Pose mAnimPoseC[MaxBonePoses]; // < Trigerred animations result
-    Pose mAnimPoseD[MaxBonePoses]; // < Trigerred Animations blend target
+    PoseSoA mAnimPoseC; // < Trigerred animations result
+    PoseSoA mAnimPoseD; // < Trigerred Animations blend target
+
+    // 1 for the upper body nodes (before lowerBodyIdxStart), mask of the upper and lower body blend
+    float mUpperBodyWeights[MaxBonePoses];
 
     Matrix4 mBoneMatrices[MaxBonePoses];
     Matrix3x4f16 mOutMatrices[MaxBonePoses];
@@ -115,6 +211,36 @@ typedef struct AnimationController_
     int mLocomotionIndicesInv[3][3];    
 } AnimationController;
 
+// many characters of the same prefab, animation clips of the prefab are shared and never modified.
+// state of the characters is stored in arrays, characters are updated in batches with the JobSystem.
+// bone matrices of all characters are written to one texture, one row per character, and uploaded with one rUpdateTexture.
+// like the AnimationController, prefab nodes are not modified, rest pose is copied at creation
+typedef struct ACrowd_
+{
+    Texture mMatrixTex; // width: numJoints * 3, height: capacity, use character index as the animation row of the instance
+    SceneBundle* mPrefab;
+    Matrix3x4f16* mOutMatrices; // numJoints * capacity
+    Pose* mRestPose;            // numNodes
+    uint16_t* mKeyCursors;      // maxChannels * capacity, each character plays one animation
+    const AResampledClip* mClips; // optional, same as the AnimationController::mClips
+    const ACompressedClip* mCompressedClips; // optional, used when mClips is null
+    AKeyPairCache* mKeyPairs;   // same layout as the mKeyCursors, allocated at the first update with the compressed clips
+    int mMaxChannels;
+
+    int* mAnimIndices;
+    float* mAnimTimes;  // normalized time of the animations
+    float* mAnimSpeeds;
+
+    int mNumCharacters;
+    int mCapacity;
+    int mNumJoints;
+    int mRootNodeIndex;
+    // bones are the subtree of the root node, range in SceneBundle::nodeOrder
+    int mHierarchyBegin;
+    int mHierarchyEnd;
+    float mDeltaTime; // of the last update, read by the worker threads
+} ACrowd;
+
 static inline void AnimationController_SetAnim(AnimationController* ac, int x, int y, int index)
 {
     if (y >= 0) ac->mLocomotionIndices[y][x] = index;
@@ -150,21 +276,90 @@ bool AnimationController_TriggerAnim(AnimationController* ac, int animIndex, flo
 
 // after this line all of the functions are private but feel free to use
 // upload to gpu. internal usage only for now
-void AnimationController_UploadPose(AnimationController* ac, Pose* nodeMatrices);
+void AnimationController_UploadPose(AnimationController* ac, const PoseSoA* pose);
     
-void AnimationController_RecurseBoneMatrices(AnimationController* ac, ANode* node, Matrix4 parentMatrix);
+// calculates world matrices of the bones in the order of SceneBundle::nodeOrder, parents are calculated before their children
+// only the dirty nodes and their children are updated, returns false if nothing has changed
+bool AnimationController_UpdateBoneMatrices(AnimationController* ac);
 
 void AnimationController_UploadBoneMatrices(AnimationController* ac);
     
-// when we want to play different animations with lower body and upper body
-void AnimationController_UploadPoseUpperLower(AnimationController* ac, Pose* lowerPose, Pose* uperPose);
+// when we want to play different animations with lower body and upper body.
+// upper body of the lowerPose is replaced with the uperPose, then the lowerPose is uploaded
+void AnimationController_UploadPoseUpperLower(AnimationController* ac, PoseSoA* lowerPose, const PoseSoA* uperPose);
 
 // use negative normTime to sample animation reversely
-void AnimationController_SampleAnimationPose(AnimationController* ac, Pose* pose, int animIdx, float normTime);
+void AnimationController_SampleAnimationPose(AnimationController* ac, PoseSoA* pose, int animIdx, float normTime);
+
+#ifdef AX_ANIMATION_SAMPLE_BENCHMARK
+// samples all of the clips of the prefab at random and sequential times, with and without key cursors and resampled
+void AnimationSampleBenchmark(SceneBundle* prefab);
+#endif
+
+// a = nlerp(a, b, t), rotations of b are negated if they are not in the same hemisphere with a (shortest path)
+void PoseSoA_Blend(PoseSoA* a, const PoseSoA* b, float t, int numNodes);
+
+// same as PoseSoA_Blend but t is per node, 0 keeps a and 1 takes b. weights has to be padded to multiple of PoseSoAPadding nodes
+void PoseSoA_BlendMasked(PoseSoA* a, const PoseSoA* b, const float* weights, int numNodes);
 
 // bool humanoid = true, int lowerBodyStart = 58
 void AnimationController_Create(SceneBundle* prefab, AnimationController* animController, bool humanoid, int lowerBodyStart);
 
 void AnimationController_Clear(AnimationController* ac);
 
+// capacity is the maximum number of characters, returns false if the prefab doesn't have a skin
+bool Crowd_Create(ACrowd* crowd, SceneBundle* prefab, int capacity);
+
+void Crowd_Destroy(ACrowd* crowd);
+
+// returns the index of the character which is also the row of the character in the matrix texture, -1 if the crowd is full
+int Crowd_Add(ACrowd* crowd, int animIndex, float normTime, float animSpeed);
+
+// advances the animations, samples the poses and writes the bone matrices of all characters in parallel
+void Crowd_Update(ACrowd* crowd, float deltaTime);
+
+// single texture update for all of the characters
+void Crowd_Upload(ACrowd* crowd);
+
+// resamples all of the animations of the prefab, returns numAnimations clips.
+// frames are evenly spaced over the duration of the animation, at least frameRate frames per second.
+// rest pose is read from the prefab nodes, controllers never write to them, so clips can be created any time after loading
+AResampledClip* Prefab_ResampleAnimations(SceneBundle* prefab, float frameRate);
+
+void Prefab_FreeResampledAnimations(AResampledClip* clips, int numClips);
+
+// writes the transforms of all nodes, negative normTime samples the clip reversely same as SampleAnimationPose
+void ResampledClip_Sample(const AResampledClip* clip, Pose* pose, float normTime);
+
+// same as ResampledClip_Sample, 4 nodes are interpolated at once. nodes after numNodes are set to identity
+void ResampledClip_SampleSoA(const AResampledClip* clip, PoseSoA* pose, float normTime);
+
+// keys that can be interpolated from their neighbors within the tolerances are removed, then the keys are quantized.
+// translation tolerance is in units of the nodes, rotation tolerance is in radians. returns numAnimations clips
+ACompressedClip* Prefab_CompressAnimations(SceneBundle* prefab, float translationTolerance, float rotationTolerance);
+
+void Prefab_FreeCompressedAnimations(ACompressedClip* clips, int numClips);
+
+// pose has to be initialized, nodes that are not animated keeps their transform. 
+// cursors and keyPairs are per track and can be null, same as the AnimationController::mKeyCursors
+void CompressedClip_Sample(const ACompressedClip* clip, Pose* pose, float normTime, uint16_t* cursors, AKeyPairCache* keyPairs);
+
+void CompressedClip_SampleSoA(const ACompressedClip* clip, PoseSoA* pose, float normTime, uint16_t* cursors, AKeyPairCache* keyPairs);
+
+// subtree of the node is the [begin, end) range in prefab->nodeOrder
+void Prefab_FindSubtreeRange(SceneBundle* prefab, int nodeIndex, int* begin, int* end);
+
+// allocates the arrays and copies the local transforms of the nodes
+void NodeTransforms_Create(ANodeTransforms* transforms, SceneBundle* prefab);
+
+void NodeTransforms_Destroy(ANodeTransforms* transforms);
+
+// index is the position in the prefab->nodeOrder, marks the node dirty
+void NodeTransforms_Set(ANodeTransforms* transforms, SceneBundle* prefab, int index, Vector4x32f translation, Vector4x32f rotation, Vector4x32f scale);
+
+// worldMatrices are indexed with node index. dirty nodes in the [begin, end) range of the nodeOrder and their children are updated,
+// first node of the range and the roots are multiplied with the parentMatrix, mark the first node dirty if parentMatrix changes.
+// dirty bits of the range are cleared, returns the number of updated nodes
+int UpdateWorldMatrices(Matrix4* worldMatrices, ANodeTransforms* locals, SceneBundle* prefab, int begin, int end, Matrix4 parentMatrix);
+
 #endif _ANIMATION_H
\ No newline at end of file
@@ -19,6 +19,10 @@
 #include "Math/Matrix.h"
 #include "Math/Color.h"
 #include "IO.h"
+#include "JobSystem.h"
+#include "Meshlet.h"
+#include "MeshOptimize.h"
+#include "MeshLod.h"
 #include "Common.h"
 
 
@@ -117,6 +121,7 @@ int LoadFBX(const char* path, SceneBundle* fbxScene, float scale)
     
     fbxScene->allVertices = AllocAligned(sizeof(ASkinedVertex) * totalVertices, 4);
     fbxScene->allIndices  = AllocAligned(sizeof(uint32_t) * totalIndices, 4);
+    fbxScene->allIndicesSize = sizeof(uint32_t) * totalIndices;
     
     if (fbxScene->numMeshes) fbxScene->meshes = rpcalloc(fbxScene->numMeshes, sizeof(AMesh));
     
@@ -134,6 +139,7 @@ int LoadFBX(const char* path, SceneBundle* fbxScene, float scale)
         amesh->numPrimitives = 1;
         
         APrimitive* primitive = &amesh->primitives[0];
+        MemsetZero(primitive, sizeof(APrimitive));
         primitive->numIndices  = (int)umesh->num_triangles * 3;
         primitive->numVertices = (int)umesh->num_vertices;
         primitive->indexType   = 5; //GraphicType_UnsignedInt;
@@ -413,8 +419,15 @@ int LoadFBX(const char* path, SceneBundle* fbxScene, float scale)
     
     fbxScene->numImages = dynarray_length(images);
     fbxScene->images    = images;
+    fbxScene->nodeOrder   = FixedPow2Allocator_AllocateUninitialized(allocator, sizeof(int) * (numNodes + 1));
+    fbxScene->nodeParents = FixedPow2Allocator_AllocateUninitialized(allocator, sizeof(int) * (numNodes + 1));
     fbxScene->allocator = allocator;
     ufbx_free_scene(uscene);
+    if (!BuildNodeHierarchy(fbxScene->nodes, numNodes, fbxScene->nodeOrder, fbxScene->nodeParents))
+    {
+        AX_ERROR("fbx node hierarchy is malformed %s", path);
+        return 0;
+    }
 #endif // android
     return 1;
 }
@@ -424,191 +437,263 @@ int LoadFBX(const char* path, SceneBundle* fbxScene, float scale)
 /*                            Vertex Load                                   */
 /*//////////////////////////////////////////////////////////////////////////*/
 
+// destination range of each primitive is known after prefix sums of vertex and index counts,
+// so primitives are converted independently in parallel
+typedef struct APackPrimitive_
+{
+    APrimitive* primitive;
+    uint32_t vertexOffset; // sum of numVertices of the previous primitives
+    uint32_t indexOffset;  // sum of numIndices of the previous primitives
+} APackPrimitive;
 
-void CreateVerticesIndices(SceneBundle* gltf)
+typedef struct APackContext_
 {
-    AMesh* meshes = gltf->meshes;
-    
-    // pre allocate all vertices and indices 
-    gltf->allVertices = AllocAligned(sizeof(AVertex) * gltf->totalVertices, 4);
-    gltf->allIndices  = AllocAligned(gltf->totalIndices * sizeof(uint32_t) + 16, 4); // 16->give little bit of space for memcpy
-    
-    AVertex* currVertex = (AVertex*)gltf->allVertices;
-    uint32_t* currIndex = (uint32_t*)gltf->allIndices;
-    
+    APackPrimitive* primitives;
+    char*           vertices;
+    uint32_t*       indices;
+    int             vertexSize; // sizeof(AVertex) or sizeof(ASkinedVertex)
+} APackContext;
+
+static APackPrimitive* GatherPackPrimitives(SceneBundle* gltf, int* outNumPrimitives)
+{
+    int numPrimitives = 0;
+    for (int m = 0; m < gltf->numMeshes; ++m)
+        numPrimitives += gltf->meshes[m].numPrimitives;
+
+    APackPrimitive* primitives = rpmalloc(sizeof(APackPrimitive) * MMAX(numPrimitives, 1));
     uint32_t vertexCursor = 0, indexCursor = 0;
     int count = 0;
 
     for (int m = 0; m < gltf->numMeshes; ++m)
     {
-        // get number of vertex, getting first attribute count because all of the others are same
-        AMesh mesh = meshes[m];
-        for (uint64_t p = 0; p < mesh.numPrimitives; p++)
+        AMesh mesh = gltf->meshes[m];
+        for (int p = 0; p < mesh.numPrimitives; p++)
         {
             APrimitive* primitive = &mesh.primitives[p];
-            char* beforeCopy = (char*)primitive->indices;
-            primitive->indices = currIndex;
-            primitive->indexOffset = indexCursor;
-            primitive->vertices = currVertex;
-            
-            // https://www.yosoygames.com.ar/wp/2018/03/vertex-formats-part-1-compression/
-            Vec3f* positions = (Vec3f*)primitive->vertexAttribs[0];
-            Vec2f* texCoords = (Vec2f*)primitive->vertexAttribs[1];
-            Vec3f* normals   = (Vec3f*)primitive->vertexAttribs[2];
-            Vector4x32f* tangents     = (Vector4x32f*)primitive->vertexAttribs[3];
-            
-            for (int v = 0; v < primitive->numVertices; v++)
-            {
-                Vector4x32f    tangent  = tangents  ? tangents[v]  : VecZero();
-                Vec2f texCoord = texCoords ? texCoords[v] : (Vec2f){0.0f, 0.0f};
-                Vec3f normal   = normals   ? normals[v]   : (Vec3f){0.5f, 0.5f, 0.0};
-
-                currVertex[v].position  = positions[v];
-                currVertex[v].texCoord  = ConvertFloat2ToHalf2(&texCoord.x);
-                currVertex[v].normal    = Pack_INT_2_10_10_10_REV(normal);
-                currVertex[v].tangent   = Pack_INT_2_10_10_10_REV_VEC(tangent);
-            }
+            primitives[count].primitive    = primitive;
+            primitives[count].vertexOffset = vertexCursor;
+            primitives[count].indexOffset  = indexCursor;
+            vertexCursor += primitive->numVertices;
+            indexCursor  += primitive->numIndices;
+            count++;
+        }
+    }
+    *outNumPrimitives = count;
+    return primitives;
+}
 
-            int indexSize = GraphicsTypeToSize(primitive->indexType);
-            
-            for (int i = 0; i < primitive->numIndices; i++)
-            {
-                uint32_t index = 0;
-                // index type might be ushort we are converting it to uint32 here.
-                SmallMemCpy(&index, beforeCopy, indexSize);
-                // we are combining all vertices and indices into one buffer, that's why we have to add vertex cursor
-                currIndex[i] = index + vertexCursor;
-                beforeCopy += indexSize;
-            }
+static void PackPrimitiveIndices(APrimitive* primitive, uint32_t* dst, uint32_t vertexOffset)
+{
+    char* beforeCopy = (char*)primitive->indices;
+    int indexSize = GraphicsTypeToSize(primitive->indexType);
 
-            currVertex += primitive->numVertices;
+    for (int i = 0; i < primitive->numIndices; i++)
+    {
+        uint32_t index = 0;
+        // index type might be ushort we are converting it to uint32 here.
+        SmallMemCpy(&index, beforeCopy, indexSize);
+        // we are combining all vertices and indices into one buffer, that's why we have to add vertex offset
+        dst[i] = index + vertexOffset;
+        beforeCopy += indexSize;
+    }
+    primitive->indices = dst;
+    primitive->indexType = GraphicType_UnsignedInt; // converted to uint32 above
+}
 
-            primitive->indexOffset = indexCursor;
-            indexCursor += primitive->numIndices;
+#define AX_PACK_CHUNK 256
 
-            vertexCursor += primitive->numVertices;
-            currIndex += primitive->numIndices;
+// writes the fields that AVertex and ASkinedVertex shares, dst vertices are vertexSize bytes apart.
+// attributes are packed to small streams with batch packers, then interleaved
+static void PackPrimitiveVertices(APrimitive* primitive, char* dst, int vertexSize)
+{
+    // https://www.yosoygames.com.ar/wp/2018/03/vertex-formats-part-1-compression/
+    Vec3f* positions = (Vec3f*)primitive->vertexAttribs[0];
+    Vec2f* texCoords = (Vec2f*)primitive->vertexAttribs[1];
+    Vec3f* normals   = (Vec3f*)primitive->vertexAttribs[2];
+    float* tangents  = (float*)primitive->vertexAttribs[3]; // not 16 byte aligned inside of the gltf buffer
+
+    const Vec3f defaultNormal = { 0.5f, 0.5f, 0.0f };
+    uint32_t packedNormals[AX_PACK_CHUNK], packedTangents[AX_PACK_CHUNK], packedTexCoords[AX_PACK_CHUNK];
+    
+    for (int begin = 0; begin < primitive->numVertices; begin += AX_PACK_CHUNK)
+    {
+        int count = MMIN(primitive->numVertices - begin, AX_PACK_CHUNK);
+        
+        if (normals)   Pack_INT_2_10_10_10_REV_N(packedNormals, normals + begin, count);
+        if (tangents)  Pack_INT_2_10_10_10_REV_VEC_N(packedTangents, tangents + (begin * 4), count);
+        if (texCoords) ConvertFloat2ToHalf2N(packedTexCoords, texCoords + begin, count);
+
+        for (int v = 0; v < count; v++)
+        {
+            AVertex* vertex = (AVertex*)(dst + (size_t)(begin + v) * vertexSize);
+            vertex->position = positions[begin + v];
+            vertex->normal   = normals   ? packedNormals[v]   : Pack_INT_2_10_10_10_REV(defaultNormal);
+            vertex->tangent  = tangents  ? packedTangents[v]  : 0u;
+            vertex->texCoord = texCoords ? packedTexCoords[v] : 0u;
         }
     }
-    
-    FreeGLTFBuffers(gltf);
+    primitive->vertices = dst;
 }
 
-void CreateVerticesIndicesSkined(SceneBundle* gltf)
+#ifdef AX_VERTEX_PACK_BENCHMARK
+// compares per vertex packers with the batch packers that cook path uses, prints vertices per second.
+// define AX_VERTEX_PACK_BENCHMARK and call after platform is initialized
+void VertexPackBenchmark(void)
 {
-    AMesh* meshes = gltf->meshes;
-    
-    // pre allocate all vertices and indices 
-    gltf->allVertices = AllocAligned(sizeof(ASkinedVertex) * gltf->totalVertices, 4);
-    gltf->allIndices  = AllocAligned(gltf->totalIndices * sizeof(uint32_t) + 16, 4); // 16->give little bit of space for memcpy
-    
-    ASkinedVertex* currVertex = (ASkinedVertex*)gltf->allVertices;
-    uint32_t* currIndices = (uint32_t*)gltf->allIndices;
-    
-    int vertexCursor = 0;
-    int indexCursor = 0;
+    const int numVertices = 1 << 20;
+    Vec3f* normals    = rpmalloc(sizeof(Vec3f) * numVertices);
+    float* tangents   = rpmalloc(sizeof(float) * 4 * numVertices);
+    Vec2f* texCoords  = rpmalloc(sizeof(Vec2f) * numVertices);
+    uint32_t* scalar  = rpmalloc(sizeof(uint32_t) * 3 * numVertices);
+    uint32_t* batched = rpmalloc(sizeof(uint32_t) * 3 * numVertices);
+
+    uint32_t seed = 0x9E3779B9u;
+    float* floats[3] = { &normals->x, tangents, &texCoords->x };
+    int counts[3] = { numVertices * 3, numVertices * 4, numVertices * 2 };
+    for (int a = 0; a < 3; a++)
+    for (int i = 0; i < counts[a]; i++)
+    {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        floats[a][i] = (float)(seed >> 8) / (float)(1 << 23) - 1.0f; // [-1, 1]
+    }
+
+    double scalarTime = 1e9, batchTime = 1e9;
+    for (int r = 0; r < 5; r++)
+    {
+        double start = TimeSinceStartup();
+        for (int i = 0; i < numVertices; i++)
+        {
+            scalar[i * 3 + 0] = Pack_INT_2_10_10_10_REV(normals[i]);
+            scalar[i * 3 + 1] = Pack_INT_2_10_10_10_REV_VEC(VecLoad(tangents + i * 4));
+            scalar[i * 3 + 2] = ConvertFloat2ToHalf2(&texCoords[i].x);
+        }
+        double mid = TimeSinceStartup();
+        Pack_INT_2_10_10_10_REV_N(batched, normals, numVertices);
+        Pack_INT_2_10_10_10_REV_VEC_N(batched + numVertices, tangents, numVertices);
+        ConvertFloat2ToHalf2N(batched + numVertices * 2, texCoords, numVertices);
+        double end = TimeSinceStartup();
+        scalarTime = MMIN(scalarTime, mid - start);
+        batchTime  = MMIN(batchTime, end - mid);
+    }
+
+    int numMismatch = 0;
+    for (int i = 0; i < numVertices; i++)
+    {
+        numMismatch += scalar[i * 3 + 0] != batched[i];
+        numMismatch += scalar[i * 3 + 1] != batched[i + numVertices];
+        numMismatch += scalar[i * 3 + 2] != batched[i + numVertices * 2];
+    }
+    printf("vertex pack %d vertices, scalar: %.1f M vertices/s, batch: %.1f M vertices/s, mismatch: %d\n",
+           numVertices, numVertices / scalarTime * 1e-6, numVertices / batchTime * 1e-6, numMismatch);
+
+    rpfree(normals); rpfree(tangents); rpfree(texCoords);
+    rpfree(scalar);  rpfree(batched);
+}
+#endif // AX_VERTEX_PACK_BENCHMARK
+
+// convert whatever joint format to rgb8u
+static void PackPrimitiveJoints(APrimitive* primitive, ASkinedVertex* currVertex)
+{
+    char* joints  = (char*)primitive->vertexAttribs[5];
+    char* weights = (char*)primitive->vertexAttribs[6];
+
+    // size and offset in bytes
+    int jointSize = GraphicsTypeToSize(primitive->jointType);
+    int jointOffset = Max32((int)(primitive->jointStride - (jointSize * primitive->jointCount)), 0); // stride - sizeof(rgbau16)
+    // size and offset in bytes
+    int weightSize   = GraphicsTypeToSize(primitive->weightType);
+    int weightOffset = Max32((int)(primitive->weightStride - (weightSize * primitive->jointCount)), 0);
     
-    for (int m = 0; m < gltf->numMeshes; ++m)
+    for (int j = 0; j < primitive->numVertices; j++)
     {
-        // get number of vertex, getting first attribute count because all of the others are same
-        AMesh mesh = meshes[m];
-        for (uint64_t p = 0; p < mesh.numPrimitives; p++)
+        // Combine 4 indices into one integer to save space
+        uint32_t packedJoints = 0u;
+        // iterate over joint indices, most of the time 4 indices
+        for (int k = 0, shift = 0; k < primitive->jointCount; k++)
         {
-            APrimitive* primitive = &mesh.primitives[p];
-            char* beforeCopy = (char*)primitive->indices;
-            primitive->indices = currIndices;
-            int indexSize = GraphicsTypeToSize(primitive->indexType);
+            uint32_t jointIndex = 0;
+            SmallMemCpy(&jointIndex, joints, jointSize); 
+            ASSERT(jointIndex < 255u && "index has to be smaller than 255");
+            packedJoints |= jointIndex << shift;
+            shift += 8;
+            joints += jointSize;
+        }
 
-            for (int i = 0; i < primitive->numIndices; i++)
-            {
-                uint32_t index = 0;
-                SmallMemCpy(&index, beforeCopy, indexSize);
-                // we are combining all vertices and indices into one buffer, that's why we have to add vertex cursor
-                currIndices[i] = index + vertexCursor; 
-                beforeCopy += indexSize;
-            }
-            
-            // https://www.yosoygames.com.ar/wp/2018/03/vertex-formats-part-1-compression/
-            primitive->vertices = currVertex;
-            Vec3f* positions = (Vec3f*)primitive->vertexAttribs[0];
-            Vec2f* texCoords = (Vec2f*)primitive->vertexAttribs[1];
-            Vec3f* normals   = (Vec3f*)primitive->vertexAttribs[2];
-            Vector4x32f*    tangents  = (Vector4x32f*)primitive->vertexAttribs[3];
-
-            for (int v = 0; v < primitive->numVertices; v++)
+        uint32_t packedWeights = 0u;
+        if (weightSize == 4) // if float, pack it directly
+        {
+            packedWeights = PackColor4PtrToUint((float*)weights);
+            weights += weightSize * 4;
+        }
+        else
+        {
+            for (int k = 0, shift = 0; k < primitive->jointCount && k < 4; k++, shift += 8)
             {
-                Vector4x32f tangent     = tangents  ? tangents[v]  : VecZero();
-                Vec2f texCoord = texCoords ? texCoords[v] : (Vec2f){0.0f, 0.0f};
-                Vec3f normal   = normals   ? normals[v]   : (Vec3f){0.5f, 0.5f, 0.0};
-
-                currVertex[v].position = positions[v];
-                currVertex[v].texCoord = ConvertFloat2ToHalf2(&texCoord.x);
-                currVertex[v].normal   = Pack_INT_2_10_10_10_REV(normal);
-                currVertex[v].tangent  = Pack_INT_2_10_10_10_REV_VEC(tangent);
+                uint32_t jointWeight = 0u;
+                SmallMemCpy(&jointWeight, weights, weightSize); 
+                float weightMax = (float)((1u << (weightSize * 8)) - 1);
+                float norm = (float)jointWeight / weightMax; // divide by 255 or 65535
+                packedWeights |= (uint32_t)(norm * 255.0f) << shift;
+                weights += weightSize;
             }
+        }
+        currVertex[j].joints  = packedJoints;
+        currVertex[j].weights = packedWeights;
 
-            // convert whatever joint format to rgb8u
-            char* joints  = (char*)primitive->vertexAttribs[5];
-            char* weights = (char*)primitive->vertexAttribs[6];
+        if (currVertex[j].weights == 0)
+            currVertex[j].weights = 0XFF000000u;
 
-            // size and offset in bytes
-            int jointSize = GraphicsTypeToSize(primitive->jointType);
-            int jointOffset = Max32((int)(primitive->jointStride - (jointSize * primitive->jointCount)), 0); // stride - sizeof(rgbau16)
-            // size and offset in bytes
-            int weightSize   = GraphicsTypeToSize(primitive->weightType);
-            int weightOffset = Max32((int)(primitive->weightStride - (weightSize * primitive->jointCount)), 0);
-            
-            for (int j = 0; j < primitive->numVertices; j++)
-            {
-                // Combine 4 indices into one integer to save space
-                uint32_t packedJoints = 0u;
-                // iterate over joint indices, most of the time 4 indices
-                for (int k = 0, shift = 0; k < primitive->jointCount; k++)
-                {
-                    uint32_t jointIndex = 0;
-                    SmallMemCpy(&jointIndex, joints, jointSize); 
-                    ASSERT(jointIndex < 255u && "index has to be smaller than 255");
-                    packedJoints |= jointIndex << shift;
-                    shift += 8;
-                    joints += jointSize;
-                }
+        joints  += jointOffset; // stride offset at the end of the struct
+        weights += weightOffset;
+    }
+}
 
-                uint32_t packedWeights;
-                if (weightSize == 4) // if float, pack it directly
-                {
-                    packedWeights = PackColor4PtrToUint((float*)weights);
-                    weights += weightSize * 4;
-                }
-                else
-                {
-                    for (int k = 0, shift = 0; k < primitive->jointCount && k < 4; k++, shift += 8)
-                    {
-                        uint32_t jointWeight = 0u;
-                        SmallMemCpy(&jointWeight, weights, weightSize); 
-                        float weightMax = (float)((1u << (weightSize * 8)) - 1);
-                        float norm = (float)jointWeight / weightMax; // divide by 255 or 65535
-                        packedWeights |= (uint32_t)(norm * 255.0f) << shift;
-                        weights += weightSize;
-                    }
-                }
-                currVertex[j].joints  = packedJoints;
-                currVertex[j].weights = packedWeights;
+static void PackPrimitivesJob(void* data, int begin, int end)
+{
+    APackContext* context = (APackContext*)data;
+    for (int i = begin; i < end; i++)
+    {
+        APackPrimitive pack = context->primitives[i];
+        APrimitive* primitive = pack.primitive;
+        char* vertices = context->vertices + (size_t)pack.vertexOffset * context->vertexSize;
 
-                if (currVertex[j].weights == 0)
-                    currVertex[j].weights = 0XFF000000u;
+        PackPrimitiveIndices(primitive, context->indices + pack.indexOffset, pack.vertexOffset);
+        PackPrimitiveVertices(primitive, vertices, context->vertexSize);
+        
+        if (context->vertexSize == sizeof(ASkinedVertex))
+            PackPrimitiveJoints(primitive, (ASkinedVertex*)vertices);
+        
+        primitive->indexOffset = (int)pack.indexOffset;
+    }
+}
 
-                joints  += jointOffset; // stride offset at the end of the struct
-                weights += weightOffset;
-            }
+static void PackAllPrimitives(SceneBundle* gltf, int vertexSize)
+{
+    // pre allocate all vertices and indices 
+    gltf->allVertices = AllocAligned((size_t)vertexSize * gltf->totalVertices, 4);
+    gltf->allIndices  = AllocAligned(gltf->totalIndices * sizeof(uint32_t) + 16, 4); // 16->give little bit of space for memcpy
+    gltf->allIndicesSize = gltf->totalIndices * sizeof(uint32_t);
+    
+    int numPrimitives = 0;
+    APackContext context;
+    context.primitives = GatherPackPrimitives(gltf, &numPrimitives);
+    context.vertices   = (char*)gltf->allVertices;
+    context.indices    = (uint32_t*)gltf->allIndices;
+    context.vertexSize = vertexSize;
+    
+    JobSystem_ParallelFor(numPrimitives, 1, PackPrimitivesJob, &context);
+    rpfree(context.primitives);
+}
 
-            currVertex += primitive->numVertices;
-            primitive->indexOffset = indexCursor;
-            indexCursor += primitive->numIndices;
-            
-            vertexCursor += primitive->numVertices;
-            currIndices  += primitive->numIndices;
-        }
-    }
+void CreateVerticesIndices(SceneBundle* gltf)
+{
+    PackAllPrimitives(gltf, sizeof(AVertex));
+    FreeGLTFBuffers(gltf);
+}
+
+void CreateVerticesIndicesSkined(SceneBundle* gltf)
+{
+    PackAllPrimitives(gltf, sizeof(ASkinedVertex));
     
     for (int s = 0; s < gltf->numSkins; s++)
     {
@@ -652,13 +737,123 @@ void CreateVerticesIndicesSkined(SceneBundle* gltf)
     FreeGLTFBuffers(gltf);
 }
 
+int SceneBundleVertexSize(const SceneBundle* bundle)
+{
+    int size;
+    if (bundle->quantizedPositions)
+        size = bundle->numSkins > 0 ? sizeof(ASkinedVertexQuantized) : sizeof(AVertexQuantized);
+    else
+        size = bundle->numSkins > 0 ? sizeof(ASkinedVertex) : sizeof(AVertex);
+    return bundle->octahedralTangents ? size - sizeof(uint32_t) : size;
+}
+
+typedef struct AOptimizeContext_
+{
+    APackPrimitive* primitives;
+    float*          acmrBefore; // per primitive
+    float*          acmrAfter;
+    char*           vertices;
+    uint32_t*       indices;
+    int             vertexSize;
+} AOptimizeContext;
+
+static void OptimizePrimitivesJob(void* data, int begin, int end)
+{
+    AOptimizeContext* context = (AOptimizeContext*)data;
+    for (int i = begin; i < end; i++)
+    {
+        APackPrimitive pack = context->primitives[i];
+        APrimitive* primitive = pack.primitive;
+        uint32_t* indices = context->indices + pack.indexOffset;
+        int numIndices  = primitive->numIndices;
+        int numVertices = primitive->numVertices;
+
+        context->acmrBefore[i] = CalculateACMR(indices, numIndices, pack.vertexOffset, numVertices);
+        if (primitive->mode == 0 || primitive->mode == 4) // only triangle lists
+        {
+            OptimizeVertexCache(indices, numIndices, pack.vertexOffset, numVertices);
+            OptimizeOverdraw(indices, numIndices, context->vertices, context->vertexSize, pack.vertexOffset, numVertices);
+            // morph targets are indexed with the original vertex order
+            if (primitive->morphTargets == NULL)
+                OptimizeVertexFetch(context->vertices, context->vertexSize, indices, numIndices, pack.vertexOffset, numVertices);
+        }
+        context->acmrAfter[i] = CalculateACMR(indices, numIndices, pack.vertexOffset, numVertices);
+    }
+}
+
+// call after CreateVerticesIndices or CreateVerticesIndicesSkined, SaveGLTFBinary calls it with ABMSaveFlag_OptimizeMeshes
+void OptimizeMeshes(SceneBundle* gltf)
+{
+    int numPrimitives = 0;
+    AOptimizeContext context;
+    context.primitives = GatherPackPrimitives(gltf, &numPrimitives);
+    context.acmrBefore = rpmalloc(sizeof(float) * MMAX(numPrimitives, 1) * 2);
+    context.acmrAfter  = context.acmrBefore + numPrimitives;
+    context.vertices   = (char*)gltf->allVertices;
+    context.indices    = (uint32_t*)gltf->allIndices;
+    context.vertexSize = gltf->skins != NULL ? sizeof(ASkinedVertex) : sizeof(AVertex);
+
+    JobSystem_ParallelFor(numPrimitives, 1, OptimizePrimitivesJob, &context);
+
+    // weighted by number of triangles
+    double missesBefore = 0.0, missesAfter = 0.0;
+    for (int i = 0; i < numPrimitives; i++)
+    {
+        int numTriangles = context.primitives[i].primitive->numIndices / 3;
+        missesBefore += (double)context.acmrBefore[i] * numTriangles;
+        missesAfter  += (double)context.acmrAfter[i] * numTriangles;
+    }
+    int numTriangles = MMAX(gltf->totalIndices / 3, 1);
+    AX_LOG("mesh optimization ACMR before: %f after: %f", missesBefore / numTriangles, missesAfter / numTriangles);
+    (void)missesBefore; (void)missesAfter; (void)numTriangles;
+
+    rpfree(context.acmrBefore);
+    rpfree(context.primitives);
+}
+
 
 /*//////////////////////////////////////////////////////////////////////////*/
 /*                            Binary Save                                   */
 /*//////////////////////////////////////////////////////////////////////////*/
 
 ZSTD_CCtx* zstdCompressorCTX = NULL;
-const int ABMMeshVersion = 42;
+const int ABMMeshVersion = 50;
+const int ABMStreamVersion = 42; // old format that is read field by field, only loading is supported
+
+// pointers inside of the abm file are stored as offsets from the beginning of the file, zero means NULL.
+// so the file layout is same as memory layout of the structs, it only works on 64bit platforms
+STATIC_ASSERT(sizeof(void*) == sizeof(uint64_t), "abm file layout requires 64bit pointers");
+
+// vertices and indices are compressed as independent zstd frames, so we can decode them in parallel.
+// each frame decompresses to ABM_FRAME_SIZE bytes except the last one
+#define ABM_FRAME_SIZE (256 * 1024)
+
+typedef struct ABMFrame_
+{
+    uint64_t offset; // offset of the compressed data in the file
+    uint64_t size;   // compressed size in bytes
+} ABMFrame;
+
+typedef struct ABMStream_
+{
+    uint64_t framesOffset; // ABMFrame[numFrames] frame table
+    uint64_t size;         // decompressed size in bytes
+    int      numFrames;
+    int      pad;
+} ABMStream;
+
+// every abm file starts with: int version, uint64 0xABFABF, int pad. (16 bytes)
+// after that ABMHeader comes, then metadata (meshes, nodes, materials...), frame tables, at the end compressed vertices and indices
+typedef struct ABMHeader_
+{
+    ABMStream vertexStream;
+    ABMStream indexStream; // uint16 or uint32 indices depending on primitive's indexType
+    int       isSkined;
+    int       pad;
+    SceneBundle bundle;    // pointers are offsets
+} ABMHeader;
+
+#define ABM_PREFIX_SIZE 16
 
 bool IsABMLastVersion(const char* path)
 {
@@ -675,219 +870,472 @@ bool IsABMLastVersion(const char* path)
     return version == ABMMeshVersion && hex == 0xABFABF;
 }
 
-static void WriteAMaterialTexture(GLTFTexture texture, AFile file)
+#if !AX_GAME_BUILD
+
+// growable byte buffer that we serialize the scene into, then we write to the file at once
+typedef struct ABMWriter_
+{
+    char*    data;
+    uint64_t size;
+    uint64_t capacity;
+} ABMWriter;
+
+#define ABM_AT(writer, type, offset) ((type*)((writer)->data + (offset)))
+
+// returns offset of the pushed data, if src is null pushed memory will be zero
+static uint64_t ABMWriter_Push(ABMWriter* writer, const void* src, uint64_t size, uint64_t alignment)
 {
-    uint64_t data = texture.scale; data <<= sizeof(uint16_t) * 8;
-    data |= texture.strength;      data <<= sizeof(uint16_t) * 8;
-    data |= texture.index;         data <<= sizeof(uint16_t) * 8;
-    data |= texture.texCoord;
+    if (size == 0) return 0; // empty arrays are stored as null
+    uint64_t offset = AlignAddress(writer->size, alignment);
+    if (offset + size > writer->capacity)
+    {
+        uint64_t newCapacity = MMAX(writer->capacity * 2, offset + size);
+        writer->data = rprealloc(writer->data, newCapacity);
+        writer->capacity = newCapacity;
+    }
+    MemsetZero(writer->data + writer->size, offset - writer->size); // padding
     
-    AFileWrite(&data, sizeof(uint64_t), file, 1);
+    if (src) { SmallMemCpy(writer->data + offset, src, size); }
+    else     { MemsetZero(writer->data + offset, size); }
+
+    writer->size = offset + size;
+    return offset;
 }
 
-static void WriteGLTFString(const char* str, AFile file)
+static uint64_t ABMWriter_PushString(ABMWriter* writer, const char* str)
 {
-    int nameLen = str ? StringLength(str) : 0;
-    AFileWrite(&nameLen, sizeof(int), file, 1);
-    if (str) AFileWrite(str, nameLen + 1, file, 1);
+    if (str == NULL) return 0;
+    return ABMWriter_Push(writer, str, StringLength(str) + 1, 1);
 }
 
-int SaveGLTFBinary(SceneBundle* gltf, const char* path)
+// splits the buffer into ABM_FRAME_SIZE chunks and compresses each of them with zstd independently
+static ABMStream ABMWriter_PushFrames(ABMWriter* writer, const void* src, uint64_t size)
 {
-#if !AX_GAME_BUILD
-    AFile file = AFileOpen(path, AOpenFlag_WriteBinary);
+    ABMStream stream;
+    MemsetZero(&stream, sizeof(ABMStream));
+    stream.size = size;
+    stream.numFrames = (int)((size + ABM_FRAME_SIZE - 1) / ABM_FRAME_SIZE);
+    stream.framesOffset = ABMWriter_Push(writer, NULL, sizeof(ABMFrame) * stream.numFrames, 16);
+
+    if (zstdCompressorCTX == NULL)
+        zstdCompressorCTX = ZSTD_createCCtx();
+
+    for (int i = 0; i < stream.numFrames; i++)
+    {
+        uint64_t frameBegin = (uint64_t)i * ABM_FRAME_SIZE;
+        uint64_t frameSize  = MMIN(size - frameBegin, (uint64_t)ABM_FRAME_SIZE);
+        uint64_t bound  = ZSTD_compressBound(frameSize);
+        uint64_t offset = ABMWriter_Push(writer, NULL, bound, 16);
+        uint64_t compressedSize = ZSTD_compressCCtx(zstdCompressorCTX, writer->data + offset, bound, (const char*)src + frameBegin, frameSize, 5);
+        writer->size = offset + compressedSize;
+
+        ABMFrame* frame = ABM_AT(writer, ABMFrame, stream.framesOffset) + i;
+        frame->offset = offset;
+        frame->size   = compressedSize;
+    }
+    return stream;
+}
+
+// AABB of the vertices, used for dequantization of the positions and lod selection
+static void CalculatePrimitiveBounds(APrimitive* primitive, const char* vertices, int numVertices, int vertexSize)
+{
+    Vec3f min = { FLT_MAX, FLT_MAX, FLT_MAX }, max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (int i = 0; i < numVertices; i++)
+    {
+        const float* pos = (const float*)(vertices + (uint64_t)i * vertexSize);
+        min.x = MMIN(min.x, pos[0]); min.y = MMIN(min.y, pos[1]); min.z = MMIN(min.z, pos[2]);
+        max.x = MMAX(max.x, pos[0]); max.y = MMAX(max.y, pos[1]); max.z = MMAX(max.z, pos[2]);
+    }
+    if (numVertices == 0) min = max = Vec3Zero();
     
-    int version = ABMMeshVersion;
-    AFileWrite(&version, sizeof(int), file, 1);
-    
-    uint64_t reserved[4] = { 0xABFABF };
-    AFileWrite(&reserved, sizeof(uint64_t) * 4, file, 1);
-    
-    AFileWrite(&gltf->scale, sizeof(float), file, 1);
-    AFileWrite(&gltf->numMeshes, sizeof(short), file, 1);
-    AFileWrite(&gltf->numNodes, sizeof(short), file, 1);
-    AFileWrite(&gltf->numMaterials,  sizeof(short), file, 1);
-    AFileWrite(&gltf->numTextures, sizeof(short), file, 1);
-    AFileWrite(&gltf->numImages, sizeof(short), file, 1);
-    AFileWrite(&gltf->numSamplers, sizeof(short), file, 1);
-    AFileWrite(&gltf->numCameras, sizeof(short), file, 1);
-    AFileWrite(&gltf->numScenes, sizeof(short), file, 1);
-    AFileWrite(&gltf->numSkins, sizeof(short), file, 1);
-    AFileWrite(&gltf->numAnimations, sizeof(short), file, 1);
-    AFileWrite(&gltf->defaultSceneIndex, sizeof(short), file, 1);
-    short isSkined = (short)(gltf->skins != NULL);
-    AFileWrite(&isSkined, sizeof(short), file, 1);
-    
-    AFileWrite(&gltf->totalIndices, sizeof(int), file, 1);
-    AFileWrite(&gltf->totalVertices, sizeof(int), file, 1);
-    
-    uint64_t vertexSize = isSkined ? sizeof(ASkinedVertex) : sizeof(AVertex);
-    uint64_t allVertexSize = vertexSize * (uint64_t)gltf->totalVertices;
-    uint64_t allIndexSize = (uint64_t)gltf->totalIndices * sizeof(uint32_t);
+    primitive->min[0] = min.x; primitive->min[1] = min.y; primitive->min[2] = min.z;
+    primitive->max[0] = max.x; primitive->max[1] = max.y; primitive->max[2] = max.z;
+}
+
+// positions are normalized to the AABB of the vertices (primitive's min max), so we use the full 16 bit range.
+static void QuantizePrimitivePositions(const APrimitive* primitive, char* dst, const char* src, int numVertices, int dstVertexSize, int srcVertexSize)
+{
+    float minArr[3] = { primitive->min[0], primitive->min[1], primitive->min[2] }, invExtent[3];
+    for (int j = 0; j < 3; j++)
+    {
+        float extent = primitive->max[j] - minArr[j];
+        invExtent[j] = extent > 0.0f ? 65535.0f / extent : 0.0f;
+    }
     
-    // Compress and write, vertices and indices
-    uint64_t compressedSize = (uint64_t)(allVertexSize * 0.9);
-    char* compressedBuffer = rpmalloc(compressedSize);
+    for (int i = 0; i < numVertices; i++)
+    {
+        const float* pos = (const float*)(src + (uint64_t)i * srcVertexSize);
+        uint16_t* qpos = (uint16_t*)(dst + (uint64_t)i * dstVertexSize);
+        for (int j = 0; j < 3; j++)
+        {
+            float q = (pos[j] - minArr[j]) * invExtent[j] + 0.5f;
+            qpos[j] = (uint16_t)MMIN(q, 65535.0f);
+        }
+        qpos[3] = 0;
+    }
+}
+
+// INT_2_10_10_10_REV normals and tangents are unpacked in chunks and repacked with octahedral encoding
+static void PackPrimitiveOctahedralTangents(char* dst, const char* src, int numVertices, int dstVertexSize, int srcVertexSize)
+{
+    Vec3f    normals[AX_PACK_CHUNK];
+    float    tangents[AX_PACK_CHUNK * 4];
+    uint32_t packed[AX_PACK_CHUNK];
+
+    for (int begin = 0; begin < numVertices; begin += AX_PACK_CHUNK)
+    {
+        int count = MMIN(numVertices - begin, AX_PACK_CHUNK);
+        for (int i = 0; i < count; i++)
+        {
+            const uint32_t* normalTangent = (const uint32_t*)(src + (uint64_t)(begin + i) * srcVertexSize);
+            Vec3f tangent = Unpack_INT_2_10_10_10_REV(normalTangent[1]);
+            normals[i] = Unpack_INT_2_10_10_10_REV(normalTangent[0]);
+            tangents[i * 4 + 0] = tangent.x;
+            tangents[i * 4 + 1] = tangent.y;
+            tangents[i * 4 + 2] = tangent.z;
+            tangents[i * 4 + 3] = (normalTangent[1] >> 31) ? -1.0f : 1.0f;
+        }
+        PackOctahedralTangentN(packed, normals, tangents, count);
+
+        for (int i = 0; i < count; i++)
+            *(uint32_t*)(dst + (uint64_t)(begin + i) * dstVertexSize) = packed[i];
+    }
+}
+
+// writes the vertices of the primitive with the format of the save flags. position, normal tangent, rest of the attributes
+static void ConvertPrimitiveVertices(const APrimitive* primitive, char* dst, const char* src, int numVertices, 
+                                     int dstVertexSize, int srcVertexSize, int saveFlags)
+{
+    int dstPositionSize = (saveFlags & ABMSaveFlag_QuantizePositions) ? sizeof(uint16_t) * 4 : sizeof(Vec3f);
+    int dstNormalSize   = (saveFlags & ABMSaveFlag_OctahedralTangents) ? sizeof(uint32_t) : sizeof(uint32_t) * 2;
+    const int srcNormalOffset = sizeof(Vec3f), srcRestOffset = srcNormalOffset + sizeof(uint32_t) * 2;
+    const int restSize = srcVertexSize - srcRestOffset; // texCoord, joints, weights
     
-    size_t afterCompSize = ZSTD_compress(compressedBuffer, compressedSize, gltf->allVertices, allVertexSize, 5);
-    AFileWrite(&afterCompSize, sizeof(uint64_t), file, 1);
-    AFileWrite(compressedBuffer, afterCompSize, file, 1);
+    if (saveFlags & ABMSaveFlag_QuantizePositions)
+        QuantizePrimitivePositions(primitive, dst, src, numVertices, dstVertexSize, srcVertexSize);
     
-    afterCompSize = ZSTD_compress(compressedBuffer, compressedSize, gltf->allIndices, allIndexSize, 5);
-    AFileWrite(&afterCompSize, sizeof(uint64_t), file, 1);
-    AFileWrite(compressedBuffer, afterCompSize, file, 1);
+    if (saveFlags & ABMSaveFlag_OctahedralTangents)
+        PackPrimitiveOctahedralTangents(dst + dstPositionSize, src + srcNormalOffset, numVertices, dstVertexSize, srcVertexSize);
+    
+    for (int i = 0; i < numVertices; i++)
+    {
+        char* dstVertex = dst + (uint64_t)i * dstVertexSize;
+        const char* srcVertex = src + (uint64_t)i * srcVertexSize;
+        if (!(saveFlags & ABMSaveFlag_QuantizePositions))
+            SmallMemCpy(dstVertex, srcVertex, sizeof(Vec3f));
+        if (!(saveFlags & ABMSaveFlag_OctahedralTangents))
+            SmallMemCpy(dstVertex + dstPositionSize, srcVertex + srcNormalOffset, sizeof(uint32_t) * 2);
+        SmallMemCpy(dstVertex + dstPositionSize + dstNormalSize, srcVertex + srcRestOffset, restSize);
+    }
+}
+
+// writes indices relative to the baseVertex, returns the offset in elements of the index type
+static int PackRelativeIndices(char* dst, uint64_t* dstSize, const uint32_t* indices, int numIndices, uint32_t baseVertex, bool shortIndices)
+{
+    uint64_t indexSize = shortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+    uint64_t offset = AlignAddress(*dstSize, indexSize); // uint32 indices after uint16 indices
+    for (int k = 0; k < numIndices; k++)
+    {
+        uint32_t index = indices[k] - baseVertex;
+        if (shortIndices) ((uint16_t*)(dst + offset))[k] = (uint16_t)index;
+        else              ((uint32_t*)(dst + offset))[k] = index;
+    }
+    *dstSize = offset + indexSize * numIndices;
+    return (int)(offset / indexSize);
+}
 
-    rpfree(compressedBuffer);
-    // Note: anim morph targets aren't saved
+// meshlet builder changes the order of the triangles, so vertex cache optimization is applied again inside of each meshlet
+static void OptimizeMeshletsVertexCache(uint32_t* indices, const AMeshlet* meshlets, int numMeshlets)
+{
+    for (int i = 0; i < numMeshlets; i++)
+    {
+        uint32_t* meshletIndices = indices + meshlets[i].indexOffset;
+        uint32_t minIndex = meshletIndices[0], maxIndex = meshletIndices[0];
+        for (int j = 1; j < meshlets[i].numIndices; j++)
+        {
+            minIndex = MMIN(minIndex, meshletIndices[j]);
+            maxIndex = MMAX(maxIndex, meshletIndices[j]);
+        }
+        OptimizeVertexCache(meshletIndices, meshlets[i].numIndices, minIndex, (int)(maxIndex - minIndex) + 1);
+    }
+}
+#endif
 
+int SaveGLTFBinary(SceneBundle* gltf, const char* path, int saveFlags)
+{
+#if !AX_GAME_BUILD
+    ABMWriter writer = { 0 };
+    ABMWriter_Push(&writer, NULL, ABM_PREFIX_SIZE, 16);
+    uint64_t headerOffset = ABMWriter_Push(&writer, NULL, sizeof(ABMHeader), 16);
+
+    SceneBundle bundle = *gltf;
+    // these are runtime data, vertices and indices are compressed at the end of the file
+    bundle.buffers     = NULL; bundle.numBuffers = 0;
+    bundle.allVertices = NULL;
+    bundle.allIndices  = NULL;
+    bundle.allocator   = NULL;
+    bundle.mappedFile  = NULL;
+    bundle.error       = AError_NONE;
+    bundle.allIndicesSize = 0; // set while loading
+    
+    if (saveFlags & ABMSaveFlag_OptimizeMeshes)
+        OptimizeMeshes(gltf);
+    
+    // meshlet builder reorders the indices, original indices stays untouched
+    int isSkined = gltf->skins != NULL;
+    uint64_t vertexSize   = isSkined ? sizeof(ASkinedVertex) : sizeof(AVertex);
+    uint64_t allIndexSize = (uint64_t)gltf->totalIndices * sizeof(uint32_t);
+    uint32_t* meshletIndices = rpmalloc(allIndexSize + 16);
+    SmallMemCpy(meshletIndices, gltf->allIndices, allIndexSize);
+    
+    bundle.quantizedPositions = !!(saveFlags & ABMSaveFlag_QuantizePositions);
+    bundle.octahedralTangents = !!(saveFlags & ABMSaveFlag_OctahedralTangents);
+    bool convertVertices = bundle.quantizedPositions || bundle.octahedralTangents;
+    uint64_t dstVertexSize = SceneBundleVertexSize(&bundle);
+    char* convertedVertices = convertVertices ? rpmalloc(dstVertexSize * gltf->totalVertices + 16) : NULL;
+    
+    // lods of a primitive are simplified from the previous level and each level has at most 80% of the previous one,
+    // so they are less than twice the primitive (AX_LOD_INDEX_CAPACITY). lodIndices is reused for each primitive
+    bool generateLods = !!(saveFlags & ABMSaveFlag_GenerateLods);
+    int lodCapacity = AX_LOD_INDEX_CAPACITY(gltf->totalIndices);
+    uint32_t* lodIndices = generateLods ? rpmalloc(sizeof(uint32_t) * lodCapacity + 16) : NULL;
+    
+    // indices are stored relative to the first vertex of the primitive, so most of the primitives fits into uint16.
+    // original indices and the lods of all primitives
+    char* packedIndices = rpmalloc(allIndexSize * (generateLods ? 3 : 1) + 16);
+    uint64_t packedIndexSize = 0;
+    uint32_t vertexCursor = 0;
+    double   savedMisses = 0.0; // ACMR of the index order that we write, weighted by number of triangles
+    
+    uint64_t meshesOffset = ABMWriter_Push(&writer, gltf->meshes, sizeof(AMesh) * gltf->numMeshes, 16);
     for (int i = 0; i < gltf->numMeshes; i++)
     {
-        AMesh mesh = gltf->meshes[i];
-        WriteGLTFString(mesh.name, file);
-        
-        AFileWrite(&mesh.numPrimitives  , sizeof(int), file, 1);
+        AMesh* srcMesh = &gltf->meshes[i];
+        uint64_t nameOffset = ABMWriter_PushString(&writer, srcMesh->name);
+        uint64_t primitivesOffset = ABMWriter_Push(&writer, srcMesh->primitives, sizeof(APrimitive) * srcMesh->numPrimitives, 16);
         
-        for (int j = 0; j < mesh.numPrimitives; j++)
+        for (int j = 0; j < srcMesh->numPrimitives; j++)
         {
-            APrimitive* primitive = &mesh.primitives[j];
-            AFileWrite(&primitive->attributes , sizeof(int), file, 1);
-            AFileWrite(&primitive->indexType  , sizeof(int), file, 1);
-            AFileWrite(&primitive->numIndices , sizeof(int), file, 1);
-            AFileWrite(&primitive->numVertices, sizeof(int), file, 1);
-            AFileWrite(&primitive->indexOffset, sizeof(int), file, 1);
-            AFileWrite(&primitive->jointType  , sizeof(short), file, 1);
-            AFileWrite(&primitive->jointCount , sizeof(short), file, 1);
-            AFileWrite(&primitive->jointStride, sizeof(short), file, 1);
-            AFileWrite(&primitive->material   , sizeof(short), file, 1);
+            // vertex and index pointers are recalculated while loading
+            APrimitive* primitive = ABM_AT(&writer, APrimitive, primitivesOffset) + j;
+            primitive->indices  = NULL;
+            primitive->vertices = NULL;
+            primitive->morphTargets = NULL; // Note: anim morph targets aren't saved
+            primitive->hasOutline = false;
+            primitive->meshlets = NULL;
+            primitive->numMeshlets = 0;
+            MemsetZero(primitive->vertexAttribs, sizeof(primitive->vertexAttribs));
+            
+            APrimitive* srcPrimitive = &srcMesh->primitives[j];
+            uint32_t* srcIndices = meshletIndices + srcPrimitive->indexOffset;
+            if (srcPrimitive->numIndices >= 3 && (srcPrimitive->mode == 0 || srcPrimitive->mode == 4)) // only triangle lists
+            {
+                AMeshlet* meshlets = rpmalloc(sizeof(AMeshlet) * (srcPrimitive->numIndices / 3));
+                int numMeshlets;
+                if (saveFlags & ABMSaveFlag_OptimizeMeshes)
+                {
+                    // indices are already in vertex cache order, meshlets are cut from it so the whole primitive draws keeps that order
+                    numMeshlets = BuildMeshletsScan(meshlets, srcIndices, srcPrimitive->numIndices, gltf->allVertices, (int)vertexSize);
+                }
+                else
+                {
+                    numMeshlets = BuildMeshlets(meshlets, srcIndices, srcPrimitive->numIndices, gltf->allVertices, (int)vertexSize);
+                    OptimizeMeshletsVertexCache(srcIndices, meshlets, numMeshlets);
+                }
+                uint64_t meshletsOffset = ABMWriter_Push(&writer, meshlets, sizeof(AMeshlet) * numMeshlets, 16);
+                rpfree(meshlets);
+                
+                primitive = ABM_AT(&writer, APrimitive, primitivesOffset) + j; // push might reallocate
+                primitive->meshlets    = (AMeshlet*)meshletsOffset;
+                primitive->numMeshlets = numMeshlets;
+            }
+            
+            savedMisses += (double)CalculateACMR(srcIndices, srcPrimitive->numIndices, vertexCursor, srcPrimitive->numVertices) * (srcPrimitive->numIndices / 3);
+            
+            bool shortIndices = srcPrimitive->numVertices <= UINT16_MAX + 1;
+            primitive->indexType   = shortIndices ? GraphicType_UnsignedShort : GraphicType_UnsignedInt;
+            primitive->indexOffset = PackRelativeIndices(packedIndices, &packedIndexSize, srcIndices, srcPrimitive->numIndices, vertexCursor, shortIndices);
+            primitive->baseVertex  = (int)vertexCursor;
+            primitive->numLods     = 0;
+            CalculatePrimitiveBounds(primitive, (char*)gltf->allVertices + vertexCursor * vertexSize, srcPrimitive->numVertices, (int)vertexSize);
+            
+            if (generateLods && srcPrimitive->numIndices >= 3 && (srcPrimitive->mode == 0 || srcPrimitive->mode == 4))
+            {
+                ALod* lods = primitive->lods;
+                int numLods = GenerateLods(lods, lodIndices, lodCapacity, srcIndices, srcPrimitive->numIndices, gltf->allVertices, (int)vertexSize,
+                                           vertexCursor, srcPrimitive->numVertices);
+                lods[0].indexOffset = primitive->indexOffset;
+                lods[0].numIndices  = srcPrimitive->numIndices;
+                lods[0].error       = 0.0f;
+                for (int l = 1; l < numLods; l++)
+                    lods[l].indexOffset = PackRelativeIndices(packedIndices, &packedIndexSize, lodIndices + lods[l].indexOffset, lods[l].numIndices, vertexCursor, shortIndices);
+                primitive->numLods = numLods;
+            }
+            
+            if (convertVertices)
+            {
+                ConvertPrimitiveVertices(primitive, convertedVertices + vertexCursor * dstVertexSize,
+                                         (char*)gltf->allVertices + vertexCursor * vertexSize,
+                                         srcPrimitive->numVertices, (int)dstVertexSize, (int)vertexSize, saveFlags);
+            }
+            vertexCursor += srcPrimitive->numVertices;
         }
+        
+        AMesh* mesh = ABM_AT(&writer, AMesh, meshesOffset) + i;
+        mesh->name         = (char*)nameOffset;
+        mesh->primitives   = (APrimitive*)primitivesOffset;
+        mesh->morphWeights = NULL;
+        mesh->numMorphWeights = 0;
     }
+    bundle.meshes = (AMesh*)meshesOffset;
+    AX_LOG("abm index ACMR: %f %s", savedMisses / MMAX(gltf->totalIndices / 3, 1), path);
     
+    uint64_t nodesOffset = ABMWriter_Push(&writer, gltf->nodes, sizeof(ANode) * gltf->numNodes, 16);
     for (int i = 0; i < gltf->numNodes; i++)
     {
-        ANode* node = &gltf->nodes[i];
-        AFileWrite(&node->type       , sizeof(int), file, 1);
-        AFileWrite(&node->index      , sizeof(int), file, 1);
-        AFileWrite(&node->translation, sizeof(float) * 3, file, 1);
-        AFileWrite(&node->rotation   , sizeof(float) * 4, file, 1);
-        AFileWrite(&node->scale      , sizeof(float) * 3, file, 1);
-        AFileWrite(&node->numChildren, sizeof(int), file, 1);
-        
-        if (node->numChildren)
-            AFileWrite(node->children, sizeof(int) * node->numChildren, file, 1);
+        ANode* srcNode = &gltf->nodes[i];
+        uint64_t nameOffset = ABMWriter_PushString(&writer, srcNode->name);
+        uint64_t childrenOffset = srcNode->numChildren ? ABMWriter_Push(&writer, srcNode->children, sizeof(int) * srcNode->numChildren, 4) : 0;
         
-        WriteGLTFString(node->name, file);
+        ANode* node = ABM_AT(&writer, ANode, nodesOffset) + i;
+        node->name     = (char*)nameOffset;
+        node->children = (int*)childrenOffset;
+    }
+    bundle.nodes = (ANode*)nodesOffset;
+    
+    // sorted here instead of copying, so the files converted from any source have the hierarchy
+    uint64_t nodeOrderOffset   = ABMWriter_Push(&writer, NULL, sizeof(int) * gltf->numNodes, 4);
+    uint64_t nodeParentsOffset = ABMWriter_Push(&writer, NULL, sizeof(int) * gltf->numNodes, 4);
+    if (!BuildNodeHierarchy(gltf->nodes, gltf->numNodes, ABM_AT(&writer, int, nodeOrderOffset), ABM_AT(&writer, int, nodeParentsOffset)))
+    {
+        rpfree(meshletIndices);
+        rpfree(packedIndices);
+        if (lodIndices) rpfree(lodIndices);
+        if (convertedVertices) rpfree(convertedVertices);
+        rpfree(writer.data);
+        AX_ERROR("abm save failed, node hierarchy is malformed %s", path);
+        return 0;
     }
+    bundle.nodeOrder   = (int*)nodeOrderOffset;
+    bundle.nodeParents = (int*)nodeParentsOffset;
     
+    uint64_t materialsOffset = ABMWriter_Push(&writer, gltf->materials, sizeof(AMaterial) * gltf->numMaterials, 16);
     for (int i = 0; i < gltf->numMaterials; i++)
     {
-        AMaterial* material = &gltf->materials[i];
-        for (int j = 0; j < 3; j++)
-        {
-            WriteAMaterialTexture(material->textures[j], file);
-        }
-        
-        WriteAMaterialTexture(material->baseColorTexture, file);
-        WriteAMaterialTexture(material->specularTexture, file);
-        WriteAMaterialTexture(material->metallicRoughnessTexture, file);
-        
-        uint64_t data = material->emissiveFactor[0]; data <<= sizeof(short) * 8;
-        data |= material->emissiveFactor[1];         data <<= sizeof(short) * 8;
-        data |= material->emissiveFactor[2];         data <<= sizeof(short) * 8;
-        data |= material->specularFactor;
-        AFileWrite(&data, sizeof(uint64_t), file, 1);
-        
-        data = ((uint64_t)(material->diffuseColor) << 32) | material->specularColor;
-        AFileWrite(&data, sizeof(uint64_t), file, 1);
-        
-        data = ((uint64_t)(material->baseColorFactor) << 32) | (uint64_t)material->doubleSided;
-        AFileWrite(&data, sizeof(uint64_t), file, 1);
-        
-        AFileWrite(&material->alphaCutoff, sizeof(float), file, 1);
-        AFileWrite(&material->alphaMode, sizeof(int), file, 1);
-        
-        WriteGLTFString(material->name, file);
+        uint64_t nameOffset = ABMWriter_PushString(&writer, gltf->materials[i].name);
+        ABM_AT(&writer, AMaterial, materialsOffset)[i].name = (char*)nameOffset;
     }
+    bundle.materials = (AMaterial*)materialsOffset;
     
+    uint64_t texturesOffset = ABMWriter_Push(&writer, gltf->textures, sizeof(ATexture) * gltf->numTextures, 16);
     for (int i = 0; i < gltf->numTextures; i++)
     {
-        ATexture texture = gltf->textures[i];
-        AFileWrite(&texture.sampler, sizeof(int), file, 1);
-        AFileWrite(&texture.source, sizeof(int), file, 1);
-        WriteGLTFString(texture.name , file);
+        uint64_t nameOffset = ABMWriter_PushString(&writer, gltf->textures[i].name);
+        ABM_AT(&writer, ATexture, texturesOffset)[i].name = (char*)nameOffset;
     }
+    bundle.textures = (ATexture*)texturesOffset;
     
+    uint64_t imagesOffset = ABMWriter_Push(&writer, gltf->images, sizeof(AImage) * gltf->numImages, 16);
     for (int i = 0; i < gltf->numImages; i++)
     {
-        WriteGLTFString(gltf->images[i].path, file);
+        uint64_t pathOffset = ABMWriter_PushString(&writer, gltf->images[i].path);
+        ABM_AT(&writer, AImage, imagesOffset)[i].path = (char*)pathOffset;
     }
+    bundle.images = (AImage*)imagesOffset;
     
-    for (int i = 0; i < gltf->numSamplers; i++)
-    {
-    	AFileWrite(&gltf->samplers[i], sizeof(ASampler), file, 1);
-    }
+    bundle.samplers = (ASampler*)ABMWriter_Push(&writer, gltf->samplers, sizeof(ASampler) * gltf->numSamplers, 16);
     
+    uint64_t camerasOffset = ABMWriter_Push(&writer, gltf->cameras, sizeof(ACamera) * gltf->numCameras, 16);
     for (int i = 0; i < gltf->numCameras; i++)
     {
-        ACamera camera = gltf->cameras[i];
-        AFileWrite(&camera.aspectRatio, sizeof(float), file, 1);
-        AFileWrite(&camera.yFov, sizeof(float), file, 1);
-        AFileWrite(&camera.zFar, sizeof(float), file, 1);
-        AFileWrite(&camera.zNear, sizeof(float), file, 1);
-        AFileWrite(&camera.type, sizeof(int), file, 1);
-        WriteGLTFString(camera.name , file);
+        uint64_t nameOffset = ABMWriter_PushString(&writer, gltf->cameras[i].name);
+        ABM_AT(&writer, ACamera, camerasOffset)[i].name = (char*)nameOffset;
     }
+    bundle.cameras = (ACamera*)camerasOffset;
+    
+    uint64_t scenesOffset = ABMWriter_Push(&writer, gltf->scenes, sizeof(AScene) * gltf->numScenes, 16);
     for (int i = 0; i < gltf->numScenes; i++)
     {
-        AScene scene = gltf->scenes[i];
-        WriteGLTFString(scene.name, file);
-        AFileWrite(&scene.numNodes, sizeof(int), file, 1);
-        AFileWrite(scene.nodes, sizeof(int) * scene.numNodes, file, 1);
+        AScene* srcScene = &gltf->scenes[i];
+        uint64_t nameOffset  = ABMWriter_PushString(&writer, srcScene->name);
+        uint64_t nodesOffset = ABMWriter_Push(&writer, srcScene->nodes, sizeof(int) * srcScene->numNodes, 4);
+        AScene* scene = ABM_AT(&writer, AScene, scenesOffset) + i;
+        scene->name  = (char*)nameOffset;
+        scene->nodes = (int*)nodesOffset;
     }
+    bundle.scenes = (AScene*)scenesOffset;
     
+    uint64_t skinsOffset = ABMWriter_Push(&writer, gltf->skins, sizeof(ASkin) * gltf->numSkins, 16);
     for (int i = 0; i < gltf->numSkins; i++)
     {
-        ASkin skin = gltf->skins[i];
-        AFileWrite(&skin.skeleton, sizeof(int), file, 1);
-        AFileWrite(&skin.numJoints, sizeof(int), file, 1);
-        AFileWrite(skin.inverseBindMatrices, sizeof(Matrix4) * skin.numJoints, file, 1);
-        AFileWrite(skin.joints, sizeof(int) * skin.numJoints, file, 1);
+        ASkin* srcSkin = &gltf->skins[i];
+        uint64_t nameOffset   = ABMWriter_PushString(&writer, srcSkin->name);
+        uint64_t matrixOffset = ABMWriter_Push(&writer, srcSkin->inverseBindMatrices, sizeof(Matrix4) * srcSkin->numJoints, 16);
+        uint64_t jointsOffset = ABMWriter_Push(&writer, srcSkin->joints, sizeof(int) * srcSkin->numJoints, 4);
+        ASkin* skin = ABM_AT(&writer, ASkin, skinsOffset) + i;
+        skin->name = (char*)nameOffset;
+        skin->inverseBindMatrices = (float*)matrixOffset;
+        skin->joints = (int*)jointsOffset;
     }
+    bundle.skins = (ASkin*)skinsOffset;
     
-    int totalAnimSamplerInput = 0;
-    if (gltf->numAnimations > 0)
-    {
-        for (int a = 0; a < gltf->numAnimations; a++)
-            for (int s = 0; s < gltf->animations[a].numSamplers; s++)
-                totalAnimSamplerInput += gltf->animations[a].samplers[s].count;
-    }
-
-    AFileWrite(&totalAnimSamplerInput, sizeof(int), file, 1);
-    if (totalAnimSamplerInput > 0) {
-        // all sampler input and outputs are allocated in one buffer each. at the end of the CreateVerticesIndicesSkined function
-        AFileWrite(gltf->animations[0].samplers[0].input, sizeof(float) * totalAnimSamplerInput, file, 1);
-        AFileWrite(gltf->animations[0].samplers[0].output, sizeof(Vector4x32f) * totalAnimSamplerInput, file, 1);
-    }
-
+    uint64_t animationsOffset = ABMWriter_Push(&writer, gltf->animations, sizeof(AAnimation) * gltf->numAnimations, 16);
     for (int i = 0; i < gltf->numAnimations; i++)
     {
-        AAnimation animation = gltf->animations[i];
-        AFileWrite(&animation.numSamplers, sizeof(int), file, 1);
-        AFileWrite(&animation.numChannels, sizeof(int), file, 1);
-        AFileWrite(&animation.duration, sizeof(float), file, 1);
-        AFileWrite(&animation.speed, sizeof(float), file, 1);
-        WriteGLTFString(animation.name, file);
-
-        AFileWrite(animation.channels, sizeof(AAnimChannel) * animation.numChannels, file, 1);
+        AAnimation* srcAnimation = &gltf->animations[i];
+        uint64_t nameOffset     = ABMWriter_PushString(&writer, srcAnimation->name);
+        uint64_t channelsOffset = ABMWriter_Push(&writer, srcAnimation->channels, sizeof(AAnimChannel) * srcAnimation->numChannels, 16);
+        uint64_t samplersOffset = ABMWriter_Push(&writer, srcAnimation->samplers, sizeof(AAnimSampler) * srcAnimation->numSamplers, 16);
         
-        for (int j = 0; j < animation.numSamplers; j++)
+        for (int j = 0; j < srcAnimation->numSamplers; j++)
         {
-            AFileWrite(&animation.samplers[j].count, sizeof(int), file, 1);
-            AFileWrite(&animation.samplers[j].numComponent, sizeof(int), file, 1);
-            AFileWrite(&animation.samplers[j].interpolation, sizeof(float), file, 1);
+            // sampler outputs are converted to Vector4x32f at the end of the CreateVerticesIndicesSkined function
+            AAnimSampler* srcSampler = &srcAnimation->samplers[j];
+            uint64_t inputOffset  = ABMWriter_Push(&writer, srcSampler->input, sizeof(float) * srcSampler->count, 16);
+            uint64_t outputOffset = ABMWriter_Push(&writer, srcSampler->output, sizeof(Vector4x32f) * srcSampler->count, 16);
+            AAnimSampler* sampler = ABM_AT(&writer, AAnimSampler, samplersOffset) + j;
+            sampler->input  = (float*)inputOffset;
+            sampler->output = (float*)outputOffset;
         }
+        
+        AAnimation* animation = ABM_AT(&writer, AAnimation, animationsOffset) + i;
+        animation->name     = (char*)nameOffset;
+        animation->channels = (AAnimChannel*)channelsOffset;
+        animation->samplers = (AAnimSampler*)samplersOffset;
     }
+    bundle.animations = (AAnimation*)animationsOffset;
+    
+    // Compress and write, vertices and indices
+    uint64_t allVertexSize = dstVertexSize * (uint64_t)gltf->totalVertices;
+    const void* allVertices = convertVertices ? convertedVertices : gltf->allVertices;
+    
+    ABMHeader header;
+    MemsetZero(&header, sizeof(ABMHeader));
+    header.isSkined     = isSkined;
+    header.vertexStream = ABMWriter_PushFrames(&writer, allVertices, allVertexSize);
+    header.indexStream  = ABMWriter_PushFrames(&writer, packedIndices, packedIndexSize);
+    header.bundle       = bundle;
+    SmallMemCpy(writer.data + headerOffset, &header, sizeof(ABMHeader));
+    rpfree(meshletIndices);
+    rpfree(packedIndices);
+    if (lodIndices) rpfree(lodIndices);
+    if (convertedVertices) rpfree(convertedVertices);
+    
+    int version = ABMMeshVersion;
+    uint64_t magic = 0xABFABF;
+    SmallMemCpy(writer.data, &version, sizeof(int));
+    SmallMemCpy(writer.data + sizeof(int), &magic, sizeof(uint64_t));
     
+    AFile file = AFileOpen(path, AOpenFlag_WriteBinary);
+    if (!AFileExist(file))
+    {
+        rpfree(writer.data);
+        AX_ERROR("abm save failed %s", path);
+        return 0;
+    }
+    AFileWrite(writer.data, writer.size, file, 1);
     AFileClose(file);
+    rpfree(writer.data);
 #endif
     return 1;
 }
@@ -919,7 +1367,8 @@ void ReadGLTFString(char** str, AFile file, FixedPow2Allocator* stringAllocator)
     }
 }
 
-int LoadSceneBundleBinary(const char* path, SceneBundle* gltf)
+// reads old abm files (ABMStreamVersion) field by field
+static int LoadSceneBundleStream(const char* path, SceneBundle* gltf)
 {
     AFile file = AFileOpen(path, AOpenFlag_ReadBinary);
     if (!AFileExist(file))
@@ -931,9 +1380,9 @@ int LoadSceneBundleBinary(const char* path, SceneBundle* gltf)
     FixedPow2Allocator* allocator = rpmalloc(sizeof(FixedPow2Allocator));
     FixedPow2Allocator_Init(allocator, 1024);
 
-    int version = ABMMeshVersion;
+    int version = ABMStreamVersion;
     AFileRead(&version, sizeof(int), file, 1);
-    ASSERT(version == ABMMeshVersion);
+    ASSERT(version == ABMStreamVersion);
     
     uint64_t reserved[4];
     AFileRead(&reserved, sizeof(uint64_t) * 4, file, 1);
@@ -965,6 +1414,7 @@ int LoadSceneBundleBinary(const char* path, SceneBundle* gltf)
         
         gltf->allVertices = AllocAligned(vertexSize * gltf->totalVertices, vertexAlignment); // divide / 4 to get number of floats
         gltf->allIndices = AllocAligned(allIndexSize, 4);
+        gltf->allIndicesSize = allIndexSize;
         
         char* compressedBuffer = rpmalloc(allVertexSize);
         uint64_t compressedSize;
@@ -996,6 +1446,7 @@ int LoadSceneBundleBinary(const char* path, SceneBundle* gltf)
         for (int j = 0; j < mesh->numPrimitives; j++)
         {
             APrimitive* primitive = &mesh->primitives[j];
+            MemsetZero(primitive, sizeof(APrimitive));
             AFileRead(&primitive->attributes , sizeof(int), file, 1);
             AFileRead(&primitive->indexType  , sizeof(int), file, 1);
             AFileRead(&primitive->numIndices , sizeof(int), file, 1);
@@ -1167,6 +1618,344 @@ int LoadSceneBundleBinary(const char* path, SceneBundle* gltf)
     }
 
     AFileClose(file);
+    gltf->nodeOrder   = FixedPow2Allocator_AllocateUninitialized(allocator, sizeof(int) * (gltf->numNodes + 1));
+    gltf->nodeParents = FixedPow2Allocator_AllocateUninitialized(allocator, sizeof(int) * (gltf->numNodes + 1));
     gltf->allocator = allocator;
+    gltf->mappedFile = NULL;
+    if (!BuildNodeHierarchy(gltf->nodes, gltf->numNodes, gltf->nodeOrder, gltf->nodeParents))
+    {
+        AX_ERROR("abm node hierarchy is malformed %s", path);
+        FreeSceneBundle(gltf); // fully loaded at this point, callers don't free the failed loads
+        return 0;
+    }
     return 1;
-}
\ No newline at end of file
+}
+
+// converts offset to pointer, fails if the array [offset, offset + count * elementSize) is outside of the file.
+// zero offset is null, only valid for empty arrays
+static inline bool ABMFixup(void** ptr, char* base, uint64_t fileSize, int64_t count, uint64_t elementSize)
+{
+    uint64_t offset = (uint64_t)*ptr;
+    if (count < 0) return false;
+    if (offset == 0) return count == 0;
+    uint64_t size = (uint64_t)count * elementSize;
+    if (offset > fileSize || size > fileSize - offset) return false;
+    *ptr = base + offset;
+    return true;
+}
+
+// strings are optional, they have to be null terminated inside of the file
+static inline bool ABMFixupString(char** str, char* base, uint64_t fileSize)
+{
+    uint64_t offset = (uint64_t)*str;
+    if (offset == 0) return true;
+    if (offset >= fileSize || memchr(base + offset, 0, fileSize - offset) == NULL) return false;
+    *str = base + offset;
+    return true;
+}
+
+#define ABM_FIXUP(ptr, count, base, fileSize) if (!ABMFixup((void**)&(ptr), base, fileSize, count, sizeof(*(ptr)))) return 0
+#define ABM_FIXUP_STRING(str, base, fileSize) if (!ABMFixupString(&(str), base, fileSize)) return 0
+
+typedef struct ABMDecodeJob_
+{
+    const char* src;
+    char*       dst;
+    uint64_t    srcSize;
+    uint64_t    dstSize;
+    int         failed; // set if the frame is corrupted, checked after all of the frames are decoded
+} ABMDecodeJob;
+
+// each batch decodes a range of frames with it's own decompression context
+static void ABMDecodeFrames(void* data, int begin, int end)
+{
+    ABMDecodeJob* jobs = (ABMDecodeJob*)data;
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    
+    for (int i = begin; i < end; i++)
+    {
+        ABMDecodeJob* job = &jobs[i];
+        size_t result = ZSTD_decompressDCtx(dctx, job->dst, job->dstSize, job->src, job->srcSize);
+        job->failed = ZSTD_isError(result) || result != job->dstSize;
+    }
+    ZSTD_freeDCtx(dctx);
+}
+
+static int ABMPushDecodeJobs(ABMDecodeJob* jobs, char* base, ABMStream stream, char* dst)
+{
+    ABMFrame* frames = (ABMFrame*)(base + stream.framesOffset);
+    for (int i = 0; i < stream.numFrames; i++)
+    {
+        uint64_t frameBegin = (uint64_t)i * ABM_FRAME_SIZE;
+        jobs[i].src     = base + frames[i].offset;
+        jobs[i].srcSize = frames[i].size;
+        jobs[i].dst     = dst + frameBegin;
+        jobs[i].dstSize = MMIN(stream.size - frameBegin, (uint64_t)ABM_FRAME_SIZE);
+        jobs[i].failed  = 0;
+    }
+    return stream.numFrames;
+}
+
+// decodes vertex and index frames across the job system, calling thread also decodes.
+// returns 0 if any of the frames is corrupted
+static int ABMDecodeStreams(char* base, ABMHeader* header, void* vertices, void* indices)
+{
+    int numJobs = header->vertexStream.numFrames + header->indexStream.numFrames;
+    ABMDecodeJob* jobs = rpmalloc(sizeof(ABMDecodeJob) * MMAX(numJobs, 1));
+    int numPushed = 0;
+    numPushed += ABMPushDecodeJobs(jobs + numPushed, base, header->vertexStream, (char*)vertices);
+    numPushed += ABMPushDecodeJobs(jobs + numPushed, base, header->indexStream, (char*)indices);
+    
+    JobSystem_ParallelFor(numPushed, 0, ABMDecodeFrames, jobs);
+    
+    int failed = 0;
+    for (int i = 0; i < numPushed; i++)
+        failed |= jobs[i].failed;
+    
+    rpfree(jobs);
+    return !failed;
+}
+
+// frame table and compressed frames has to be inside of the file, and frames has to cover the decompressed size
+static bool ABMStreamValid(const ABMStream* stream, const char* base, uint64_t fileSize)
+{
+    if (stream->numFrames < 0 || (uint64_t)stream->numFrames != (stream->size + ABM_FRAME_SIZE - 1) / ABM_FRAME_SIZE)
+        return false;
+    
+    void* frames = (void*)stream->framesOffset;
+    if (!ABMFixup(&frames, (char*)base, fileSize, stream->numFrames, sizeof(ABMFrame)))
+        return false;
+    
+    for (int i = 0; i < stream->numFrames; i++)
+    {
+        ABMFrame frame = ((ABMFrame*)frames)[i];
+        if (frame.offset > fileSize || frame.size > fileSize - frame.offset)
+            return false;
+    }
+    return true;
+}
+
+// index range of the primitive or lod has to be inside of the decompressed index stream
+static bool ABMIndexRangeValid(const APrimitive* primitive, int64_t indexOffset, int64_t numIndices, uint64_t indexStreamSize)
+{
+    uint64_t indexSize = GraphicsTypeToSize(primitive->indexType);
+    return indexOffset >= 0 && numIndices >= 0 && (uint64_t)(indexOffset + numIndices) * indexSize <= indexStreamSize;
+}
+
+// index has to point inside of the array, optional indices can also be -1
+static bool ABMIndexValid(int index, int count, bool optional)
+{
+    return (unsigned)index < (unsigned)count || (optional && index == -1);
+}
+
+// nodeOrder and nodeParents are used without bounds checks at runtime,
+// rebuilding the hierarchy also checks the children of each node
+static bool ABMNodeHierarchyValid(const SceneBundle* gltf)
+{
+    if (gltf->numNodes == 0)
+        return true;
+    
+    int* order   = rpmalloc(sizeof(int) * gltf->numNodes);
+    int* parents = rpmalloc(sizeof(int) * gltf->numNodes);
+    bool valid = BuildNodeHierarchy(gltf->nodes, gltf->numNodes, order, parents)
+              && memcmp(order, gltf->nodeOrder, sizeof(int) * gltf->numNodes) == 0
+              && memcmp(parents, gltf->nodeParents, sizeof(int) * gltf->numNodes) == 0;
+    rpfree(order);
+    rpfree(parents);
+    return valid;
+}
+
+// uses metadata inside of the mapped file in place, only converts offsets to pointers.
+// every offset and size is checked against the file size before it is used, so truncated or corrupted files fails to load.
+// index values are range checked too. vertices and indices are the only allocations that we keep
+static int LoadSceneBundleMapped(AMappedFile mapped, SceneBundle* gltf)
+{
+    char* base = mapped.data;
+    uint64_t fileSize = mapped.size;
+    ABMHeader* header = (ABMHeader*)(base + ABM_PREFIX_SIZE);
+    *gltf = header->bundle;
+    
+    if (!ABMStreamValid(&header->vertexStream, base, fileSize) || !ABMStreamValid(&header->indexStream, base, fileSize))
+        return 0;
+    
+    size_t vertexSize = SceneBundleVertexSize(gltf);
+    if (gltf->totalVertices < 0 || header->vertexStream.size != (uint64_t)gltf->totalVertices * vertexSize)
+        return 0;
+    
+    ABM_FIXUP(gltf->meshes, gltf->numMeshes, base, fileSize);
+    ABM_FIXUP(gltf->nodes, gltf->numNodes, base, fileSize);
+    ABM_FIXUP(gltf->nodeOrder, gltf->numNodes, base, fileSize);
+    ABM_FIXUP(gltf->nodeParents, gltf->numNodes, base, fileSize);
+    ABM_FIXUP(gltf->materials, gltf->numMaterials, base, fileSize);
+    ABM_FIXUP(gltf->textures, gltf->numTextures, base, fileSize);
+    ABM_FIXUP(gltf->images, gltf->numImages, base, fileSize);
+    ABM_FIXUP(gltf->samplers, gltf->numSamplers, base, fileSize);
+    ABM_FIXUP(gltf->cameras, gltf->numCameras, base, fileSize);
+    ABM_FIXUP(gltf->scenes, gltf->numScenes, base, fileSize);
+    ABM_FIXUP(gltf->skins, gltf->numSkins, base, fileSize);
+    ABM_FIXUP(gltf->animations, gltf->numAnimations, base, fileSize);
+    
+    uint64_t vertexCursor = 0;
+    for (int i = 0; i < gltf->numMeshes; i++)
+    {
+        AMesh* mesh = &gltf->meshes[i];
+        ABM_FIXUP_STRING(mesh->name, base, fileSize);
+        ABM_FIXUP(mesh->primitives, mesh->numPrimitives, base, fileSize);
+        
+        for (int j = 0; j < mesh->numPrimitives; j++)
+        {
+            APrimitive* primitive = &mesh->primitives[j];
+            ABM_FIXUP(primitive->meshlets, primitive->numMeshlets, base, fileSize);
+            
+            if (primitive->indexType != GraphicType_UnsignedShort && primitive->indexType != GraphicType_UnsignedInt)
+                return 0;
+            if (!ABMIndexRangeValid(primitive, primitive->indexOffset, primitive->numIndices, header->indexStream.size))
+                return 0;
+            
+            if (primitive->numLods < 0 || primitive->numLods > AX_MAX_LODS)
+                return 0;
+            for (int l = 0; l < primitive->numLods; l++)
+                if (!ABMIndexRangeValid(primitive, primitive->lods[l].indexOffset, primitive->lods[l].numIndices, header->indexStream.size))
+                    return 0;
+            
+            for (int m = 0; m < primitive->numMeshlets; m++)
+            {
+                const AMeshlet* meshlet = &primitive->meshlets[m];
+                if (meshlet->indexOffset < 0 || meshlet->numIndices < 0 || meshlet->indexOffset + (int64_t)meshlet->numIndices > primitive->numIndices)
+                    return 0;
+            }
+            
+            if (primitive->numVertices < 0)
+                return 0;
+            vertexCursor += (uint64_t)primitive->numVertices * vertexSize;
+            if (vertexCursor > header->vertexStream.size)
+                return 0;
+        }
+    }
+    
+    for (int i = 0; i < gltf->numNodes; i++)
+    {
+        ANode* node = &gltf->nodes[i];
+        ABM_FIXUP_STRING(node->name, base, fileSize);
+        ABM_FIXUP(node->children, node->numChildren, base, fileSize);
+        
+        if (node->type == 0 && !ABMIndexValid(node->index, gltf->numMeshes, true))  return 0;
+        if (node->type == 1 && !ABMIndexValid(node->index, gltf->numCameras, true)) return 0;
+    }
+    
+    if (!ABMNodeHierarchyValid(gltf))
+        return 0;
+    
+    for (int i = 0; i < gltf->numMaterials; i++) ABM_FIXUP_STRING(gltf->materials[i].name, base, fileSize);
+    for (int i = 0; i < gltf->numTextures; i++)  ABM_FIXUP_STRING(gltf->textures[i].name, base, fileSize);
+    for (int i = 0; i < gltf->numImages; i++)    ABM_FIXUP_STRING(gltf->images[i].path, base, fileSize);
+    for (int i = 0; i < gltf->numCameras; i++)   ABM_FIXUP_STRING(gltf->cameras[i].name, base, fileSize);
+    
+    for (int i = 0; i < gltf->numScenes; i++)
+    {
+        ABM_FIXUP_STRING(gltf->scenes[i].name, base, fileSize);
+        ABM_FIXUP(gltf->scenes[i].nodes, gltf->scenes[i].numNodes, base, fileSize);
+        for (int n = 0; n < gltf->scenes[i].numNodes; n++)
+            if (!ABMIndexValid(gltf->scenes[i].nodes[n], gltf->numNodes, false))
+                return 0;
+    }
+    
+    if (gltf->numScenes > 0 && gltf->defaultSceneIndex >= gltf->numScenes)
+        return 0;
+    
+    for (int i = 0; i < gltf->numSkins; i++)
+    {
+        ASkin* skin = &gltf->skins[i];
+        ABM_FIXUP_STRING(skin->name, base, fileSize);
+        if (!ABMFixup((void**)&skin->inverseBindMatrices, base, fileSize, skin->numJoints, sizeof(Matrix4))) return 0;
+        ABM_FIXUP(skin->joints, skin->numJoints, base, fileSize);
+        
+        if (!ABMIndexValid(skin->skeleton, gltf->numNodes, true))
+            return 0;
+        for (int j = 0; j < skin->numJoints; j++)
+            if (!ABMIndexValid(skin->joints[j], gltf->numNodes, false))
+                return 0;
+    }
+    
+    for (int i = 0; i < gltf->numAnimations; i++)
+    {
+        AAnimation* animation = &gltf->animations[i];
+        ABM_FIXUP_STRING(animation->name, base, fileSize);
+        ABM_FIXUP(animation->channels, animation->numChannels, base, fileSize);
+        ABM_FIXUP(animation->samplers, animation->numSamplers, base, fileSize);
+        
+        for (int j = 0; j < animation->numSamplers; j++)
+        {
+            AAnimSampler* sampler = &animation->samplers[j];
+            ABM_FIXUP(sampler->input, sampler->count, base, fileSize);
+            if (!ABMFixup((void**)&sampler->output, base, fileSize, sampler->count, sizeof(Vector4x32f))) return 0;
+            if (sampler->count <= 0) return 0; // sampling reads the first and last keys
+        }
+        
+        for (int j = 0; j < animation->numChannels; j++)
+        {
+            const AAnimChannel* channel = &animation->channels[j];
+            if (!ABMIndexValid(channel->sampler, animation->numSamplers, false) || 
+                !ABMIndexValid(channel->targetNode, gltf->numNodes, false))
+                return 0;
+        }
+    }
+    
+    gltf->allVertices = AllocAligned(header->vertexStream.size, 4);
+    gltf->allIndices  = AllocAligned(header->indexStream.size, 4);
+    gltf->allIndicesSize = header->indexStream.size;
+    if (!ABMDecodeStreams(base, header, gltf->allVertices, gltf->allIndices))
+    {
+        FreeAligned(gltf->allVertices);
+        FreeAligned(gltf->allIndices);
+        gltf->allVertices = gltf->allIndices = NULL;
+        return 0;
+    }
+    
+    char* currVertices = (char*)gltf->allVertices;
+    for (int i = 0; i < gltf->numMeshes; i++)
+    {
+        AMesh* mesh = &gltf->meshes[i];
+        for (int j = 0; j < mesh->numPrimitives; j++)
+        {
+            APrimitive* primitive = &mesh->primitives[j];
+            primitive->indices  = (char*)gltf->allIndices + (uint64_t)primitive->indexOffset * GraphicsTypeToSize(primitive->indexType);
+            primitive->vertices = currVertices;
+            currVertices += (uint64_t)primitive->numVertices * vertexSize;
+        }
+    }
+    
+    gltf->mappedFile = rpmalloc(sizeof(AMappedFile));
+    SmallMemCpy(gltf->mappedFile, &mapped, sizeof(AMappedFile));
+    return 1;
+}
+
+int LoadSceneBundleBinary(const char* path, SceneBundle* gltf)
+{
+    AMappedFile mapped = AFileMap(path);
+    if (mapped.data == NULL)
+    {
+        AX_ERROR("Failed to open abm file %s", path);
+        return 0;
+    }
+    
+    int version = 0;
+    SmallMemCpy(&version, mapped.data, sizeof(int));
+    
+    if (version == ABMMeshVersion && mapped.size >= ABM_PREFIX_SIZE + sizeof(ABMHeader))
+    {
+        if (LoadSceneBundleMapped(mapped, gltf))
+            return 1;
+        AFileUnmap(&mapped);
+        AX_ERROR("abm file is corrupted or truncated %s", path);
+        return 0;
+    }
+    
+    AFileUnmap(&mapped);
+    
+    if (version == ABMStreamVersion)
+        return LoadSceneBundleStream(path, gltf);
+    
+    AX_ERROR("abm version mismatch %s version: %i", path, version);
+    return 0;
+}
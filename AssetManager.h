@@ -16,7 +16,18 @@
 
 int LoadFBX(const char* path, SceneBundle* fbxScene, float scale);
 
-int SaveGLTFBinary(SceneBundle* gltf, const char* path);
+typedef enum ABMSaveFlag_
+{
+    ABMSaveFlag_None               = 0,
+    ABMSaveFlag_QuantizePositions  = 1 << 0, // 16 bit positions relative to primitive AABB, smaller vertices
+    ABMSaveFlag_OctahedralTangents = 1 << 1, // normal and tangent packed into 4 bytes instead of 8
+    ABMSaveFlag_GenerateLods       = 1 << 2, // simplified index buffers for each primitive, APrimitive::lods
+    ABMSaveFlag_OptimizeMeshes     = 1 << 3, // OptimizeMeshes before saving, meshlets keeps that order but they are less compact
+} ABMSaveFlag;
+
+// with ABMSaveFlag_OptimizeMeshes, vertices and indices of gltf are reordered in place by OptimizeMeshes.
+// the bundle stays valid and renders the same, but its index and vertex order changes
+int SaveGLTFBinary(SceneBundle* gltf, const char* path, int saveFlags);
 
 int LoadSceneBundleBinary(const char* path, SceneBundle* gltf);
 
@@ -24,6 +35,12 @@ void CreateVerticesIndices(SceneBundle* gltf);
 
 void CreateVerticesIndicesSkined(SceneBundle* gltf);
 
+// reorders triangles and vertices for vertex cache, overdraw and vertex fetch. logs ACMR before and after
+void OptimizeMeshes(SceneBundle* gltf);
+
+// size of the vertices inside of the allVertices, depends on skinning, position quantization and octahedral tangents
+int SceneBundleVertexSize(const SceneBundle* bundle);
+
 // ABM = AX binary mesh
 bool IsABMLastVersion(const char* path);
 
@@ -0,0 +1,249 @@
+/********************************************************************************
+*    Purpose: Streams SceneBundles and their textures in the background,        *
+*             worker threads reads and decompresses the files,                  *
+*             main thread creates the buffers and images within a time budget   *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#include "AssetStream.h"
+#include "AssetManager.h"
+#include "Thread.h"
+#include "Common.h"
+
+typedef struct AssetStream_
+{
+    AThread threads[AX_MAX_THREADS];
+    int numThreads;
+    
+    // ring buffer of requests, accessed by main thread and workers
+    AMutex mutex;
+    ASemaphore semaphore; // number of requests in the queue
+    StreamedScene* requests[AX_STREAM_MAX_REQUESTS];
+    uint32_t head, tail;
+
+    // scenes that are waiting for gpu upload, only accessed by main thread
+    StreamedScene* pending[AX_STREAM_MAX_REQUESTS];
+    int numPending;
+} AssetStream;
+
+static AssetStream g_AssetStream = { 0 };
+
+static void AssetStream_PushRequest(StreamedScene* scene)
+{
+    AMutex_Lock(&g_AssetStream.mutex);
+    ASSERT(g_AssetStream.tail - g_AssetStream.head < AX_STREAM_MAX_REQUESTS); // too many requests
+    g_AssetStream.requests[g_AssetStream.tail++ & (AX_STREAM_MAX_REQUESTS - 1)] = scene;
+    AMutex_Unlock(&g_AssetStream.mutex);
+    ASemaphore_Post(&g_AssetStream.semaphore);
+}
+
+static void AssetStream_LoadScene(StreamedScene* scene)
+{
+    AssetStreamState state = AssetStreamState_Uploading;
+
+    if (!LoadSceneBundleBinary(scene->abmPath, &scene->bundle))
+    {
+        AX_ERROR("streaming scene failed! %s", scene->abmPath);
+        state = AssetStreamState_Failed;
+    }
+    else if (scene->texturePath[0] != '\0' && 
+             !rLoadSceneImagesCPU(scene->texturePath, scene->bundle.numImages, &scene->images))
+    {
+        AX_ERROR("streaming scene images failed! %s", scene->texturePath);
+        FreeSceneBundle(&scene->bundle);
+        state = AssetStreamState_Failed;
+    }
+    // release: main thread sees the loaded bundle after it sees the state
+    c89atomic_store_explicit_32(&scene->state, state, c89atomic_memory_order_release);
+}
+
+static void AssetStream_Worker(void* data)
+{
+    (void)data;
+    while (true)
+    {
+        ASemaphore_Wait(&g_AssetStream.semaphore);
+        AMutex_Lock(&g_AssetStream.mutex);
+        StreamedScene* scene = g_AssetStream.requests[g_AssetStream.head++ & (AX_STREAM_MAX_REQUESTS - 1)];
+        AMutex_Unlock(&g_AssetStream.mutex);
+
+        if (scene == NULL) // exit signal
+            break;
+        
+        AssetStream_LoadScene(scene);
+    }
+}
+
+void AssetStream_Init(int numThreads)
+{
+    numThreads = MMAX(MMIN(numThreads, AX_MAX_THREADS), 1);
+    g_AssetStream.numThreads = numThreads;
+    g_AssetStream.head = g_AssetStream.tail = 0;
+    g_AssetStream.numPending = 0;
+    AMutex_Init(&g_AssetStream.mutex);
+    ASemaphore_Init(&g_AssetStream.semaphore, 0);
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        g_AssetStream.threads[i] = AThread_Create(AssetStream_Worker, NULL);
+    }
+}
+
+void AssetStream_Destroy(void)
+{
+    for (int i = 0; i < g_AssetStream.numThreads; i++)
+    {
+        AssetStream_PushRequest(NULL);
+    }
+
+    for (int i = 0; i < g_AssetStream.numThreads; i++)
+    {
+        AThread_Join(g_AssetStream.threads[i]);
+    }
+
+    AMutex_Destroy(&g_AssetStream.mutex);
+    ASemaphore_Destroy(&g_AssetStream.semaphore);
+    g_AssetStream.numThreads = 0;
+}
+
+StreamedScene* AssetStream_RequestScene(const char* abmPath, const char* texturePath)
+{
+    ASSERT(g_AssetStream.numThreads > 0); // AssetStream_Init is not called
+    ASSERT(g_AssetStream.numPending < AX_STREAM_MAX_REQUESTS);
+
+    StreamedScene* scene = rpcalloc(1, sizeof(StreamedScene));
+    scene->state = AssetStreamState_Queued;
+
+    int abmLen = StringLength(abmPath);
+    ASSERT(abmLen < AX_STREAM_PATH_LEN);
+    SmallMemCpy(scene->abmPath, abmPath, abmLen);
+
+    if (texturePath != NULL)
+    {
+        int textureLen = StringLength(texturePath);
+        ASSERT(textureLen < AX_STREAM_PATH_LEN);
+        SmallMemCpy(scene->texturePath, texturePath, textureLen);
+    }
+
+    g_AssetStream.pending[g_AssetStream.numPending++] = scene;
+    AssetStream_PushRequest(scene);
+    return scene;
+}
+
+// returns true if all of the uploads are done
+static bool AssetStream_UploadStep(StreamedScene* scene)
+{
+    SceneBundle* bundle = &scene->bundle;
+    int step = scene->uploadStep++;
+
+    if (step == 0)
+    {
+        uint64_t vertexSize = SceneBundleVertexSize(bundle);
+        if (bundle->totalVertices > 0)
+        {
+            scene->vertexBuffer = sg_make_buffer(&(sg_buffer_desc){
+                .data = (sg_range){ bundle->allVertices, bundle->totalVertices * vertexSize },
+                .label = "streamed-vertices"
+            });
+        }
+    }
+    else if (step == 1)
+    {
+        if (bundle->allIndicesSize > 0)
+        {
+            scene->indexBuffer = sg_make_buffer(&(sg_buffer_desc){
+                .usage.index_buffer = true,
+                .data = (sg_range){ bundle->allIndices, bundle->allIndicesSize },
+                .label = "streamed-indices"
+            });
+        }
+        
+        scene->numTextures = scene->images.numImages;
+        if (scene->numTextures > 0)
+            scene->textures = rpcalloc(scene->numTextures, sizeof(Texture));
+    }
+    else 
+    {
+        int imageIndex = step - 2;
+        if (imageIndex < scene->images.numImages)
+            scene->textures[imageIndex] = rUploadSceneImage(&scene->images, imageIndex);
+    }
+    return scene->uploadStep >= 2 + scene->images.numImages;
+}
+
+void AssetStream_Update(double budgetSeconds)
+{
+    uint64_t startTime = stm_now();
+    int numUploads = 0;
+
+    for (int i = 0; i < g_AssetStream.numPending; i++)
+    {
+        StreamedScene* scene = g_AssetStream.pending[i];
+        uint32_t state = c89atomic_load_explicit_32(&scene->state, c89atomic_memory_order_acquire);
+
+        if (state == AssetStreamState_Queued)
+            continue;
+
+        bool finished = state == AssetStreamState_Failed;
+        while (!finished)
+        {
+            if (numUploads > 0 && stm_sec(stm_since(startTime)) > budgetSeconds)
+                return;
+            
+            finished = AssetStream_UploadStep(scene);
+            numUploads++;
+        }
+
+        if (state == AssetStreamState_Uploading)
+        {
+            rFreeSceneImages(&scene->images);
+            c89atomic_store_explicit_32(&scene->state, AssetStreamState_Ready, c89atomic_memory_order_release);
+        }
+        // remove from pending list, order is preserved so older requests are uploaded first
+        for (int j = i + 1; j < g_AssetStream.numPending; j++)
+            g_AssetStream.pending[j - 1] = g_AssetStream.pending[j];
+        g_AssetStream.numPending--;
+        i--;
+    }
+}
+
+bool AssetStream_IsReady(StreamedScene* scene)
+{
+    return c89atomic_load_explicit_32(&scene->state, c89atomic_memory_order_acquire) == AssetStreamState_Ready;
+}
+
+bool AssetStream_IsFailed(StreamedScene* scene)
+{
+    return c89atomic_load_explicit_32(&scene->state, c89atomic_memory_order_acquire) == AssetStreamState_Failed;
+}
+
+void AssetStream_FreeScene(StreamedScene* scene)
+{
+    // call AssetStream_Destroy first if the scene might be still in the queue
+    uint32_t state = c89atomic_load_explicit_32(&scene->state, c89atomic_memory_order_acquire);
+    ASSERT(state != AssetStreamState_Queued); // still in use by a worker thread
+
+    for (int i = 0; i < g_AssetStream.numPending; i++)
+    {
+        if (g_AssetStream.pending[i] != scene) continue;
+        g_AssetStream.pending[i] = g_AssetStream.pending[--g_AssetStream.numPending];
+        break;
+    }
+
+    if (state != AssetStreamState_Failed)
+    {
+        // scene might be partially uploaded
+        if (scene->vertexBuffer.id != 0) sg_destroy_buffer(scene->vertexBuffer);
+        if (scene->indexBuffer.id  != 0) sg_destroy_buffer(scene->indexBuffer);
+
+        for (int i = 0; i < scene->numTextures; i++)
+        {
+            if (scene->textures[i].handle.id != 0)
+                rDeleteTexture(scene->textures[i]);
+        }
+        if (scene->textures) rpfree(scene->textures);
+        rFreeSceneImages(&scene->images);
+        FreeSceneBundle(&scene->bundle);
+    }
+    rpfree(scene);
+}
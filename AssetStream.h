@@ -0,0 +1,61 @@
+/********************************************************************************
+*    Purpose: Streams SceneBundles and their textures in the background,        *
+*             uploads the gpu resources from main thread within a time budget   *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#pragma once
+
+// void           AssetStream_Init(numThreads);
+// void           AssetStream_Destroy();
+// StreamedScene* AssetStream_RequestScene(abmPath, texturePath); // texturePath can be null
+// void           AssetStream_Update(budgetSeconds); // call once per frame from main thread
+// bool           AssetStream_IsReady(scene);
+// void           AssetStream_FreeScene(scene);
+
+#include "GLTFParser.h"
+#include "Graphics.h"
+#include "Extern/c89atomic.h"
+
+#define AX_STREAM_MAX_REQUESTS 64 // must be power of two
+#define AX_STREAM_PATH_LEN 256
+
+typedef enum AssetStreamState_
+{
+    AssetStreamState_Queued,    // waiting for a worker thread
+    AssetStreamState_Uploading, // file read and decompression done, waiting for gpu uploads
+    AssetStreamState_Ready,     // all of the gpu resources are created
+    AssetStreamState_Failed
+} AssetStreamState;
+
+typedef struct StreamedScene_
+{
+    SceneBundle bundle;
+    SceneImages images;   // cpu side of the textures, freed after upload
+    Texture*  textures;   // numTextures, element handles are zero until uploaded
+    int numTextures;
+    sg_buffer vertexBuffer;
+    sg_buffer indexBuffer;
+    int uploadStep;       // 0 vertices, 1 indices, 2 + n images
+    volatile c89atomic_uint32 state; // AssetStreamState, written by worker threads
+    char abmPath[AX_STREAM_PATH_LEN];
+    char texturePath[AX_STREAM_PATH_LEN];
+} StreamedScene;
+
+void AssetStream_Init(int numThreads);
+
+// waits for the worker threads to finish remaining requests
+void AssetStream_Destroy(void);
+
+// returned scene is owned by the caller, free it with AssetStream_FreeScene after it is ready or failed
+StreamedScene* AssetStream_RequestScene(const char* abmPath, const char* texturePath);
+
+// creates the buffers and textures of loaded scenes, stops when budgetSeconds exceeded
+// at least one upload is done each frame so streaming never stalls
+void AssetStream_Update(double budgetSeconds);
+
+bool AssetStream_IsReady(StreamedScene* scene);
+
+bool AssetStream_IsFailed(StreamedScene* scene);
+
+void AssetStream_FreeScene(StreamedScene* scene);
@@ -228,7 +228,7 @@ static inline bool Bitset_Get(Bitset* bitset, int idx) {
 static inline void Bitset_Reset(Bitset* bitset, int idx) {
     int arrIndex = idx / 64;
     int bitIndex = idx & 63;
-    bitset->bits[arrIndex] &= ~(1ul << bitIndex);
+    bitset->bits[arrIndex] &= ~(1ull << bitIndex);
 }
    
 static inline void Bitset_Flip(Bitset* bitset) {
@@ -46,22 +46,201 @@ typedef struct GLTFBufferView_
     int byteStride;
 } GLTFBufferView;
 
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                   Structural Index (simdjson style)                      */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+// before parsing we classify the whole text 64 bytes at a time,
+// one bit for each byte, set for quotes and the braces/brackets that are outside of strings.
+// skipping whitespace, numbers and string contents becomes a few tzcnt instructions
+// https://arxiv.org/abs/1902.08318 Parsing Gigabytes of JSON per Second
+typedef struct GLTFStructuralIndex_
+{
+    const char* source;
+    const char* end;  // null terminator of the source
+    uint64_t*   bits;
+    uint64_t    numWords;
+} GLTFStructuralIndex;
+
+static AX_THREAD_LOCAL GLTFStructuralIndex g_StructuralIndex = { 0 };
+
+#if defined(AX_SUPPORT_NEON)
+__private uint64_t NeonMovemask64(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3)
+{
+    const uint8x16_t bitMask = { 0x01, 0x02, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80 };
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, bitMask), vandq_u8(m1, bitMask));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, bitMask), vandq_u8(m3, bitMask));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+#endif
+
+// finds quotes, backslashes and brackets {}[] in 64 bytes
+__private void ClassifyBlock64(const char* src, uint64_t* quotes, uint64_t* backslashes, uint64_t* brackets)
+{
+#if defined(AX_SUPPORT_AVX2)
+    __m256i lo = _mm256_loadu_si256((const __m256i*)src);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(src + 32));
+    #define AX_MASK64(lo_, hi_) ((uint64_t)(uint32_t)_mm256_movemask_epi8(lo_) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(hi_) << 32))
+    #define AX_EQ(v, c) _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c))
+    
+    *quotes      = AX_MASK64(AX_EQ(lo, '"'), AX_EQ(hi, '"'));
+    *backslashes = AX_MASK64(AX_EQ(lo, '\\'), AX_EQ(hi, '\\'));
+    __m256i bracketLo = _mm256_or_si256(_mm256_or_si256(AX_EQ(lo, '{'), AX_EQ(lo, '}')), _mm256_or_si256(AX_EQ(lo, '['), AX_EQ(lo, ']')));
+    __m256i bracketHi = _mm256_or_si256(_mm256_or_si256(AX_EQ(hi, '{'), AX_EQ(hi, '}')), _mm256_or_si256(AX_EQ(hi, '['), AX_EQ(hi, ']')));
+    *brackets = AX_MASK64(bracketLo, bracketHi);
+    #undef AX_EQ
+    #undef AX_MASK64
+#elif defined(AX_SUPPORT_SSE)
+    __m128i v[4];
+    uint64_t q = 0ull, b = 0ull, s = 0ull;
+    for (int i = 0; i < 4; i++)
+    {
+        v[i] = _mm_loadu_si128((const __m128i*)(src + i * 16));
+        #define AX_EQ(c) _mm_cmpeq_epi8(v[i], _mm_set1_epi8(c))
+        __m128i bracket = _mm_or_si128(_mm_or_si128(AX_EQ('{'), AX_EQ('}')), _mm_or_si128(AX_EQ('['), AX_EQ(']')));
+        q |= (uint64_t)(uint32_t)_mm_movemask_epi8(AX_EQ('"'))  << (i * 16);
+        b |= (uint64_t)(uint32_t)_mm_movemask_epi8(AX_EQ('\\')) << (i * 16);
+        s |= (uint64_t)(uint32_t)_mm_movemask_epi8(bracket)     << (i * 16);
+        #undef AX_EQ
+    }
+    *quotes = q, *backslashes = b, *brackets = s;
+#elif defined(AX_SUPPORT_NEON)
+    uint8x16_t v0 = vld1q_u8((const uint8_t*)src), v1 = vld1q_u8((const uint8_t*)src + 16);
+    uint8x16_t v2 = vld1q_u8((const uint8_t*)src + 32), v3 = vld1q_u8((const uint8_t*)src + 48);
+    #define AX_EQ(v, c) vceqq_u8(v, vdupq_n_u8(c))
+    #define AX_BRACKET(v) vorrq_u8(vorrq_u8(AX_EQ(v, '{'), AX_EQ(v, '}')), vorrq_u8(AX_EQ(v, '['), AX_EQ(v, ']')))
+    *quotes      = NeonMovemask64(AX_EQ(v0, '"'), AX_EQ(v1, '"'), AX_EQ(v2, '"'), AX_EQ(v3, '"'));
+    *backslashes = NeonMovemask64(AX_EQ(v0, '\\'), AX_EQ(v1, '\\'), AX_EQ(v2, '\\'), AX_EQ(v3, '\\'));
+    *brackets    = NeonMovemask64(AX_BRACKET(v0), AX_BRACKET(v1), AX_BRACKET(v2), AX_BRACKET(v3));
+    #undef AX_BRACKET
+    #undef AX_EQ
+#else
+    uint64_t q = 0ull, b = 0ull, s = 0ull;
+    for (int i = 0; i < 64; i++)
+    {
+        char c = src[i];
+        q |= (uint64_t)(c == '"') << i;
+        b |= (uint64_t)(c == '\\') << i;
+        s |= (uint64_t)(c == '{' || c == '}' || c == '[' || c == ']') << i;
+    }
+    *quotes = q, *backslashes = b, *brackets = s;
+#endif
+}
+
+// returns the characters that are escaped by odd length backslash sequences, prevEscaped carries to next block
+__private uint64_t FindEscapedChars(uint64_t backslashes, uint64_t* prevEscaped)
+{
+    const uint64_t evenBits = 0x5555555555555555ull;
+    backslashes &= ~*prevEscaped;
+    uint64_t followsEscape = (backslashes << 1) | *prevEscaped;
+    uint64_t oddSequenceStarts = backslashes & ~evenBits & ~followsEscape;
+    uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslashes;
+    *prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts; // overflow
+    uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+    return (evenBits ^ invertMask) & followsEscape;
+}
+
+// each bit is xor of itself and all of the bits before it, gives us the bytes between quotes
+__private uint64_t PrefixXor(uint64_t x)
+{
+    x ^= x << 1;  x ^= x << 2;  x ^= x << 4;
+    x ^= x << 8;  x ^= x << 16; x ^= x << 32;
+    return x;
+}
+
+__private void BuildStructuralIndex(const char* source, uint64_t length)
+{
+    GLTFStructuralIndex* index = &g_StructuralIndex;
+    index->source   = source;
+    index->end      = source + length;
+    index->numWords = (length + 63) / 64;
+    index->bits     = rpmalloc(sizeof(uint64_t) * MMAX(index->numWords, 1));
+
+    uint64_t prevEscaped = 0ull, prevInString = 0ull;
+    
+    for (uint64_t i = 0; i < index->numWords; i++)
+    {
+        const char* block = source + (i * 64);
+        char lastBlock[64];
+        
+        if (length - (i * 64) < 64) // don't read after the text
+        {
+            MemsetZero(lastBlock, sizeof(lastBlock));
+            SmallMemCpy(lastBlock, block, length - (i * 64));
+            block = lastBlock;
+        }
+
+        uint64_t quotes, backslashes, brackets;
+        ClassifyBlock64(block, &quotes, &backslashes, &brackets);
+
+        quotes &= ~FindEscapedChars(backslashes, &prevEscaped);
+        uint64_t inString = PrefixXor(quotes) ^ prevInString;
+        prevInString = (uint64_t)((int64_t)inString >> 63);
+        
+        index->bits[i] = quotes | (brackets & ~inString);
+    }
+}
+
+__private void FreeStructuralIndex()
+{
+    rpfree(g_StructuralIndex.bits);
+    MemsetZero(&g_StructuralIndex, sizeof(GLTFStructuralIndex));
+}
+
+// returns the first quote or brace/bracket at or after curr, null terminator if there is none
+__private const char* NextStructural(const char* curr)
+{
+    const GLTFStructuralIndex* index = &g_StructuralIndex;
+    uint64_t pos  = (uint64_t)(curr - index->source);
+    uint64_t word = pos >> 6;
+    if (word >= index->numWords) 
+        return index->end;
+
+    uint64_t bits = index->bits[word] & (~0ull << (pos & 63));
+    while (bits == 0ull)
+    {
+        if (++word >= index->numWords) 
+            return index->end;
+        bits = index->bits[word];
+    }
+    return index->source + (word << 6) + TrailingZeroCount64(bits);
+}
+
+purefn bool IsStructuralChar(char c)
+{
+    return c == '"' || c == '{' || c == '}' || c == '[' || c == ']';
+}
+
 inline const char* SkipUntill(const char* curr, char character)
 {
+    if (IsStructuralChar(character))
+    {
+        curr = NextStructural(curr);
+        while (*curr && *curr != character) 
+            curr = NextStructural(curr + 1);
+        return curr;
+    }
     AX_NO_UNROLL while (*curr != character) curr++;
     return curr;
 }
 
 inline const char* SkipAfter(const char* curr, char character)
 {
+    if (IsStructuralChar(character))
+    {
+        curr = SkipUntill(curr, character);
+        return curr + (*curr != '\0');
+    }
     AX_NO_UNROLL while (*curr++ != character);
     return curr;
 }
 
 __private const char* CopyStringInQuotes(char** str, const char** curr, FixedPow2Allocator* stringAllocator) //, AStringAllocator& stringAllocator)
 {
-    while (**curr != '"') *curr++; // find quote
-    *curr++; // skip "
+    while (**curr != '"') (*curr)++; // find quote
+    (*curr)++; // skip "
     // get length in quotes
     const char* quote = *curr;
     while (*quote != '"') quote++;
@@ -111,12 +290,15 @@ __private const char* SkipToNextNode(const char* curr, char open, char close)
 {
     int balance = 1;
     // skip to first open brackets
-    AX_NO_UNROLL while (*curr++ != open);
+    curr = SkipAfter(curr, open);
 
+    // only visit quotes and brackets, brackets inside of strings are not in the index
+    curr = NextStructural(curr);
     while (*curr && balance > 0)
     {
         balance += *curr == open;
         balance -= *curr++ == close;
+        if (balance > 0) curr = NextStructural(curr);
     }
     return curr;
 }
@@ -135,6 +317,7 @@ __private const char* ParseAccessors(const char* curr, GLTFAccessor** accessorAr
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}') // next accessor
@@ -146,15 +329,15 @@ __private const char* ParseAccessors(const char* curr, GLTFAccessor** accessorAr
 
             if (*curr == ']') // end all accessors
                 return ++curr;
-            curr++;
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '\0' && "parsing accessors failed probably you forget to close brackets!", return (const char*)AError_CloseBrackets);
         curr++;
-        if (StrCMP16(curr, "bufferView"))         accessor.bufferView = ParsePositiveNumber(&curr);
-        else if (StrCMP16(curr, "byteOffset"))    accessor.byteOffset = ParsePositiveNumber(&curr);
-        else if (StrCMP16(curr, "componentType")) accessor.componentType = ParsePositiveNumber(&curr) - 0x1400; // GL_BYTE 
-        else if (StrCMP16(curr, "count"))         accessor.count = ParsePositiveNumber(&curr);
-        else if (StrCMP16(curr, "name"))
+        if (StrPrefixCMP16(curr, "bufferView"))         accessor.bufferView = ParsePositiveNumber(&curr);
+        else if (StrPrefixCMP16(curr, "byteOffset"))    accessor.byteOffset = ParsePositiveNumber(&curr);
+        else if (StrPrefixCMP16(curr, "componentType")) accessor.componentType = ParsePositiveNumber(&curr) - 0x1400; // GL_BYTE 
+        else if (StrPrefixCMP16(curr, "count"))         accessor.count = ParsePositiveNumber(&curr);
+        else if (StrPrefixCMP16(curr, "name"))
         {
             curr += sizeof("name'"); // we don't need accessor's name
             int numQuotes = 0;
@@ -162,23 +345,23 @@ __private const char* ParseAccessors(const char* curr, GLTFAccessor** accessorAr
             while (numQuotes < 2)
                 numQuotes += *curr++ == '"';
         }
-        else if (StrCMP16(curr, "type"))
+        else if (StrPrefixCMP16(curr, "type"))
         {
             curr += sizeof("type'"); // skip type
             curr = SkipUntill(curr, '"');
             uint64_t hash;
             curr = HashStringInQuotes(&hash, curr);
             
-            if (hash == AHashString8("SCALAR"))    { accessor.type = 1; break; } 
-            else if (hash == AHashString8("VEC2")) { accessor.type = 2; break; } 
-            else if (hash == AHashString8("VEC3")) { accessor.type = 3; break; } 
-            else if (hash == AHashString8("VEC4")) { accessor.type = 4; break; } 
-            else if (hash == AHashString8("MAT4")) { accessor.type = 16; break; } 
+            if (hash == AHashString8("SCALAR"))    { accessor.type = 1; continue; } 
+            else if (hash == AHashString8("VEC2")) { accessor.type = 2; continue; } 
+            else if (hash == AHashString8("VEC3")) { accessor.type = 3; continue; } 
+            else if (hash == AHashString8("VEC4")) { accessor.type = 4; continue; } 
+            else if (hash == AHashString8("MAT4")) { accessor.type = 16; continue; } 
             else ASSERT(0 && "Unknown accessor type");
         }
-        else if (StrCMP16(curr, "min")) curr = SkipToNextNode(curr, '[', ']'); // skip min and max
-        else if (StrCMP16(curr, "max")) curr = SkipToNextNode(curr, '[', ']');
-        else if (StrCMP16(curr, "normalized")) curr = SkipAfter(curr, '"');
+        else if (StrPrefixCMP16(curr, "min")) curr = SkipToNextNode(curr, '[', ']'); // skip min and max
+        else if (StrPrefixCMP16(curr, "max")) curr = SkipToNextNode(curr, '[', ']');
+        else if (StrPrefixCMP16(curr, "normalized")) curr = SkipAfter(curr, '"');
         else
         {
             ASSERT(0 && "unknown accessor var");
@@ -190,7 +373,7 @@ __private const char* ParseAccessors(const char* curr, GLTFAccessor** accessorAr
 
 inline int ParsePositiveNumberSkip1(const char** ptr)
 {
-    *ptr++;
+    (*ptr)++;
     return ParsePositiveNumber(ptr);
 }
 
@@ -204,6 +387,7 @@ __private const char* ParseBufferViews(const char* curr, GLTFBufferView** buffer
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}') // next buffer view
@@ -212,24 +396,25 @@ __private const char* ParseBufferViews(const char* curr, GLTFBufferView** buffer
                 dynarray_push(*bufferViews, bufferView);
                 MemsetZero(&bufferView, sizeof(GLTFBufferView));
             }
-            if (*curr++ == ']') return curr; // end all buffer views
+            if (*curr == ']') return curr + 1; // end all buffer views
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '0' && "buffer view parse failed, probably you forgot to close brackets!", return (const char*)AError_CloseBrackets);
 
         uint64_t hash;
         curr = HashStringInQuotes(&hash, curr);
 
-        if      (hash == AHashString8("buffer"))   { bufferView.buffer = ParsePositiveNumberSkip1(&curr); break;  } 
-        else if (hash == AHashString8("byteOffs")) { bufferView.byteOffset = ParsePositiveNumberSkip1(&curr); break;  } 
-        else if (hash == AHashString8("byteLeng")) { bufferView.byteLength = ParsePositiveNumberSkip1(&curr); break;  } 
-        else if (hash == AHashString8("byteStri")) { bufferView.byteStride = ParsePositiveNumberSkip1(&curr); break;  } 
-        else if (hash == AHashString8("target"))   { bufferView.target = ParsePositiveNumberSkip1(&curr); break; } 
+        if      (hash == AHashString8("buffer"))   { bufferView.buffer = ParsePositiveNumberSkip1(&curr); continue;  } 
+        else if (hash == AHashString8("byteOffs")) { bufferView.byteOffset = ParsePositiveNumberSkip1(&curr); continue;  } 
+        else if (hash == AHashString8("byteLeng")) { bufferView.byteLength = ParsePositiveNumberSkip1(&curr); continue;  } 
+        else if (hash == AHashString8("byteStri")) { bufferView.byteStride = ParsePositiveNumberSkip1(&curr); continue;  } 
+        else if (hash == AHashString8("target"))   { bufferView.target = ParsePositiveNumberSkip1(&curr); continue; } 
         else if (hash == AHashString8("name")) 
         {
             int numQuote = 0;
             while (numQuote < 2)
                 numQuote += *curr++ == '"';
-            break;
+            continue;
         }
         else {
             ASSERT(0 && "UNKNOWN buffer view value!");
@@ -239,27 +424,253 @@ __private const char* ParseBufferViews(const char* curr, GLTFBufferView** buffer
     return (const char*)AError_UNKNOWN_BUFFER_VIEW_VAR;
 }
 
-static void DecodeBase64(char *dst, const char *src, size_t src_length)
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                                 Base64                                   */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+// 0xFF for the characters that are not in the base64 alphabet
+static const uint8_t g_Base64Table[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+// removes up to two '=' padding characters, returns number of bytes that will be decoded
+__private uint64_t Base64DecodedSize(const char* src, uint64_t* srcLength)
 {
-    uint8_t table[256] = { 0 };
-    for (char c = 'A'; c <= 'Z'; c++) table[c] = (uint8_t)(c - 'A');
-    for (char c = 'a'; c <= 'z'; c++) table[c] = (uint8_t)(26 + (c - 'a'));
-    for (char c = '0'; c <= '9'; c++) table[c] = (uint8_t)(52 + (c - '0'));
-    table['+'] = 62;
-    table['/'] = 63;
-    
-    for (uint64_t i = 0; i + 4 <= src_length; i += 4) {
-        uint32_t a = table[src[i + 0]];
-        uint32_t b = table[src[i + 1]];
-        uint32_t c = table[src[i + 2]];
-        uint32_t d = table[src[i + 3]];
-           
-        dst[0] = (char)(a << 2 | b >> 4);
-        dst[1] = (char)(b << 4 | c >> 2);
-        dst[2] = (char)(c << 6 | d);
-        dst += 3;
+    for (int i = 0; i < 2 && *srcLength > 0 && src[*srcLength - 1] == '='; i++)
+        (*srcLength)--;
+    uint64_t remainder = *srcLength & 3;
+    return (*srcLength >> 2) * 3 + (remainder ? remainder - 1 : 0);
+}
+
+// returns number of decoded bytes, or -1 if src has a character that is not in the base64 alphabet
+__private int64_t DecodeBase64Scalar(char* dst, const char* src, uint64_t srcLength)
+{
+    Base64DecodedSize(src, &srcLength);
+    if ((srcLength & 3) == 1) return -1;
+
+    const uint8_t* in = (const uint8_t*)src;
+    uint8_t* out = (uint8_t*)dst;
+    uint64_t i = 0;
+
+    for (; i + 4 <= srcLength; i += 4)
+    {
+        uint32_t a = g_Base64Table[in[i + 0]];
+        uint32_t b = g_Base64Table[in[i + 1]];
+        uint32_t c = g_Base64Table[in[i + 2]];
+        uint32_t d = g_Base64Table[in[i + 3]];
+        if ((a | b | c | d) & 0x80) return -1;
+
+        uint32_t bits = a << 18 | b << 12 | c << 6 | d;
+        out[0] = (uint8_t)(bits >> 16);
+        out[1] = (uint8_t)(bits >> 8);
+        out[2] = (uint8_t)bits;
+        out += 3;
+    }
+
+    // 2 or 3 characters without padding encodes 1 or 2 bytes
+    uint64_t remaining = srcLength - i;
+    if (remaining >= 2)
+    {
+        uint32_t a = g_Base64Table[in[i + 0]];
+        uint32_t b = g_Base64Table[in[i + 1]];
+        uint32_t c = remaining == 3 ? g_Base64Table[in[i + 2]] : 0u;
+        if ((a | b | c) & 0x80) return -1;
+
+        *out++ = (uint8_t)(a << 2 | b >> 4);
+        if (remaining == 3) *out++ = (uint8_t)(b << 4 | c >> 2);
+    }
+    return (int64_t)(out - (uint8_t*)dst);
+}
+
+// vectorized decoding: http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+// characters are classified with two nibble lookups, invalid characters are the ones that has common bits in both lookups.
+// then each character is shifted to its 6 bit value with an offset chosen by its high nibble ('/' is the special case)
+// after that multiply-add instructions packs 4x6 bits into 3 bytes
+#if defined(AX_SUPPORT_AVX2)
+__private int DecodeBase64Block32(uint8_t* out, const uint8_t* in)
+{
+    const __m256i lutLo   = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                             0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi   = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                             0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                             0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+    __m256i v = _mm256_loadu_si256((const __m256i*)in);
+    __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), nibbleMask);
+    __m256i loNibbles = _mm256_and_si256(v, nibbleMask);
+    __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+    __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+    if (!_mm256_testz_si256(lo, hi)) return 0;
+
+    __m256i isSlash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'));
+    __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(isSlash, hiNibbles));
+    v = _mm256_add_epi8(v, roll);
+
+    v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140)); // 00aaaaaa 00bbbbbb -> 0000aaaa aabbbbbb
+    v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));    // -> 00000000 aaaaaabb bbbbcccc ccdddddd
+    v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)); // 12 bytes of each lane are contiguous
+    _mm256_storeu_si256((__m256i*)out, v);
+    return 1;
+}
+#endif
+
+#if defined(AX_SUPPORT_SSE)
+__private int DecodeBase64Block16(uint8_t* out, const uint8_t* in)
+{
+    const __m128i lutLo   = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi   = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+    __m128i v = _mm_loadu_si128((const __m128i*)in);
+    __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(v, 4), nibbleMask);
+    __m128i loNibbles = _mm_and_si128(v, nibbleMask);
+    __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+    __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+    if (!_mm_testz_si128(lo, hi)) return 0;
+
+    __m128i isSlash = _mm_cmpeq_epi8(v, _mm_set1_epi8('/'));
+    __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(isSlash, hiNibbles));
+    v = _mm_add_epi8(v, roll);
+
+    v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+    v = _mm_shuffle_epi8(v, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    _mm_storeu_si128((__m128i*)out, v);
+    return 1;
+}
+#elif defined(AX_SUPPORT_NEON)
+// vld4 deinterleaves 64 characters, so each register holds one of the 4 characters of 16 groups
+__private uint8x16_t NeonBase64Lookup(uint8x16_t c, uint8x16_t* invalid)
+{
+    uint8x16_t result = vdupq_n_u8(0xFF);
+    #define AX_RANGE(first, count, value) { \
+        uint8x16_t d = vsubq_u8(c, vdupq_n_u8(first)); \
+        result = vbslq_u8(vcltq_u8(d, vdupq_n_u8(count)), vaddq_u8(d, vdupq_n_u8(value)), result); }
+    AX_RANGE('A', 26, 0)
+    AX_RANGE('a', 26, 26)
+    AX_RANGE('0', 10, 52)
+    AX_RANGE('+', 1, 62)
+    AX_RANGE('/', 1, 63)
+    #undef AX_RANGE
+    *invalid = vorrq_u8(*invalid, result);
+    return result;
+}
+
+__private int DecodeBase64Block64(uint8_t* out, const uint8_t* in)
+{
+    uint8x16x4_t v = vld4q_u8(in);
+    uint8x16_t invalid = vdupq_n_u8(0);
+    v.val[0] = NeonBase64Lookup(v.val[0], &invalid);
+    v.val[1] = NeonBase64Lookup(v.val[1], &invalid);
+    v.val[2] = NeonBase64Lookup(v.val[2], &invalid);
+    v.val[3] = NeonBase64Lookup(v.val[3], &invalid);
+    if (vmaxvq_u8(invalid) & 0x80) return 0;
+
+    uint8x16x3_t result;
+    result.val[0] = vorrq_u8(vshlq_n_u8(v.val[0], 2), vshrq_n_u8(v.val[1], 4));
+    result.val[1] = vorrq_u8(vshlq_n_u8(v.val[1], 4), vshrq_n_u8(v.val[2], 2));
+    result.val[2] = vorrq_u8(vshlq_n_u8(v.val[2], 6), v.val[3]);
+    vst3q_u8(out, result);
+    return 1;
+}
+#endif
+
+// returns number of decoded bytes, or -1 if src has a character that is not in the base64 alphabet
+// dst must have space for at least (srcLength / 4) * 3 bytes, wide stores never pass the decoded size
+__private int64_t DecodeBase64(char* dst, const char* src, uint64_t srcLength)
+{
+    uint64_t decodedSize = Base64DecodedSize(src, &srcLength);
+    const uint8_t* in = (const uint8_t*)src;
+    uint8_t* out = (uint8_t*)dst;
+    uint64_t i = 0, o = 0;
+
+    #if defined(AX_SUPPORT_AVX2)
+    for (; i + 32 <= srcLength && o + 32 <= decodedSize; i += 32, o += 24)
+        if (!DecodeBase64Block32(out + o, in + i)) return -1;
+    #endif
+
+    #if defined(AX_SUPPORT_SSE)
+    for (; i + 16 <= srcLength && o + 16 <= decodedSize; i += 16, o += 12)
+        if (!DecodeBase64Block16(out + o, in + i)) return -1;
+    #elif defined(AX_SUPPORT_NEON)
+    for (; i + 64 <= srcLength && o + 48 <= decodedSize; i += 64, o += 48)
+        if (!DecodeBase64Block64(out + o, in + i)) return -1;
+    #endif
+
+    int64_t tail = DecodeBase64Scalar(dst + o, src + i, srcLength - i);
+    return tail < 0 ? -1 : (int64_t)o + tail;
+}
+
+#ifdef AX_BASE64_BENCHMARK
+#include <time.h>
+#include <string.h>
+
+__private double Base64BenchmarkNow(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// decodes 32mb of random base64 text with both decoders and prints throughput of each.
+// define AX_BASE64_BENCHMARK and call this from anywhere
+__public void Base64Benchmark(void)
+{
+    const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const uint64_t srcLength = 32ull << 20;
+    char* src = (char*)rpmalloc(srcLength);
+    char* scalarDst = (char*)rpmalloc(srcLength);
+    char* simdDst   = (char*)rpmalloc(srcLength);
+
+    uint32_t seed = 0x9E3779B9u;
+    for (uint64_t i = 0; i < srcLength; i++)
+    {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        src[i] = alphabet[seed & 63];
     }
+
+    double scalarTime = 1e9, simdTime = 1e9;
+    int64_t scalarSize = 0, simdSize = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        double start = Base64BenchmarkNow();
+        scalarSize = DecodeBase64Scalar(scalarDst, src, srcLength);
+        double mid = Base64BenchmarkNow();
+        simdSize = DecodeBase64(simdDst, src, srcLength);
+        double end = Base64BenchmarkNow();
+        scalarTime = MMIN(scalarTime, mid - start);
+        simdTime   = MMIN(simdTime, end - mid);
+    }
+
+    bool same = scalarSize == simdSize && scalarSize > 0 && memcmp(scalarDst, simdDst, (size_t)scalarSize) == 0;
+    printf("base64 decode %llu bytes, scalar: %.2f GB/s, simd: %.2f GB/s, results %s\n",
+           (unsigned long long)srcLength, srcLength / scalarTime * 1e-9, srcLength / simdTime * 1e-9, same ? "match" : "DIFFER");
+
+    rpfree(src);
+    rpfree(scalarDst);
+    rpfree(simdDst);
 }
+#endif // AX_BASE64_BENCHMARK
 
 __private const char* ParseBuffers(const char* curr, const char* path, GLTFBuffer** bufferArray)
 {
@@ -272,13 +683,14 @@ __private const char* ParseBuffers(const char* curr, const char* path, GLTFBuffe
     endOfWorkDir = binFilePath + binPathlen;
     
     // remove bla.gltf
-    while (binFilePath[binPathlen - 1] != '/' && binFilePath[binPathlen - 1] != '\\')
+    while (binPathlen > 0 && binFilePath[binPathlen - 1] != '/' && binFilePath[binPathlen - 1] != '\\')
         binFilePath[--binPathlen] = '\0', endOfWorkDir--;
 
     // read each buffer
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}') // next buffer
@@ -288,23 +700,27 @@ __private const char* ParseBuffers(const char* curr, const char* path, GLTFBuffe
                 MemsetZero(endOfWorkDir, sizeof(binFilePath) - (size_t)(endOfWorkDir - binFilePath));
             }
 
-            if (*curr++ == ']') return curr; // end all buffers
+            if (*curr == ']') return curr + 1; // end all buffers
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr && "parsing buffers failed, probably you forgot to close braces", return (const char*)AError_CloseBrackets);
         curr++;
-        if (StrCMP16(curr, "uri")) // is uri
+        if (StrPrefixCMP16(curr, "uri")) // is uri
         {
             curr += sizeof("uri'"); // skip uri": 
-            while (*curr != '"') curr++;
+            curr = SkipUntill(curr, '"');
             if (aStartsWith(&curr, "\"data:"))
             {
                 curr = SkipAfter(curr, ',');
-                uint64_t base64Size = 0;
-                while (curr[base64Size] != '\"') {
-                    base64Size++;
-                }
+                // we are inside of the string, next structural is the closing quote
+                uint64_t base64Size = (uint64_t)(NextStructural(curr) - curr);
                 buffer.uri = rpmalloc(base64Size);
-                DecodeBase64((char*)buffer.uri, curr, base64Size);
+                if (DecodeBase64((char*)buffer.uri, curr, base64Size) < 0)
+                {
+                    ASSERT(0 && "embedded buffer is not valid base64");
+                    rpfree(buffer.uri);
+                    return (const char*)AError_BUFFER_PARSE_FAIL;
+                }
                 curr += base64Size + 1;
             }
             else
@@ -315,7 +731,7 @@ __private const char* ParseBuffers(const char* curr, const char* path, GLTFBuffe
                 if (!buffer.uri) return (const char*)AError_BIN_NOT_EXIST;
             }
         }
-        else if (StrCMP16(curr, "byteLength"))
+        else if (StrPrefixCMP16(curr, "byteLength"))
         {
             buffer.byteLength = ParsePositiveNumberSkip1(&curr);
         }
@@ -334,21 +750,24 @@ __private const char* ParseImages(const char* curr, const char* path, AImage** i
     curr++;
     
     int pathLen = StringLength(path);
-    while (path[pathLen-1] != '/') pathLen--;
+    while (pathLen > 0 && path[pathLen-1] != '/' && path[pathLen-1] != '\\') pathLen--;
 
     AImage image={};
     // read each buffer
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
-            if (*curr++ == ']')
-                return curr; // end all images
+        {
+            if (*curr == ']') return curr + 1; // end all images
+            curr = NextStructural(curr + 1);
+        }
         
         ASSERTR(*curr != '\0' && "parse images failed probably you forgot to close brackets", return (const char*)AError_CloseBrackets);
 
         curr++;
-        bool isUri = StrCMP16(curr, "uri");
+        bool isUri = StrPrefixCMP16(curr, "uri");
 
         // mimeType and name is not supported
         if (isUri)
@@ -378,6 +797,7 @@ __private const char* ParseTextures(const char* curr, ATexture** textures, Fixed
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}') // next buffer view
@@ -388,19 +808,19 @@ __private const char* ParseTextures(const char* curr, ATexture** textures, Fixed
 
             if (*curr == ']') // end all buffer views
                 return ++curr;
-            curr++;
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '\0' && "parse images failed probably you forgot to close brackets", return (const char*)AError_CloseBrackets);
         curr++;
-        if (StrCMP16(curr, "sampler")) 
+        if (StrPrefixCMP16(curr, "sampler")) 
         {
             texture.sampler = ParsePositiveNumberSkip1(&curr);
         }
-        else if (StrCMP16(curr, "source"))
+        else if (StrPrefixCMP16(curr, "source"))
         {
             texture.source = ParsePositiveNumberSkip1(&curr);
         }
-        else if (StrCMP16(curr, "name"))
+        else if (StrPrefixCMP16(curr, "name"))
         {
             curr += 5;
             curr = CopyStringInQuotes(&texture.name, &curr, allocator);
@@ -418,19 +838,23 @@ __private const char* ParseAttributes(const char* curr, APrimitive* primitive)
 
     while (true)
     {
+        curr = NextStructural(curr);
         while (*curr != '"')
-            if (*curr++ == '}') return curr;
+        {
+            if (*curr == '}') return curr + 1;
+            curr = NextStructural(curr + 1);
+        }
         
         curr++; // skip "
         unsigned maskBefore = primitive->attributes;
-        if      (StrCMP16(curr, "POSITION"))   { primitive->attributes |= AAttribType_POSITION;   curr += sizeof("POSITION'");   }
-        else if (StrCMP16(curr, "NORMAL"))     { primitive->attributes |= AAttribType_NORMAL;     curr += sizeof("NORMAL'");     }
-        else if (StrCMP16(curr, "TEXCOORD_0")) { primitive->attributes |= AAttribType_TEXCOORD_0; curr += sizeof("TEXCOORD_0'"); }
-        else if (StrCMP16(curr, "TANGENT"))    { primitive->attributes |= AAttribType_TANGENT;    curr += sizeof("TANGENT'");    }
-        else if (StrCMP16(curr, "TEXCOORD_1")) { primitive->attributes |= AAttribType_TEXCOORD_1; curr += sizeof("TEXCOORD_1'"); }
-        else if (StrCMP16(curr, "JOINTS_0"))   { primitive->attributes |= AAttribType_JOINTS;     curr += sizeof("JOINTS_0'");   }
-        else if (StrCMP16(curr, "WEIGHTS_0"))  { primitive->attributes |= AAttribType_WEIGHTS;    curr += sizeof("WEIGHTS_0'");  }
-        else if (StrCMP16(curr, "TEXCOORD_"))  { curr += sizeof("TEXCOORD_X'"); continue; } // < NO more than two texture coords
+        if      (StrPrefixCMP16(curr, "POSITION"))   { primitive->attributes |= AAttribType_POSITION;   curr += sizeof("POSITION'");   }
+        else if (StrPrefixCMP16(curr, "NORMAL"))     { primitive->attributes |= AAttribType_NORMAL;     curr += sizeof("NORMAL'");     }
+        else if (StrPrefixCMP16(curr, "TEXCOORD_0")) { primitive->attributes |= AAttribType_TEXCOORD_0; curr += sizeof("TEXCOORD_0'"); }
+        else if (StrPrefixCMP16(curr, "TANGENT"))    { primitive->attributes |= AAttribType_TANGENT;    curr += sizeof("TANGENT'");    }
+        else if (StrPrefixCMP16(curr, "TEXCOORD_1")) { primitive->attributes |= AAttribType_TEXCOORD_1; curr += sizeof("TEXCOORD_1'"); }
+        else if (StrPrefixCMP16(curr, "JOINTS_0"))   { primitive->attributes |= AAttribType_JOINTS;     curr += sizeof("JOINTS_0'");   }
+        else if (StrPrefixCMP16(curr, "WEIGHTS_0"))  { primitive->attributes |= AAttribType_WEIGHTS;    curr += sizeof("WEIGHTS_0'");  }
+        else if (StrPrefixCMP16(curr, "TEXCOORD_"))  { curr += sizeof("TEXCOORD_X'"); continue; } // < NO more than two texture coords
         else { ASSERT(0 && "attribute variable unknown!"); return (const char*)AError_UNKNOWN_ATTRIB; }
 
         // using bitmask will help us to order attributes correctly(sort) Position, Normal, TexCoord
@@ -449,6 +873,7 @@ __private const char* ParseMeshes(const char* curr, AMesh** meshes, FixedPow2All
     // parse all meshes
     while (true)
     {
+        curr = NextStructural(curr);
         while (*curr != '"')
         {
             if (*curr == '}') 
@@ -456,15 +881,16 @@ __private const char* ParseMeshes(const char* curr, AMesh** meshes, FixedPow2All
                 dynarray_push(*meshes, mesh);
                 MemsetZero(&mesh, sizeof(AMesh));
             }
-            if (*curr++ == ']') return curr; // end of meshes
+            if (*curr == ']') return curr + 1; // end of meshes
+            curr = NextStructural(curr + 1);
         }
         curr = GetStringInQuotes(text, curr);
         
-        if (StrCMP16(text, "name")) {
+        if (StrPrefixCMP16(text, "name")) {
             curr = CopyStringInQuotes(&mesh.name, &curr, allocator); 
             continue; 
         }
-        else if (StrCMP16(text, "weights"))
+        else if (StrPrefixCMP16(text, "weights"))
         {
             curr = SkipAfter(curr, '[');
             const char* begin = curr;
@@ -483,16 +909,18 @@ __private const char* ParseMeshes(const char* curr, AMesh** meshes, FixedPow2All
             curr = SkipAfter(curr, ']');
             continue;
         }
-        else if (!StrCMP16(text, "primitives")) { 
+        else if (!StrPrefixCMP16(text, "primitives")) { 
             ASSERT(0 && "only primitives, name and weights allowed"); 
             return (const char*)AError_UNKNOWN_MESH_VAR; 
         }
 
         APrimitive primitive={0};  
         primitive.material = -1;
+        mesh.primitives = dynarray_create(APrimitive);
         // parse primitives
         while (true)
         {
+            curr = NextStructural(curr);
             while (*curr != '"')
             {
                 if (*curr == '}')
@@ -503,36 +931,40 @@ __private const char* ParseMeshes(const char* curr, AMesh** meshes, FixedPow2All
                     primitive.material = -1;
                 }
 
-                if (*curr++ == ']') goto end_primitives; // this is end of primitive list
+                if (*curr == ']') { curr++; goto end_primitives; } // this is end of primitive list
+                curr = NextStructural(curr + 1);
             }
             curr++;
             
-            if      (StrCMP16(curr, "attributes")) { curr = ParseAttributes(curr, &primitive); }
-            else if (StrCMP16(curr, "indices"))    { primitive.indiceIndex = ParsePositiveNumber(&curr); }
-            else if (StrCMP16(curr, "mode"))       { primitive.mode        = ParsePositiveNumber(&curr); }
-            else if (StrCMP16(curr, "material"))   { primitive.material    = ParsePositiveNumber(&curr); }
-            else if (StrCMP16(curr, "targets"))    
+            if      (StrPrefixCMP16(curr, "attributes")) { curr = ParseAttributes(curr, &primitive); }
+            else if (StrPrefixCMP16(curr, "indices"))    { primitive.indiceIndex = ParsePositiveNumber(&curr); }
+            else if (StrPrefixCMP16(curr, "mode"))       { primitive.mode        = ParsePositiveNumber(&curr); }
+            else if (StrPrefixCMP16(curr, "material"))   { primitive.material    = ParsePositiveNumber(&curr); }
+            else if (StrPrefixCMP16(curr, "targets"))    
             {
                 curr += sizeof("targets'");
                 AMorphTarget morphTarget = {};
+                primitive.morphTargets = dynarray_create(AMorphTarget);
                 while (*curr)
                 {
+                    curr = NextStructural(curr);
                     while (*curr != '"')
                     {
                         if (*curr == '}') {
                             dynarray_push(primitive.morphTargets, morphTarget);
                             MemsetZero(&morphTarget, sizeof(AMorphTarget));
                         }
-                        if (*curr++ == ']') goto end_morphs;
+                        if (*curr == ']') { curr++; goto end_morphs; }
+                        curr = NextStructural(curr + 1);
                     }
                     curr++; // skip "
 
                     unsigned maskBefore = morphTarget.attributes;
-                    if      (StrCMP16(curr, "POSITION"))   { morphTarget.attributes |= AAttribType_POSITION;   curr += sizeof("POSITION'"); }
-                    else if (StrCMP16(curr, "TEXCOORD_0")) { morphTarget.attributes |= AAttribType_TEXCOORD_0; curr += sizeof("TEXCOORD_0'"); }
-                    else if (StrCMP16(curr, "NORMAL"))     { morphTarget.attributes |= AAttribType_NORMAL;     curr += sizeof("NORMAL'"); }
-                    else if (StrCMP16(curr, "TANGENT"))    { morphTarget.attributes |= AAttribType_TANGENT;    curr += sizeof("TANGENT'"); }
-                    else if (StrCMP16(curr, "TEXCOORD_"))  { curr = SkipAfter(curr, '"'); continue; } // < NO more than one texture coords
+                    if      (StrPrefixCMP16(curr, "POSITION"))   { morphTarget.attributes |= AAttribType_POSITION;   curr += sizeof("POSITION'"); }
+                    else if (StrPrefixCMP16(curr, "TEXCOORD_0")) { morphTarget.attributes |= AAttribType_TEXCOORD_0; curr += sizeof("TEXCOORD_0'"); }
+                    else if (StrPrefixCMP16(curr, "NORMAL"))     { morphTarget.attributes |= AAttribType_NORMAL;     curr += sizeof("NORMAL'"); }
+                    else if (StrPrefixCMP16(curr, "TANGENT"))    { morphTarget.attributes |= AAttribType_TANGENT;    curr += sizeof("TANGENT'"); }
+                    else if (StrPrefixCMP16(curr, "TEXCOORD_"))  { curr = SkipAfter(curr, '"'); continue; } // < NO more than one texture coords
                     else { ASSERT(0 && "attribute variable unknown!"); return (const char*)AError_UNKNOWN_ATTRIB; }
                  
                     // detect changed attribute.
@@ -595,6 +1027,7 @@ __private const char* ParseNodes(const char* curr, ANode** nodes, float scale, F
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}')
@@ -605,21 +1038,22 @@ __private const char* ParseNodes(const char* curr, ANode** nodes, float scale, F
                 node.scale[0] = node.scale[1] = node.scale[2] = scale;
                 node.index = -1;
             }
-            if (*curr++ == ']') return curr; // end all nodes
+            if (*curr == ']') return curr + 1; // end all nodes
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '\0' && "parsing nodes not possible, probably forgot to close brackets!", return (const char*)AError_CloseBrackets);
         curr++; // skips the "
         
         // mesh, name, children, matrix, translation, rotation, scale, skin
-        if      (StrCMP16(curr, "mesh"))   { node.type = 0; node.index = ParsePositiveNumber(&curr); continue; } // don't want to skip ] that's why continue
-        else if (StrCMP16(curr, "camera")) { node.type = 1; node.index = ParsePositiveNumber(&curr); continue; } // don't want to skip ] that's why continue
-        else if (StrCMP16(curr, "children"))
+        if      (StrPrefixCMP16(curr, "mesh"))   { node.type = 0; node.index = ParsePositiveNumber(&curr); continue; } // don't want to skip ] that's why continue
+        else if (StrPrefixCMP16(curr, "camera")) { node.type = 1; node.index = ParsePositiveNumber(&curr); continue; } // don't want to skip ] that's why continue
+        else if (StrPrefixCMP16(curr, "children"))
         {
             IntPtrPair result = ParseIntArray(&curr, allocator);
             node.numChildren = result.numElements;
             node.children = result.ptr;
         }
-        else if (StrCMP16(curr, "matrix"))
+        else if (StrPrefixCMP16(curr, "matrix"))
         {
             Matrix4 m;
             float* matrix = &m.m[0][0];
@@ -636,32 +1070,32 @@ __private const char* ParseNodes(const char* curr, ANode** nodes, float scale, F
             Vector4x32f v = VecMulf(ExtractScaleV(m), scale);
             Vec3Store(node.scale, v);
         }
-        else if (StrCMP16(curr, "translation"))
+        else if (StrPrefixCMP16(curr, "translation"))
         {
             node.translation[0] = ParseFloat(&curr);
             node.translation[1] = ParseFloat(&curr);
             node.translation[2] = ParseFloat(&curr);
         }
-        else if (StrCMP16(curr, "rotation"))
+        else if (StrPrefixCMP16(curr, "rotation"))
         {
             node.rotation[0] = ParseFloat(&curr);
             node.rotation[1] = ParseFloat(&curr);
             node.rotation[2] = ParseFloat(&curr);
             node.rotation[3] = ParseFloat(&curr);
         }
-        else if (StrCMP16(curr, "scale"))
+        else if (StrPrefixCMP16(curr, "scale"))
         {
             node.scale[0] = ParseFloat(&curr) * scale;
             node.scale[1] = ParseFloat(&curr) * scale;
             node.scale[2] = ParseFloat(&curr) * scale;
         }
-        else if (StrCMP16(curr, "name"))
+        else if (StrPrefixCMP16(curr, "name"))
         {
             curr += 5;
             curr = CopyStringInQuotes(&node.name, &curr, allocator);
             continue; 
         }
-        else if (StrCMP16(curr, "skin"))
+        else if (StrPrefixCMP16(curr, "skin"))
         {
             node.skin = ParsePositiveNumber(&curr);
             continue; // continue because we don't want to skip ] and it is not exist
@@ -686,6 +1120,7 @@ __private const char* ParseCameras(const char* curr, ACamera** cameras, FixedPow
     // parse all meshes
     while (true)
     {
+        curr = NextStructural(curr);
         while (*curr != '"')
         {
             if (*curr == '}') 
@@ -693,15 +1128,16 @@ __private const char* ParseCameras(const char* curr, ACamera** cameras, FixedPow
                 dynarray_push(*cameras, camera);
                 MemsetZero(&camera, sizeof(ACamera));
             }
-            if (*curr++ == ']') return curr; // end of cameras
+            if (*curr == ']') return curr + 1; // end of cameras
+            curr = NextStructural(curr + 1);
         }
         curr = GetStringInQuotes(text, curr);
         
-        if (StrCMP16(text, "name")) {
+        if (StrPrefixCMP16(text, "name")) {
             curr = CopyStringInQuotes(&camera.name, &curr, allocator); 
             continue; 
         }
-        if (StrCMP16(text, "type")) {
+        if (StrPrefixCMP16(text, "type")) {
             curr = SkipUntill(curr, '"');
             curr++;
             camera.type = *curr == 'p'; // 0 orthographic 1 perspective 
@@ -709,7 +1145,7 @@ __private const char* ParseCameras(const char* curr, ACamera** cameras, FixedPow
             curr++;
             continue; 
         }
-        else if (!StrCMP16(text, "orthographic") && !StrCMP16(text, "perspective")) { 
+        else if (!StrPrefixCMP16(text, "orthographic") && !StrPrefixCMP16(text, "perspective")) { 
             ASSERT(0 && "unknown camera variable"); 
             return (const char*)AError_UNKNOWN_CAMERA_VAR; 
         }
@@ -717,16 +1153,20 @@ __private const char* ParseCameras(const char* curr, ACamera** cameras, FixedPow
         // parse primitives
         while (true)
         {
+            curr = NextStructural(curr);
             while (*curr != '"')
-                if (*curr++ == '}')  goto end_properties; // this is end of camera variables
+            {
+                if (*curr == '}') { curr++; goto end_properties; } // this is end of camera variables
+                curr = NextStructural(curr + 1);
+            }
             
             curr++;
-            if      (StrCMP16(curr, "zfar"))        { camera.zFar        = ParseFloat(&curr); }
-            else if (StrCMP16(curr, "znear"))       { camera.zNear       = ParseFloat(&curr); }
-            else if (StrCMP16(curr, "aspectRatio")) { camera.aspectRatio = ParseFloat(&curr); }
-            else if (StrCMP16(curr, "yfov"))        { camera.yFov        = ParseFloat(&curr); }
-            else if (StrCMP16(curr, "xmag"))        { camera.xmag        = ParseFloat(&curr); }
-            else if (StrCMP16(curr, "ymag"))        { camera.ymag        = ParseFloat(&curr); }
+            if      (StrPrefixCMP16(curr, "zfar"))        { camera.zFar        = ParseFloat(&curr); }
+            else if (StrPrefixCMP16(curr, "znear"))       { camera.zNear       = ParseFloat(&curr); }
+            else if (StrPrefixCMP16(curr, "aspectRatio")) { camera.aspectRatio = ParseFloat(&curr); }
+            else if (StrPrefixCMP16(curr, "yfov"))        { camera.yFov        = ParseFloat(&curr); }
+            else if (StrPrefixCMP16(curr, "xmag"))        { camera.xmag        = ParseFloat(&curr); }
+            else if (StrPrefixCMP16(curr, "ymag"))        { camera.ymag        = ParseFloat(&curr); }
             else { ASSERT(0); return (const char*)AError_UNKNOWN_CAMERA_VAR; }
         }
         end_properties:{}
@@ -743,6 +1183,7 @@ __private const char* ParseScenes(const char* curr, AScene** scenes, FixedPow2Al
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}')
@@ -750,12 +1191,13 @@ __private const char* ParseScenes(const char* curr, AScene** scenes, FixedPow2Al
                 dynarray_push(*scenes, scene);
                 MemsetZero(&scene, sizeof(AScene));
             }
-            if (*curr++ == ']') return curr; // end all scenes
+            if (*curr == ']') return curr + 1; // end all scenes
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '\0' && "parsing scenes not possible, probably forgot to close brackets!", return (const char*)AError_CloseBrackets);
         curr++; // skips the "
         
-        if (StrCMP16(curr, "nodes"))
+        if (StrPrefixCMP16(curr, "nodes"))
         {
             // find how many childs there are:
             while (!IsNumber(*curr)) curr++;
@@ -781,7 +1223,7 @@ __private const char* ParseScenes(const char* curr, AScene** scenes, FixedPow2Al
             }
             curr++;// skip ]
         }
-        else if (StrCMP16(curr, "name"))
+        else if (StrPrefixCMP16(curr, "name"))
         {
             curr += 5;
             curr = CopyStringInQuotes(&scene.name, &curr, allocator);
@@ -811,6 +1253,7 @@ __private const char* ParseSamplers(const char* curr, ASampler** samplers)
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}')
@@ -818,15 +1261,16 @@ __private const char* ParseSamplers(const char* curr, ASampler** samplers)
                 dynarray_push(*samplers, sampler);
                 MemsetZero(&sampler, sizeof(ASampler));
             }
-            if (*curr++ == ']') return curr; // end all nodes
+            if (*curr == ']') return curr + 1; // end all nodes
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '\0' && "parsing nodes not possible, probably forgot to close brackets!", return (const char*)AError_CloseBrackets);
         curr++; // skips the "
 
-        if      (StrCMP16(curr, "magFilter")) sampler.magFilter = (char)(ParsePositiveNumber(&curr) - 0x2600); // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
-        else if (StrCMP16(curr, "minFilter")) sampler.minFilter = (char)(ParsePositiveNumber(&curr) - 0x2600); // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
-        else if (StrCMP16(curr, "wrapS"))     sampler.wrapS = (char)OGLWrapToWrap(ParsePositiveNumber(&curr));
-        else if (StrCMP16(curr, "wrapT"))     sampler.wrapT = (char)OGLWrapToWrap(ParsePositiveNumber(&curr));
+        if      (StrPrefixCMP16(curr, "magFilter")) sampler.magFilter = (char)(ParsePositiveNumber(&curr) - 0x2600); // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
+        else if (StrPrefixCMP16(curr, "minFilter")) sampler.minFilter = (char)(ParsePositiveNumber(&curr) - 0x2600); // GL_NEAREST 9728, GL_LINEAR 0x2601 9729
+        else if (StrPrefixCMP16(curr, "wrapS"))     sampler.wrapS = (char)OGLWrapToWrap(ParsePositiveNumber(&curr));
+        else if (StrPrefixCMP16(curr, "wrapT"))     sampler.wrapT = (char)OGLWrapToWrap(ParsePositiveNumber(&curr));
         else { ASSERT(0 && "parse samplers failed!"); return (const char*)AError_UNKNOWN; }
     }
 }
@@ -838,27 +1282,29 @@ __private const char* ParseMaterialTexture(const char* curr, GLTFTexture* textur
     texture->strength = MakeFloat16(1.0f);
     while (true)
     {
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
-            if (*curr++ == '}') return curr;
+            if (*curr == '}') return curr + 1;
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr && "parsing material failed, probably forgot to close brackets", return (const char*)AError_CloseBrackets);
         curr++;
 
-        if (StrCMP16(curr, "scale")) {
+        if (StrPrefixCMP16(curr, "scale")) {
             curr = ParseFloat16(&curr, &texture->scale);
         }
-        else if (StrCMP16(curr, "index")) {
+        else if (StrPrefixCMP16(curr, "index")) {
             texture->index = ParsePositiveNumber(&curr);
             ASSERT(texture->index < UINT16_MAX-1);
         }
-        else if (StrCMP16(curr, "texCoord")) {
+        else if (StrPrefixCMP16(curr, "texCoord")) {
             texture->texCoord = ParsePositiveNumber(&curr);
         }
-        else if (StrCMP16(curr, "strength")) {
+        else if (StrPrefixCMP16(curr, "strength")) {
             curr = ParseFloat16(&curr, &texture->strength);
         }
-        else if (StrCMP16(curr, "extensions")) {
+        else if (StrPrefixCMP16(curr, "extensions")) {
             curr = SkipToNextNode(curr, '{', '}'); // currently extensions are not supported 
         }
         else {
@@ -880,6 +1326,7 @@ __private const char* ParseMaterials(const char* curr, AMaterial** materials, Fi
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}')
@@ -897,24 +1344,25 @@ __private const char* ParseMaterials(const char* curr, AMaterial** materials, Fi
                 material.metallicFactor  = PackUnorm16(1.0f);
                 material.roughnessFactor = PackUnorm16(1.0f);
             }
-            if (*curr++ == ']') return curr; // end all nodes
+            if (*curr == ']') return curr + 1; // end all nodes
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr && "parsing material failed, probably forgot to close brackets", return (const char*)AError_CloseBrackets);
 
         int texture = -1;
         curr++; // skips the "
-        if (StrCMP16(curr, "name"))
+        if (StrPrefixCMP16(curr, "name"))
         {
             curr += 5;
             curr = CopyStringInQuotes(&material.name, &curr, allocator);
         }
-        else if (StrCMP16(curr, "doubleSided"))
+        else if (StrPrefixCMP16(curr, "doubleSided"))
         {
             curr += sizeof("doubleSided'"); // skip doubleSided"
             AX_NO_UNROLL while (!IsLower(*curr)) curr++;
             material.doubleSided = *curr == 't';
         }
-        else if (StrCMP16(curr, "pbrMetallicRoug")) //pbrMetallicRoughhness
+        else if (StrPrefixCMP16(curr, "pbrMetallicRoug")) //pbrMetallicRoughhness
         {
             curr = SkipUntill(curr, '{');
     
@@ -922,26 +1370,28 @@ __private const char* ParseMaterials(const char* curr, AMaterial** materials, Fi
             while (true)
             {
                 // search for name
+                curr = NextStructural(curr);
                 while (*curr && *curr != '"')
                 {
-                    if (*curr++ == '}') { goto pbr_end; }
+                    if (*curr == '}') { curr++; goto pbr_end; }
+                    curr = NextStructural(curr + 1);
                 }
                 curr++; // skips the "
                 
-                if      (StrCMP16(curr, "baseColorTex"))  { curr = ParseMaterialTexture(curr, &material.baseColorTexture); }
-                else if (StrCMP16(curr, "metallicRough")) { curr = ParseMaterialTexture(curr, &material.metallicRoughnessTexture); }
-                else if (StrCMP16(curr, "baseColorFact"))
+                if      (StrPrefixCMP16(curr, "baseColorTex"))  { curr = ParseMaterialTexture(curr, &material.baseColorTexture); }
+                else if (StrPrefixCMP16(curr, "metallicRough")) { curr = ParseMaterialTexture(curr, &material.metallicRoughnessTexture); }
+                else if (StrPrefixCMP16(curr, "baseColorFact"))
                 {
                     float baseColorFactor[4] = { ParseFloat(&curr), ParseFloat(&curr), ParseFloat(&curr), ParseFloat(&curr)};
                     material.baseColorFactor = PackColor4PtrToUint(baseColorFactor);
                     curr = SkipUntill(curr, ']');
                     curr++;
                 }
-                else if (StrCMP16(curr, "metallicFact"))
+                else if (StrPrefixCMP16(curr, "metallicFact"))
                 {
                     material.metallicFactor = PackUnorm16(ParseFloat(&curr));
                 }
-                else if (StrCMP16(curr, "roughnessFact"))
+                else if (StrPrefixCMP16(curr, "roughnessFact"))
                 {
                     material.roughnessFactor = PackUnorm16(ParseFloat(&curr));
                 }
@@ -953,10 +1403,10 @@ __private const char* ParseMaterials(const char* curr, AMaterial** materials, Fi
             }
             pbr_end: {}
         }
-        else if (StrCMP16(curr, "normalTexture"))    texture = 0;
-        else if (StrCMP16(curr, "occlusionTextur"))  texture = 1;
-        else if (StrCMP16(curr, "emissiveTexture"))  texture = 2;
-        else if (StrCMP16(curr, "emissiveFactor")) 
+        else if (StrPrefixCMP16(curr, "normalTexture"))    texture = 0;
+        else if (StrPrefixCMP16(curr, "occlusionTextur"))  texture = 1;
+        else if (StrPrefixCMP16(curr, "emissiveTexture"))  texture = 2;
+        else if (StrPrefixCMP16(curr, "emissiveFactor")) 
         {
             curr = ParseFloat16(&curr, &material.emissiveFactor[0]); 
             curr = ParseFloat16(&curr, &material.emissiveFactor[1]);
@@ -964,7 +1414,7 @@ __private const char* ParseMaterials(const char* curr, AMaterial** materials, Fi
             curr = SkipUntill(curr, ']');
             curr++;
         }
-        else if (StrCMP16(curr, "extensions"))
+        else if (StrPrefixCMP16(curr, "extensions"))
         {
             curr = SkipAfter(curr, '{');
             int balance = 1;
@@ -975,16 +1425,16 @@ __private const char* ParseMaterials(const char* curr, AMaterial** materials, Fi
                 if (*curr == '"')
                 {
                     ++curr; // skip "
-                    if (StrCMP16(curr, "index"))
+                    if (StrPrefixCMP16(curr, "index"))
                     {
                         curr += sizeof("index");
                         material.specularTexture.index = ParsePositiveNumber(&curr);
                     }
-                    else if (StrCMP16(curr, "ior"))
+                    else if (StrPrefixCMP16(curr, "ior"))
                     {
                         material.ior = ParseFloat(&curr);
                     }
-                    else if (StrCMP16(curr, "specularColorFa"))
+                    else if (StrPrefixCMP16(curr, "specularColorFa"))
                     {
                         curr += sizeof("specularColorFactor");
                         float s = (ParseFloat(&curr) + ParseFloat(&curr) + ParseFloat(&curr)) * 0.33333f;
@@ -996,21 +1446,21 @@ __private const char* ParseMaterials(const char* curr, AMaterial** materials, Fi
                 balance += *curr++ == '{';
             }
         }
-        else if (StrCMP16(curr, "alphaMode"))
+        else if (StrPrefixCMP16(curr, "alphaMode"))
         {
             char text[16]={0};
             curr += sizeof("alphaMode'");
             curr = SkipUntill(curr, '"');
             curr = GetStringInQuotes(text, curr);
-            if (StrCMP16(text, "OPAQUE")) material.alphaMode = AMaterialAlphaMode_Opaque;
-            else if (StrCMP16(text, "MASK"))   material.alphaMode = AMaterialAlphaMode_Mask;
-            else if (StrCMP16(text, "BLEND"))  material.alphaMode = AMaterialAlphaMode_Blend;
+            if (StrPrefixCMP16(text, "OPAQUE")) material.alphaMode = AMaterialAlphaMode_Opaque;
+            else if (StrPrefixCMP16(text, "MASK"))   material.alphaMode = AMaterialAlphaMode_Mask;
+            else if (StrPrefixCMP16(text, "BLEND"))  material.alphaMode = AMaterialAlphaMode_Blend;
         }
-        else if (StrCMP16(curr, "alphaCutoff"))
+        else if (StrPrefixCMP16(curr, "alphaCutoff"))
         {
             material.alphaCutoff = ParseFloat(&curr);
         }
-        else if (StrCMP16(curr, "extras"))
+        else if (StrPrefixCMP16(curr, "extras"))
         {
             curr = SkipAfter(curr, '{');
             int balance = 1;
@@ -1045,6 +1495,7 @@ static const char* ParseSkins(const char* curr, ASkin** skins, FixedPow2Allocato
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}')
@@ -1053,19 +1504,20 @@ static const char* ParseSkins(const char* curr, ASkin** skins, FixedPow2Allocato
                 MemsetZero(&skin, sizeof(ASkin));
                 skin.skeleton = -1;
             }
-            if (*curr++ == ']') return curr; // end all nodes
+            if (*curr == ']') return curr + 1; // end all nodes
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '\0' && "parsing skins not possible, probably forgot to close brackets!", return (const char*)AError_CloseBrackets);
         curr++; // skips the "
 
-        if (StrCMP16(curr, "inverseBindMatrices"))
+        if (StrPrefixCMP16(curr, "inverseBindMatrices"))
         {
             // we will parse later, because we are not sure we are parsed accessors at this point
             skin.inverseBindMatrices = (float*)(size_t)ParsePositiveNumber(&curr);
         }
-        else if (StrCMP16(curr, "skeleton")) skin.skeleton = ParsePositiveNumber(&curr);
-        else if (StrCMP16(curr, "name")) { curr += 5; curr = CopyStringInQuotes(&skin.name, &curr, allocator); }
-        else if (StrCMP16(curr, "joints"))
+        else if (StrPrefixCMP16(curr, "skeleton")) skin.skeleton = ParsePositiveNumber(&curr);
+        else if (StrPrefixCMP16(curr, "name")) { curr += 5; curr = CopyStringInQuotes(&skin.name, &curr, allocator); }
+        else if (StrPrefixCMP16(curr, "joints"))
         {
             IntPtrPair result = ParseIntArray(&curr, allocator);
             skin.numJoints = result.numElements;
@@ -1088,6 +1540,7 @@ static const char* ParseAnimations(const char* curr, AAnimation** animations, Fi
     while (true)
     {
         // search for name
+        curr = NextStructural(curr);
         while (*curr && *curr != '"')
         {
             if (*curr == '}')
@@ -1096,28 +1549,31 @@ static const char* ParseAnimations(const char* curr, AAnimation** animations, Fi
                 animation.numChannels = dynarray_length(channels);
                 animation.samplers = samplers;
                 animation.channels = channels;
-                dynarray_push(animations, animation);
+                dynarray_push(*animations, animation);
                 MemsetZero(&animation, sizeof(AAnimation));
                 animation.speed = 1.0f;
+                channels = dynarray_create(AAnimChannel);
+                samplers = dynarray_create(AAnimSampler);
             }
-            if (*curr++ == ']') 
-                return curr; // end all nodes
+            if (*curr == ']') return curr + 1; // end all nodes
+            curr = NextStructural(curr + 1);
         }
         ASSERTR(*curr != '\0' && "parsing animations not possible, probably forgot to close brackets!", return (const char*)AError_CloseBrackets);
         curr++; // skips the "
 
-        if (StrCMP16(curr, "name"))
+        if (StrPrefixCMP16(curr, "name"))
         {
             curr += sizeof("name'");
             curr = CopyStringInQuotes(&animation.name, &curr, allocator);
         }
-        else if (StrCMP16(curr, "channels"))
+        else if (StrPrefixCMP16(curr, "channels"))
         {
             curr += sizeof("channels'");
             AAnimChannel channel;
             bool parsingTarget = false;
             while (true)
             {
+                curr = NextStructural(curr);
                 while (*curr && *curr != '"')
                 {
                     if (*curr == ']') { curr++; /* skip ] */ goto end_parsing; }
@@ -1130,16 +1586,16 @@ static const char* ParseAnimations(const char* curr, AAnimation** animations, Fi
                             MemsetZero(&channel, sizeof(AAnimChannel));
                         }
                     }
-                    curr++;
+                    curr = NextStructural(curr + 1);
                 }
                 ASSERTR(*curr != '\0' && "parsing anim channels not possible, probably forgot to close brackets!", return (const char*)AError_CloseBrackets);
 
                 uint64_t hash;
                 curr = HashStringInQuotes(&hash, curr);
 
-                if (hash == AHashString8("sampler")) { channel.sampler = ParsePositiveNumber(&curr);     break; } 
-                if (hash == AHashString8("node"))    { channel.targetNode = ParsePositiveNumber(&curr);  break; } 
-                if (hash == AHashString8("target"))  { curr += sizeof("target'"); parsingTarget = true; break; } 
+                if (hash == AHashString8("sampler")) { channel.sampler = ParsePositiveNumber(&curr);     continue; } 
+                if (hash == AHashString8("node"))    { channel.targetNode = ParsePositiveNumber(&curr);  continue; } 
+                if (hash == AHashString8("target"))  { curr += sizeof("target'"); parsingTarget = true; continue; } 
                 if (hash == AHashString8("path"))
                 {
                     curr = SkipAfter(curr, '"');
@@ -1154,12 +1610,13 @@ static const char* ParseAnimations(const char* curr, AAnimation** animations, Fi
                 else ASSERT(0 && "Unknown animation channel value");
             }
         }
-        else if (StrCMP16(curr, "samplers"))
+        else if (StrPrefixCMP16(curr, "samplers"))
         {
             curr += sizeof("samplers'");
             AAnimSampler sampler;
             while (true)
             {
+                curr = NextStructural(curr);
                 while (*curr && *curr != '"')
                 {
                     if (*curr == ']') { curr++; /* skip ] */ goto end_parsing; }
@@ -1168,15 +1625,15 @@ static const char* ParseAnimations(const char* curr, AAnimation** animations, Fi
                         dynarray_push(samplers, sampler);
                         MemsetZero(&sampler, sizeof(AAnimSampler));
                     }
-                    curr++;
+                    curr = NextStructural(curr + 1);
                 }
                 ASSERTR(*curr != '\0' && "parsing anim channels not possible, probably forgot to close brackets!", return (const char*)AError_CloseBrackets);
 
                 uint64_t hash;
                 curr = HashStringInQuotes(&hash, curr);
 
-                if (hash == AHashString8("input"))     { sampler.input  = (float*)(size_t)ParsePositiveNumber(&curr); break; } 
-                if (hash == AHashString8("output"))    { sampler.output = (float*)(size_t)ParsePositiveNumber(&curr); break; } 
+                if (hash == AHashString8("input"))     { sampler.input  = (float*)(size_t)ParsePositiveNumber(&curr); continue; } 
+                if (hash == AHashString8("output"))    { sampler.output = (float*)(size_t)ParsePositiveNumber(&curr); continue; } 
                 if (hash == AHashString8("interpol"))  // you've been searching from interpol hands up!!
                 {
                     curr += sizeof("interpolation") - sizeof("interpol");
@@ -1197,14 +1654,89 @@ static const char* ParseAnimations(const char* curr, AAnimation** animations, Fi
     return curr;
 }
 
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              GLB Container                               */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+#define GLB_MAGIC      0x46546C67u // "glTF"
+#define GLB_CHUNK_JSON 0x4E4F534Au // "JSON"
+#define GLB_CHUNK_BIN  0x004E4942u // "BIN\0"
+
+// layout: 12 byte header {magic, version, length}, JSON chunk, optional BIN chunk
+// each chunk starts with {uint32 length, uint32 type}, chunk lengths are multiple of 4
+// both chunks are referenced in place, no copy. json chunk is not null terminated,
+// so we overwrite first byte of the BIN chunk header after reading it
+__private int ParseGLBContainer(char* file, uint64_t fileSize, char** json, uint64_t* jsonSize, char** bin, uint64_t* binSize)
+{
+    if (fileSize < 20) return 0;
+
+    const uint32_t* header = (const uint32_t*)file;
+    uint64_t length = MMIN((uint64_t)header[2], fileSize);
+    if (header[0] != GLB_MAGIC || header[1] != 2) return 0;
+
+    uint64_t jsonLength = header[3];
+    if (header[4] != GLB_CHUNK_JSON || 20 + jsonLength > length) return 0;
+
+    *json = file + 20;
+    *jsonSize = jsonLength;
+    *bin = NULL;
+    *binSize = 0;
+
+    uint64_t binChunk = 20 + jsonLength;
+    if (binChunk + 8 <= length)
+    {
+        const uint32_t* chunk = (const uint32_t*)(file + binChunk);
+        if (chunk[1] == GLB_CHUNK_BIN && binChunk + 8 + chunk[0] <= length)
+        {
+            *bin = file + binChunk + 8;
+            *binSize = chunk[0];
+        }
+    }
+    file[binChunk] = '\0'; // file buffer has one extra byte for null terminator if there is no BIN chunk
+    return 1;
+}
+
+__private void FreeGLTFBuffer(GLTFBuffer* buffer)
+{
+    // glb BIN chunk is not allocated separately, it is inside of the file
+    FreeAllText(buffer->glbFile ? buffer->glbFile : (char*)buffer->uri);
+    buffer->uri = NULL;
+    buffer->glbFile = NULL;
+}
+
 __public int ParseGLTF(const char* path, SceneBundle* result, float scale)
 {
     ASSERT(result && path);
-    uint64_t sourceSize = 0;
-    char* source = ReadAllFile(path, NULL);
     MemsetZero(result, sizeof(SceneBundle));
 
-    if (source == NULL) { result->error = AError_FILE_NOT_FOUND; ASSERT(0); return 0; }
+    AFile file = AFileOpen(path, AOpenFlag_ReadBinary);
+    if (!AFileExist(file)) { result->error = AError_FILE_NOT_FOUND; ASSERT(0); return 0; }
+
+    uint64_t fileSize = AFileSize(file);
+    char* source = rpcalloc(fileSize + 1, 1); // +1 for null terminator
+    AFileRead(source, fileSize, file, 1);
+    AFileClose(file);
+
+    char* json = source;
+    uint64_t sourceSize = 0;
+    char* glbBin = NULL;
+    uint64_t glbBinSize = 0;
+
+    if (fileSize >= 4 && *(uint32_t*)source == GLB_MAGIC)
+    {
+        if (!ParseGLBContainer(source, fileSize, &json, &sourceSize, &glbBin, &glbBinSize))
+        {
+            ASSERT(0 && "glb container is corrupted");
+            result->error = AError_GLB_PARSE_FAIL;
+            FreeAllText(source);
+            return 0;
+        }
+    }
+    else
+    {
+        sourceSize = (uint64_t)StringLength(source);
+    }
+    BuildStructuralIndex(json, sourceSize);
 
     #if defined(DEBUG) || defined(_DEBUG)
     // ascii utf8 support check
@@ -1229,40 +1761,53 @@ __public int ParseGLTF(const char* path, SceneBundle* result, float scale)
     ACamera*    cameras    = dynarray_create(ACamera);
     AScene*     scenes     = dynarray_create(AScene);
 
-    const char* curr = source;
+    const char* curr = json;
     while (*curr)
     {
         // search for descriptor for example, accessors, materials, images, samplers
-        AX_NO_UNROLL while (*curr && *curr != '"') curr++;
+        curr = SkipUntill(curr, '"');
         
         if (*curr == '\0') break;
 
         curr++; // skips the "
-        if      (StrCMP16(curr, "accessors"))    curr = ParseAccessors(curr, &accessors);
-        else if (StrCMP16(curr, "scenes"))       curr = ParseScenes(curr, &scenes, allocator);
-        else if (StrCMP16(curr, "scene"))        result->defaultSceneIndex = ParsePositiveNumber(&curr);
-        else if (StrCMP16(curr, "bufferViews"))  curr = ParseBufferViews(curr, &bufferViews);
-        else if (StrCMP16(curr, "buffers"))      curr = ParseBuffers(curr, path, &buffers);     
-        else if (StrCMP16(curr, "images"))       curr = ParseImages(curr, path, &images, allocator);       
-        else if (StrCMP16(curr, "textures"))     curr = ParseTextures(curr, &textures,allocator);   
-        else if (StrCMP16(curr, "meshes"))       curr = ParseMeshes(curr, &meshes, allocator);
-        else if (StrCMP16(curr, "materials"))    curr = ParseMaterials(curr, &materials, allocator);
-        else if (StrCMP16(curr, "nodes"))        curr = ParseNodes(curr, &nodes, scale, allocator);
-        else if (StrCMP16(curr, "samplers"))     curr = ParseSamplers(curr, &samplers);    
-        else if (StrCMP16(curr, "cameras"))      curr = ParseCameras(curr, &cameras, allocator); 
-        else if (StrCMP16(curr, "skins"))        curr = ParseSkins(curr, &skins, allocator); 
-        else if (StrCMP16(curr, "animations"))   curr = ParseAnimations(curr, &animations, allocator); 
-        else if (StrCMP16(curr, "asset"))        curr = SkipToNextNode(curr, '{', '}'); // it just has text data that doesn't have anything to do with meshes, (author etc..) if you want you can add this feature :)
-        else if (StrCMP16(curr, "extensionsUsed") || StrCMP16(curr, "extensionsRequ")) curr = SkipToNextNode(curr, '[', ']');
+        if      (StrPrefixCMP16(curr, "accessors"))    curr = ParseAccessors(curr, &accessors);
+        else if (StrPrefixCMP16(curr, "scenes"))       curr = ParseScenes(curr, &scenes, allocator);
+        else if (StrPrefixCMP16(curr, "scene"))        result->defaultSceneIndex = ParsePositiveNumber(&curr);
+        else if (StrPrefixCMP16(curr, "bufferViews"))  curr = ParseBufferViews(curr, &bufferViews);
+        else if (StrPrefixCMP16(curr, "buffers"))      curr = ParseBuffers(curr, path, &buffers);     
+        else if (StrPrefixCMP16(curr, "images"))       curr = ParseImages(curr, path, &images, allocator);       
+        else if (StrPrefixCMP16(curr, "textures"))     curr = ParseTextures(curr, &textures,allocator);   
+        else if (StrPrefixCMP16(curr, "meshes"))       curr = ParseMeshes(curr, &meshes, allocator);
+        else if (StrPrefixCMP16(curr, "materials"))    curr = ParseMaterials(curr, &materials, allocator);
+        else if (StrPrefixCMP16(curr, "nodes"))        curr = ParseNodes(curr, &nodes, scale, allocator);
+        else if (StrPrefixCMP16(curr, "samplers"))     curr = ParseSamplers(curr, &samplers);    
+        else if (StrPrefixCMP16(curr, "cameras"))      curr = ParseCameras(curr, &cameras, allocator); 
+        else if (StrPrefixCMP16(curr, "skins"))        curr = ParseSkins(curr, &skins, allocator); 
+        else if (StrPrefixCMP16(curr, "animations"))   curr = ParseAnimations(curr, &animations, allocator); 
+        else if (StrPrefixCMP16(curr, "asset"))        curr = SkipToNextNode(curr, '{', '}'); // it just has text data that doesn't have anything to do with meshes, (author etc..) if you want you can add this feature :)
+        else if (StrPrefixCMP16(curr, "extensionsUsed") || StrPrefixCMP16(curr, "extensionsRequ")) curr = SkipToNextNode(curr, '[', ']');
         else { ASSERT(0); curr = (const char*)AError_UNKNOWN_DESCRIPTOR; }
 
         if (curr < (const char*)AError_MAX) // is failed?
         {
             result->error = (AErrorType)(uint64_t)curr;
+            FreeStructuralIndex();
             FreeAllText(source);
             return 0;
         }
     }
+
+    // in glb files, buffer that has no uri is the BIN chunk, it takes the ownership of the file
+    bool fileOwnedByBuffer = false;
+    for (int i = 0; i < dynarray_length(buffers) && glbBin; i++)
+    {
+        if (buffers[i].uri != NULL) continue;
+        ASSERT((uint64_t)buffers[i].byteLength <= glbBinSize);
+        buffers[i].uri = glbBin;
+        buffers[i].glbFile = source;
+        fileOwnedByBuffer = true;
+        break;
+    }
     
     result->numMeshes = dynarray_length(meshes);
 
@@ -1391,20 +1936,75 @@ __public int ParseGLTF(const char* path, SceneBundle* result, float scale)
     result->numBuffers    = dynarray_length(buffers);    result->buffers    = buffers;
     result->numAnimations = dynarray_length(animations); result->animations = animations;
     result->numSkins      = dynarray_length(skins);      result->skins      = skins;
+    result->nodeOrder   = FixedPow2Allocator_AllocateUninitialized(allocator, sizeof(int) * (result->numNodes + 1));
+    result->nodeParents = FixedPow2Allocator_AllocateUninitialized(allocator, sizeof(int) * (result->numNodes + 1));
     result->allocator = allocator;
     result->scale = scale;
+    FreeStructuralIndex();
+    if (!fileOwnedByBuffer) FreeAllText(source);
+
+    if (!BuildNodeHierarchy(nodes, result->numNodes, result->nodeOrder, result->nodeParents))
+    {
+        FreeSceneBundle(result);
+        result->error = AError_NODE_HIERARCHY;
+        return 0;
+    }
     result->error = AError_NONE;
-    FreeAllText(source);
     return 1;
 }
 
-__public void FreeGLTFBuffers(SceneBundle* gltf)
+__public int BuildNodeHierarchy(const ANode* nodes, int numNodes, int* order, int* parents)
 {
-    for (int i = 0; i < gltf->numBuffers; i++)
+    if (numNodes == 0)
+        return 1;
+
+    int* nodeParents = rpmalloc(sizeof(int) * numNodes);
+    int* stack       = rpmalloc(sizeof(int) * numNodes);
+    for (int i = 0; i < numNodes; i++)
+        nodeParents[i] = -1;
+
+    int valid = 1;
+    for (int i = 0; i < numNodes; i++)
+        for (int c = 0; c < nodes[i].numChildren; c++)
+        {
+            int child = nodes[i].children[c];
+            if ((unsigned)child >= (unsigned)numNodes || child == i || nodeParents[child] == i)
+                valid = 0; // out of range, self parented or listed twice by the same parent
+            else if (nodeParents[child] == -1)
+                nodeParents[child] = i; // first parent wins
+        }
+
+    int numSorted = 0;
+    for (int root = 0; root < numNodes && valid; root++)
     {
-        FreeAllText((char*)gltf->buffers[i].uri);
-        gltf->buffers[i].uri = NULL;
+        if (nodeParents[root] != -1) continue;
+        int stackLen = 0;
+        stack[stackLen++] = root;
+
+        while (stackLen > 0)
+        {
+            int nodeIndex = stack[--stackLen];
+            order[numSorted]   = nodeIndex;
+            parents[numSorted] = nodeParents[nodeIndex];
+            numSorted++;
+
+            const ANode* node = &nodes[nodeIndex];
+            // reverse push so children are visited in their original order
+            for (int c = node->numChildren - 1; c >= 0; c--)
+                if (nodeParents[node->children[c]] == nodeIndex) stack[stackLen++] = node->children[c];
+        }
     }
+    rpfree(nodeParents);
+    rpfree(stack);
+    // nodes in cycles are not reachable from the roots, order would be left partially written
+    return valid && numSorted == numNodes;
+}
+
+__public void FreeGLTFBuffers(SceneBundle* gltf)
+{
+    for (int i = 0; i < gltf->numBuffers; i++)
+        FreeGLTFBuffer(&gltf->buffers[i]);
+
     dynarray_destroy(gltf->buffers);
     gltf->numBuffers = 0;
     gltf->buffers = NULL;
@@ -1412,8 +2012,19 @@ __public void FreeGLTFBuffers(SceneBundle* gltf)
 
 __public void FreeSceneBundle(SceneBundle* gltf)
 {
+    if (gltf->mappedFile)
+    {
+        // meshes, nodes, materials... are inside of the mapped file, only vertices and indices are allocated
+        AFileUnmap((AMappedFile*)gltf->mappedFile);
+        rpfree(gltf->mappedFile);
+        if (gltf->allVertices) FreeAligned(gltf->allVertices);
+        if (gltf->allIndices)  FreeAligned(gltf->allIndices);
+        MemsetZero(gltf, sizeof(SceneBundle));
+        return;
+    }
+
     for (int i = 0; i < gltf->numBuffers; i++)
-        FreeAllText((char*)gltf->buffers[i].uri);
+        FreeGLTFBuffer(&gltf->buffers[i]);
 
     // also controls if arrays null or not
     for (int i = 0; i < gltf->numMeshes; i++)
@@ -1466,6 +2077,10 @@ const char* ParsedSceneGetError(AErrorType error)
         "UNKNOWN_DESCRIPTOR",
         "HASH_COLISSION",
         "NON_UTF8",
+        "EXT_NOT_SUPPORTED",
+        "CLOSE_BRACKETS",
+        "GLB_PARSE_FAIL",
+        "NODE_HIERARCHY",
         "MAX" };
     return SceneParseErrorToStr[error];
 }
\ No newline at end of file
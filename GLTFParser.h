@@ -39,6 +39,8 @@ enum AErrorType_
     AError_NON_UTF8,
     AError_EXT_NOT_SUPPORTED, // scenes other than GLTF, OBJ or Fbx
     AError_CloseBrackets,
+    AError_GLB_PARSE_FAIL,
+    AError_NODE_HIERARCHY, // node children are out of range or form a cycle
     AError_MAX
 };
 typedef int AErrorType;
@@ -121,6 +123,28 @@ typedef struct AMorphTarget_
     unsigned short indexes[4]; 
 } AMorphTarget;
 
+// cluster of triangles inside of a primitive, used for culling parts of the dense meshes.
+// indices of the primitive are ordered by meshlets, so each meshlet is a contiguous index range
+typedef struct AMeshlet_
+{
+    float center[3];   // bounding sphere in primitive's local space
+    float radius;
+    float coneAxis[3]; // average normal of the triangles
+    float coneCutoff;  // sin of the cone angle, 1 means cone is too wide to be back facing
+    int   indexOffset; // relative to primitive's indexOffset
+    int   numIndices;
+} AMeshlet;
+
+#define AX_MAX_LODS 4
+
+// simplified version of the primitive that uses the same vertices, lod 0 is the primitive itself
+typedef struct ALod_
+{
+    int   indexOffset; // in elements of indexType, inside of SceneBundle's allIndices
+    int   numIndices;
+    float error;       // maximum distance to the original surface, in primitive's local space
+} ALod;
+
 typedef struct APrimitive_
 {
     // pointers to binary file to lookup position, texture, normal..
@@ -132,7 +156,8 @@ typedef struct APrimitive_
     int indexType; // GraphicType_UnsignedInt, GraphicType_UnsignedShort.. 
     int numIndices;
     int numVertices;
-    int indexOffset;
+    int indexOffset; // in elements of indexType, inside of SceneBundle's allIndices
+    int baseVertex;  // indices are relative to this vertex, only abm files have non zero base vertex
     short jointType;   // GraphicType_UnsignedInt, GraphicType_UnsignedShort.. 
     short jointCount;  // per vertex bone count (joint), 1-4
     short jointStride; // lets say index data is rgba16u  [r, g, b, a, .......] stride might be bigger than joint
@@ -159,6 +184,10 @@ typedef struct APrimitive_
     AX_ALIGN(16) float max[4];
     
     AMorphTarget* morphTargets; // num morph targets is equal to mesh.num numMorphWeights
+    AMeshlet* meshlets; // built while saving abm files, null otherwise
+    int numMeshlets;
+    int numLods;        // zero if lods are not generated, see ABMSaveFlag_GenerateLods
+    ALod lods[AX_MAX_LODS];
 } APrimitive;
 
 typedef struct AMesh_
@@ -208,6 +237,7 @@ typedef struct GLTFBuffer_
 {
     void* uri;
     int byteLength;
+    char* glbFile; // < not null if uri points into BIN chunk of the .glb file, owns the file
 } GLTFBuffer;
 
 typedef struct ASkin_
@@ -286,6 +316,9 @@ typedef struct SceneBundle_
     int totalVertices;
     int totalIndices;
     float scale;
+    uint64_t allIndicesSize; // in bytes, primitives can have uint16 or uint32 indices
+    bool quantizedPositions; // vertices are AVertexQuantized or ASkinedVertexQuantized
+    bool octahedralTangents; // normal and tangent of the vertices are packed into one uint32, see PackOctahedralTangent
 
     GLTFBuffer* buffers;
 
@@ -299,7 +332,11 @@ typedef struct SceneBundle_
     AScene*     scenes;
     AAnimation* animations;
     ASkin*      skins;
+    // flattened node hierarchy, see BuildNodeHierarchy. stored in abm files so loading doesn't have to redo it
+    int*        nodeOrder;   // node indices sorted so parents precede children
+    int*        nodeParents; // parent node of nodeOrder[i], -1 for roots
     void*       allocator;
+    void*       mappedFile; // AMappedFile*, not null if loaded from mapped abm file, arrays above points into it
 } SceneBundle;
 
 typedef struct ParsedObj_
@@ -320,12 +357,17 @@ typedef struct ParsedObj_
     AImage*    images;
 } ParsedObj;
 
-// outScene should not be null
+// path can be .gltf or .glb, outScene should not be null
 int ParseGLTF(const char* path, SceneBundle* outScene, float scale);
 
 int ParseObj(const char* path, ParsedObj* scene);
 
 
+// depth first order of the nodes, parents precede children and each subtree is a contiguous range in order.
+// world matrices can be calculated in one linear loop instead of recursing through the children.
+// returns 0 if a child index is out of range or the children form a cycle
+int BuildNodeHierarchy(const ANode* nodes, int numNodes, int* order, int* parents);
+
 void FreeGLTFBuffers(SceneBundle* gltf);
 
 void FreeSceneBundle(SceneBundle* gltf);
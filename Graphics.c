@@ -218,24 +218,29 @@ void rDeleteMipData(sg_image_data* img_data, int numMips)
     rpfree((void*)img_data->subimage[0][1].ptr);
 }
 
-typedef struct ImageInfo_
-{
-    int width, height;
-    int numComp;
-    int isNormal;
-} ImageInfo;
-
 #define g_AXTextureVersion 12351
 
-static void LoadSceneImagesGeneric(const char* texturePath, Texture* textures, int numImages)
+// reads and decompresses all of the images of the .dxt file, doesn't touch the gpu so it can be called from any thread
+int rLoadSceneImagesCPU(const char* texturePath, int numImages, SceneImages* images)
 {
+    MemsetZero(images, sizeof(SceneImages));
     if (numImages == 0) {
-        return;
+        return 1;
     }
+
     AFile file = AFileOpen(texturePath, AOpenFlag_ReadBinary);
+    if (!AFileExist(file)) {
+        AX_ERROR("scene images are not exist! %s", texturePath);
+        return 0;
+    }
+
     int version = 0;
     AFileRead(&version, sizeof(int), file, 1);
-    ASSERT(version == g_AXTextureVersion); // probably using old version, find newer version of texture or reload the gltf or fbx scene
+    if (version != g_AXTextureVersion) {
+        AX_ERROR("scene image version mismatch! %s", texturePath); // probably using old version, find newer version of texture or reload the gltf or fbx scene
+        AFileClose(file);
+        return 0;
+    }
     
     ImageInfo* imageInfos = rpmalloc(sizeof(ImageInfo) * numImages);
     
@@ -250,11 +255,22 @@ static void LoadSceneImagesGeneric(const char* texturePath, Texture* textures, i
     
     unsigned char* compressedBuffer = rpmalloc(compressedSize);
     AFileRead(compressedBuffer, compressedSize, file, 1);
+    AFileClose(file);
     
     unsigned char* decompressedBuffer = rpmalloc(decompressedSize);
     decompressedSize = ZSTD_decompress(decompressedBuffer, decompressedSize, compressedBuffer, compressedSize);
-    ASSERT(!ZSTD_isError(decompressedSize));
+    rpfree(compressedBuffer);
+
+    if (ZSTD_isError(decompressedSize)) {
+        AX_ERROR("scene image decompression failed! %s", ZSTD_getErrorName(decompressedSize));
+        rpfree(imageInfos);
+        rpfree(decompressedBuffer);
+        return 0;
+    }
     
+    images->numImages = numImages;
+    images->pixels = decompressedBuffer;
+    images->images = rpcalloc(numImages, sizeof(SceneImage));
     unsigned char* currentImage = decompressedBuffer;
     
     for (int i = 0; i < numImages; i++)
@@ -294,8 +310,12 @@ static void LoadSceneImagesGeneric(const char* texturePath, Texture* textures, i
                     break;
             } 
         }
-        Texture imported = rCreateTexture(info.width, info.height, currentImage, textureType, flags, "LoadSceneImagesGeneric");
-        textures[i] = imported;
+        SceneImage* image = &images->images[i];
+        image->data   = currentImage;
+        image->width  = info.width;
+        image->height = info.height;
+        image->format = textureType;
+        image->flags  = flags;
         currentImage += imageSize;
         
         #ifdef __ANDROID__
@@ -312,9 +332,42 @@ static void LoadSceneImagesGeneric(const char* texturePath, Texture* textures, i
         #endif
     }
     
-    AFileClose(file);
-    rpfree(compressedBuffer);
-    rpfree(decompressedBuffer);
+    rpfree(imageInfos);
+    return 1;
+}
+
+// creates the gpu texture of one image, has to be called from the main thread
+Texture rUploadSceneImage(SceneImages* images, int index)
+{
+    SceneImage image = images->images[index];
+    if (image.width == 0) {
+        Texture empty;
+        MemsetZero(&empty, sizeof(Texture));
+        return empty;
+    }
+    return rCreateTexture(image.width, image.height, image.data, image.format, image.flags, "SceneImage");
+}
+
+void rFreeSceneImages(SceneImages* images)
+{
+    if (images->pixels) rpfree(images->pixels);
+    if (images->images) rpfree(images->images);
+    MemsetZero(images, sizeof(SceneImages));
+}
+
+static void LoadSceneImagesGeneric(const char* texturePath, Texture* textures, int numImages)
+{
+    SceneImages images;
+    if (!rLoadSceneImagesCPU(texturePath, numImages, &images)) {
+        return;
+    }
+
+    for (int i = 0; i < images.numImages; i++)
+    {
+        if (images.images[i].width != 0)
+            textures[i] = rUploadSceneImage(&images, i);
+    }
+    rFreeSceneImages(&images);
 }
 
 Texture rCreateTexture(int width, int height, void* data, sg_pixel_format format, TexFlags flags, const char* label)
@@ -383,5 +436,60 @@ void rDeleteTexture(Texture texture)
     sg_destroy_image(texture.handle);
 }
 
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              Instancing                                  */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+InstanceBuffer rCreateInstanceBuffer(int capacity, const char* label)
+{
+    InstanceBuffer instanceBuffer;
+    instanceBuffer.instances    = rpmalloc(sizeof(AInstance) * capacity);
+    instanceBuffer.numInstances = 0;
+    instanceBuffer.capacity     = capacity;
+    instanceBuffer.buffer = sg_make_buffer(&(sg_buffer_desc){
+        .size = sizeof(AInstance) * capacity,
+        .usage.vertex_buffer = true,
+        .usage.immutable = false,
+        .usage.stream_update = true,
+        .label = label
+    });
+    return instanceBuffer;
+}
+
+void rBeginInstances(InstanceBuffer* instanceBuffer)
+{
+    instanceBuffer->numInstances = 0;
+}
+
+int rPushInstance(InstanceBuffer* instanceBuffer, Matrix4 model, int animRow)
+{
+    if (instanceBuffer->numInstances >= instanceBuffer->capacity)
+        return -1;
+
+    int index = instanceBuffer->numInstances++;
+    AInstance* instance = &instanceBuffer->instances[index];
+    Matrix4 transposed = Matrix4Transpose(model);
+    VecStore(instance->modelRows[0], transposed.r[0]);
+    VecStore(instance->modelRows[1], transposed.r[1]);
+    VecStore(instance->modelRows[2], transposed.r[2]);
+    instance->animRow = (float)animRow;
+    instance->padding[0] = instance->padding[1] = instance->padding[2] = 0.0f;
+    return index;
+}
+
+void rUploadInstances(InstanceBuffer* instanceBuffer)
+{
+    if (instanceBuffer->numInstances == 0)
+        return;
+    sg_update_buffer(instanceBuffer->buffer, &(sg_range){ instanceBuffer->instances, sizeof(AInstance) * instanceBuffer->numInstances });
+}
+
+void rDeleteInstanceBuffer(InstanceBuffer* instanceBuffer)
+{
+    sg_destroy_buffer(instanceBuffer->buffer);
+    rpfree(instanceBuffer->instances);
+    MemsetZero(instanceBuffer, sizeof(InstanceBuffer));
+}
+
 
 #endif
\ No newline at end of file
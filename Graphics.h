@@ -2,6 +2,7 @@
 #define _H_GRAPHICS_
 
 #include "Math/Half.h"
+#include "Math/Matrix.h"
 #include "GLTFParser.h"
 
 enum TexFlags_
@@ -73,6 +74,29 @@ typedef struct ASkinedVertex_
     uint32_t weights; // rgb8u
 } ASkinedVertex;
 
+// positions are normalized to the primitive's AABB (APrimitive::min/max),
+// vertex shader dequantizes them with: min + position * (max - min)
+typedef struct AVertexQuantized_
+{
+    uint16_t position[4]; // unorm16, w is unused
+    uint32_t normal;
+    uint32_t tangent;
+    uint32_t texCoord; // half2
+} AVertexQuantized;
+
+typedef struct ASkinedVertexQuantized_
+{
+    uint16_t position[4]; // unorm16, w is unused
+    uint32_t normal;
+    uint32_t tangent;
+    uint32_t texCoord; // half2
+    uint32_t joints;  // rgb8u
+    uint32_t weights; // rgb8u
+} ASkinedVertexQuantized;
+
+// with SceneBundle::octahedralTangents normal and tangent fields of the vertices above are replaced with
+// one uint32 (PackOctahedralTangent), other attributes are shifted 4 bytes back. see SceneBundleVertexSize
+
 
 typedef struct GPUMesh_
 {
@@ -99,6 +123,47 @@ typedef struct Texture_
     void* buffer;
 } Texture;
 
+// per instance vertex data, bound to vertex buffer slot 1 with SG_VERTEXSTEP_PER_INSTANCE.
+// model matrix is transposed and the last row (0, 0, 0, 1) is dropped, vertex shader does dot(modelRows[i], position)
+typedef struct AInstance_
+{
+    float modelRows[3][4];
+    float animRow;    // row of the joint texture that has the bone matrices of the instance
+    float padding[3];
+} AInstance;
+
+// instances are pushed each frame (usually only the visible ones), then uploaded with one buffer update
+typedef struct InstanceBuffer_
+{
+    sg_buffer buffer;
+    AInstance* instances; // cpu copy
+    int numInstances;
+    int capacity;
+} InstanceBuffer;
+
+typedef struct ImageInfo_
+{
+    int width, height;
+    int numComp;
+    int isNormal;
+} ImageInfo;
+
+// cpu side of the scene images, filled by rLoadSceneImagesCPU
+typedef struct SceneImage_
+{
+    unsigned char* data; // points into SceneImages::pixels
+    int width, height;   // width is zero if image is not exist
+    sg_pixel_format format;
+    TexFlags flags;
+} SceneImage;
+
+typedef struct SceneImages_
+{
+    SceneImage* images;
+    unsigned char* pixels; // decompressed data of all images
+    int numImages;
+} SceneImages;
+
 ANode* GetNodePtr(SceneBundle* prefab, int index)
 {
     return &prefab->nodes[index];
@@ -133,16 +198,352 @@ static inline uint32_t Pack_INT_2_10_10_10_REV_VEC(Vector4x32f v)
         xs << 9  | ((uint32_t)(x * 511 + (xs << 9)) & 511);
 }
 
+// components are 10 bit two's complement integers, sign extended with the shifts
 static inline Vec3f Unpack_INT_2_10_10_10_REV(uint32_t p) 
 {
     Vec3f result;
-    const uint32_t tenMask = (1 << 10)-1;
-    result.x = 255.0f / ((p >>  0) & tenMask);
-    result.y = 255.0f / ((p >> 10) & tenMask);
-    result.z = 255.0f / ((p >> 20) & tenMask);
+    result.x = (float)((int32_t)(p << 22) >> 22) / 511.0f;
+    result.y = (float)((int32_t)(p << 12) >> 22) / 511.0f;
+    result.z = (float)((int32_t)(p <<  2) >> 22) / 511.0f;
     return result;
 }
 
+// batch versions of the packers above, 4 vertices at a time with SSE and NEON, 8 with AVX2.
+// results are bit exact with Pack_INT_2_10_10_10_REV and Pack_INT_2_10_10_10_REV_VEC
+// each component: (uint32_t)(v * scale + (sign ? offset : 0)) & mask | (sign ? offset : 0)
+#if defined(AX_SUPPORT_AVX2)
+static inline __m256i PackSigned10x8(__m256 v, __m256 scale, __m256i offset, __m256i mask)
+{
+    __m256 sign = _mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_LT_OQ);
+    __m256i signOffset = _mm256_and_si256(_mm256_castps_si256(sign), offset);
+    __m256 t = _mm256_add_ps(_mm256_mul_ps(v, scale), _mm256_cvtepi32_ps(signOffset));
+    return _mm256_or_si256(_mm256_and_si256(_mm256_cvttps_epi32(t), mask), signOffset);
+}
+
+// loads 8 Vec3f or Vector4 as SoA, xyzw of each vertex is loaded with one 16 byte load
+static inline void LoadTranspose8x4(const float* src, int stride, __m256* x, __m256* y, __m256* z, __m256* w)
+{
+    __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + stride * 0)), _mm_loadu_ps(src + stride * 4), 1);
+    __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + stride * 1)), _mm_loadu_ps(src + stride * 5), 1);
+    __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + stride * 2)), _mm_loadu_ps(src + stride * 6), 1);
+    __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + stride * 3)), _mm_loadu_ps(src + stride * 7), 1);
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1); // x0 x1 y0 y1, z0 z1 w0 w1
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3); // x2 x3 y2 y3, z2 z3 w2 w3
+    *x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    *y = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    *z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    *w = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+#elif defined(AX_SUPPORT_SSE)
+static inline __m128i PackSigned10x4(__m128 v, __m128 scale, __m128i offset, __m128i mask)
+{
+    __m128 sign = _mm_cmplt_ps(v, _mm_setzero_ps());
+    __m128i signOffset = _mm_and_si128(_mm_castps_si128(sign), offset);
+    __m128 t = _mm_add_ps(_mm_mul_ps(v, scale), _mm_cvtepi32_ps(signOffset));
+    return _mm_or_si128(_mm_and_si128(_mm_cvttps_epi32(t), mask), signOffset);
+}
+#elif defined(AX_SUPPORT_NEON)
+static inline uint32x4_t PackSigned10x4(float32x4_t v, float32x4_t scale, uint32x4_t offset, uint32x4_t mask)
+{
+    uint32x4_t signOffset = vandq_u32(vcltq_f32(v, vdupq_n_f32(0.0f)), offset);
+    float32x4_t t = vaddq_f32(vmulq_f32(v, scale), vcvtq_f32_u32(signOffset));
+    return vorrq_u32(vandq_u32(vcvtq_u32_f32(t), mask), signOffset);
+}
+#endif
+
+// packs n normals into INT_2_10_10_10_REV format, w is zero
+static inline void Pack_INT_2_10_10_10_REV_N(uint32_t* dst, const Vec3f* src, int n)
+{
+    int i = 0;
+    // each vertex is loaded with 16 byte loads, last vertex would read past the array so it is packed by the scalar loop
+#if defined(AX_SUPPORT_AVX2)
+    const __m256 scale = _mm256_set1_ps(511.0f);
+    const __m256i offset = _mm256_set1_epi32(512), mask = _mm256_set1_epi32(511);
+    for (; i + 8 < n; i += 8)
+    {
+        __m256 x, y, z, w;
+        LoadTranspose8x4(&src[i].x, 3, &x, &y, &z, &w);
+        __m256i packed = PackSigned10x8(x, scale, offset, mask);
+        packed = _mm256_or_si256(packed, _mm256_slli_epi32(PackSigned10x8(y, scale, offset, mask), 10));
+        packed = _mm256_or_si256(packed, _mm256_slli_epi32(PackSigned10x8(z, scale, offset, mask), 20));
+        _mm256_storeu_si256((__m256i*)(dst + i), packed);
+    }
+#elif defined(AX_SUPPORT_SSE)
+    const __m128 scale = _mm_set1_ps(511.0f);
+    const __m128i offset = _mm_set1_epi32(512), mask = _mm_set1_epi32(511);
+    for (; i + 4 < n; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&src[i + 0].x), y = _mm_loadu_ps(&src[i + 1].x);
+        __m128 z = _mm_loadu_ps(&src[i + 2].x), w = _mm_loadu_ps(&src[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        __m128i packed = PackSigned10x4(x, scale, offset, mask);
+        packed = _mm_or_si128(packed, _mm_slli_epi32(PackSigned10x4(y, scale, offset, mask), 10));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(PackSigned10x4(z, scale, offset, mask), 20));
+        _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+#elif defined(AX_SUPPORT_NEON)
+    const float32x4_t scale = vdupq_n_f32(511.0f);
+    const uint32x4_t offset = vdupq_n_u32(512), mask = vdupq_n_u32(511);
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4x3_t v = vld3q_f32(&src[i].x);
+        uint32x4_t packed = PackSigned10x4(v.val[0], scale, offset, mask);
+        packed = vorrq_u32(packed, vshlq_n_u32(PackSigned10x4(v.val[1], scale, offset, mask), 10));
+        packed = vorrq_u32(packed, vshlq_n_u32(PackSigned10x4(v.val[2], scale, offset, mask), 20));
+        vst1q_u32(dst + i, packed);
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = Pack_INT_2_10_10_10_REV(src[i]);
+}
+
+// packs n tangents into INT_2_10_10_10_REV format, w is the bitangent sign, src is array of float4
+static inline void Pack_INT_2_10_10_10_REV_VEC_N(uint32_t* dst, const float* src, int n)
+{
+    int i = 0;
+#if defined(AX_SUPPORT_AVX2)
+    const __m256 scale = _mm256_set1_ps(511.0f);
+    const __m256i offset = _mm256_set1_epi32(512), mask = _mm256_set1_epi32(511);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 x, y, z, w;
+        LoadTranspose8x4(src + i * 4, 4, &x, &y, &z, &w);
+        __m256i packed = PackSigned10x8(x, scale, offset, mask);
+        packed = _mm256_or_si256(packed, _mm256_slli_epi32(PackSigned10x8(y, scale, offset, mask), 10));
+        packed = _mm256_or_si256(packed, _mm256_slli_epi32(PackSigned10x8(z, scale, offset, mask), 20));
+        packed = _mm256_or_si256(packed, _mm256_slli_epi32(PackSigned10x8(w, _mm256_set1_ps(1.0f), _mm256_set1_epi32(2), _mm256_set1_epi32(1)), 30));
+        _mm256_storeu_si256((__m256i*)(dst + i), packed);
+    }
+#elif defined(AX_SUPPORT_SSE)
+    const __m128 scale = _mm_set1_ps(511.0f);
+    const __m128i offset = _mm_set1_epi32(512), mask = _mm_set1_epi32(511);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(src + i * 4 + 0), y = _mm_loadu_ps(src + i * 4 + 4);
+        __m128 z = _mm_loadu_ps(src + i * 4 + 8), w = _mm_loadu_ps(src + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        __m128i packed = PackSigned10x4(x, scale, offset, mask);
+        packed = _mm_or_si128(packed, _mm_slli_epi32(PackSigned10x4(y, scale, offset, mask), 10));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(PackSigned10x4(z, scale, offset, mask), 20));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(PackSigned10x4(w, _mm_set1_ps(1.0f), _mm_set1_epi32(2), _mm_set1_epi32(1)), 30));
+        _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+#elif defined(AX_SUPPORT_NEON)
+    const float32x4_t scale = vdupq_n_f32(511.0f);
+    const uint32x4_t offset = vdupq_n_u32(512), mask = vdupq_n_u32(511);
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4x4_t v = vld4q_f32(src + i * 4);
+        uint32x4_t packed = PackSigned10x4(v.val[0], scale, offset, mask);
+        packed = vorrq_u32(packed, vshlq_n_u32(PackSigned10x4(v.val[1], scale, offset, mask), 10));
+        packed = vorrq_u32(packed, vshlq_n_u32(PackSigned10x4(v.val[2], scale, offset, mask), 20));
+        packed = vorrq_u32(packed, vshlq_n_u32(PackSigned10x4(v.val[3], vdupq_n_f32(1.0f), vdupq_n_u32(2), vdupq_n_u32(1)), 30));
+        vst1q_u32(dst + i, packed);
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = Pack_INT_2_10_10_10_REV_VEC(VecLoad(src + i * 4));
+}
+
+// converts n Vec2f to half2, same as ConvertFloat2ToHalf2 for each element. uses F16C with AVX2
+static inline void ConvertFloat2ToHalf2N(half2* dst, const Vec2f* src, int n)
+{
+    ConvertFloatToHalfN((half*)dst, &src->x, n * 2);
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                     Octahedral Normal Tangent                            */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+// normal and tangent frame in 32 bits, decoded by vs_oct in Shaders/Cube.glsl:
+// bits 0-9 and 10-19: octahedral normal xy (unorm10), 20-30: tangent on a diamond around the normal (unorm11), 31: bitangent sign.
+// tangent is encoded in a basis that is built from the decoded normal, so the vertex shader builds the exact same basis.
+// A Survey of Efficient Representations for Independent Unit Vectors, Cigolle et al. 2014
+// Building an Orthonormal Basis, Revisited, Duff et al. 2017
+#define AX_OCT_NORMAL_MAX  1023.0f
+#define AX_OCT_TANGENT_MAX 2048.0f
+
+// normal and tangent doesn't have to be normalized, tangent.w is the bitangent sign
+static inline uint32_t PackOctahedralTangent(Vec3f normal, const float* tangent)
+{
+    float invL = 1.0f / MMAX(Absf(normal.x) + Absf(normal.y) + Absf(normal.z), 1e-20f);
+    float ox = normal.x * invL, oy = normal.y * invL;
+    if (normal.z < 0.0f) {
+        float fx = CopySignf(1.0f - Absf(oy), ox);
+        oy = CopySignf(1.0f - Absf(ox), oy);
+        ox = fx;
+    }
+    float qx = (float)(int)((ox * 0.5f + 0.5f) * AX_OCT_NORMAL_MAX + 0.5f);
+    float qy = (float)(int)((oy * 0.5f + 0.5f) * AX_OCT_NORMAL_MAX + 0.5f);
+
+    // decode the normal same as the shader, upper hemisphere test is exact because q's are integers
+    float dx = qx * (2.0f / AX_OCT_NORMAL_MAX) - 1.0f, dy = qy * (2.0f / AX_OCT_NORMAL_MAX) - 1.0f;
+    float dz = 1.0f - Absf(dx) - Absf(dy);
+    bool upper = Absf(2.0f * qx - AX_OCT_NORMAL_MAX) + Absf(2.0f * qy - AX_OCT_NORMAL_MAX) <= AX_OCT_NORMAL_MAX;
+    if (!upper) {
+        float fx = CopySignf(1.0f - Absf(dy), dx);
+        dy = CopySignf(1.0f - Absf(dx), dy);
+        dx = fx;
+    }
+    float invLen = 1.0f / Sqrtf(dx * dx + dy * dy + dz * dz);
+    dx *= invLen; dy *= invLen; dz *= invLen;
+
+    float s = upper ? 1.0f : -1.0f;
+    float a = -1.0f / (s + dz);
+    float b = dx * dy * a;
+    float u = tangent[0] * (1.0f + s * dx * dx * a) + tangent[1] * (s * b)            - tangent[2] * (s * dx);
+    float v = tangent[0] * b                        + tangent[1] * (s + dy * dy * a) - tangent[2] * dy;
+
+    float invS = 1.0f / MMAX(Absf(u) + Absf(v), 1e-20f);
+    u *= invS; v *= invS;
+    float p = v >= 0.0f ? (u >= 0.0f ? v : 1.0f - u) : (u < 0.0f ? 2.0f - v : 3.0f + u);
+    uint32_t qt = (uint32_t)(p * (AX_OCT_TANGENT_MAX / 4.0f) + 0.5f) & 2047u;
+
+    return (uint32_t)qx | (uint32_t)qy << 10 | qt << 20 | (uint32_t)(tangent[3] < 0.0f) << 31;
+}
+
+// batch version of PackOctahedralTangent, 8 vertices at a time with AVX2, 4 with SSE. NEON uses the scalar path.
+// src tangents are array of float4, results may differ from the scalar version by one quantization step because of fma contraction
+static inline void PackOctahedralTangentN(uint32_t* dst, const Vec3f* normals, const float* tangents, int n)
+{
+    int i = 0;
+#if defined(AX_SUPPORT_AVX2)
+    const __m256 one = _mm256_set1_ps(1.0f), half = _mm256_set1_ps(0.5f), zero = _mm256_setzero_ps();
+    const __m256 signMask = _mm256_set1_ps(-0.0f), tiny = _mm256_set1_ps(1e-20f);
+    const __m256 normalMax = _mm256_set1_ps(AX_OCT_NORMAL_MAX), decodeScale = _mm256_set1_ps(2.0f / AX_OCT_NORMAL_MAX);
+    #define AX_ABS8(x) _mm256_andnot_ps(signMask, x)
+    #define AX_COPYSIGN8(x, s) _mm256_or_ps(AX_ABS8(x), _mm256_and_ps(signMask, s))
+    // each normal is loaded with 16 byte loads, last vertex would read past the array so it is packed by the scalar loop
+    for (; i + 8 < n; i += 8)
+    {
+        __m256 nx, ny, nz, nw, tx, ty, tz, tw;
+        LoadTranspose8x4(&normals[i].x, 3, &nx, &ny, &nz, &nw);
+        LoadTranspose8x4(tangents + i * 4, 4, &tx, &ty, &tz, &tw);
+
+        __m256 invL = _mm256_div_ps(one, _mm256_max_ps(_mm256_add_ps(_mm256_add_ps(AX_ABS8(nx), AX_ABS8(ny)), AX_ABS8(nz)), tiny));
+        __m256 ox = _mm256_mul_ps(nx, invL), oy = _mm256_mul_ps(ny, invL);
+        __m256 lower = _mm256_cmp_ps(nz, zero, _CMP_LT_OQ);
+        __m256 fx = AX_COPYSIGN8(_mm256_sub_ps(one, AX_ABS8(oy)), ox);
+        __m256 fy = AX_COPYSIGN8(_mm256_sub_ps(one, AX_ABS8(ox)), oy);
+        ox = _mm256_blendv_ps(ox, fx, lower);
+        oy = _mm256_blendv_ps(oy, fy, lower);
+        __m256i iqx = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(ox, half), half), normalMax), half));
+        __m256i iqy = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(oy, half), half), normalMax), half));
+        __m256 qx = _mm256_cvtepi32_ps(iqx), qy = _mm256_cvtepi32_ps(iqy);
+
+        __m256 dx = _mm256_sub_ps(_mm256_mul_ps(qx, decodeScale), one);
+        __m256 dy = _mm256_sub_ps(_mm256_mul_ps(qy, decodeScale), one);
+        __m256 dz = _mm256_sub_ps(_mm256_sub_ps(one, AX_ABS8(dx)), AX_ABS8(dy));
+        __m256 ex = AX_ABS8(_mm256_sub_ps(_mm256_add_ps(qx, qx), normalMax));
+        __m256 ey = AX_ABS8(_mm256_sub_ps(_mm256_add_ps(qy, qy), normalMax));
+        __m256 upper = _mm256_cmp_ps(_mm256_add_ps(ex, ey), normalMax, _CMP_LE_OQ);
+        fx = AX_COPYSIGN8(_mm256_sub_ps(one, AX_ABS8(dy)), dx);
+        fy = AX_COPYSIGN8(_mm256_sub_ps(one, AX_ABS8(dx)), dy);
+        dx = _mm256_blendv_ps(fx, dx, upper);
+        dy = _mm256_blendv_ps(fy, dy, upper);
+        __m256 invLen = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz))));
+        dx = _mm256_mul_ps(dx, invLen); dy = _mm256_mul_ps(dy, invLen); dz = _mm256_mul_ps(dz, invLen);
+
+        __m256 s = _mm256_blendv_ps(_mm256_set1_ps(-1.0f), one, upper);
+        __m256 a = _mm256_div_ps(_mm256_set1_ps(-1.0f), _mm256_add_ps(s, dz));
+        __m256 b = _mm256_mul_ps(_mm256_mul_ps(dx, dy), a);
+        __m256 sdx = _mm256_mul_ps(s, dx);
+        __m256 u = _mm256_mul_ps(tx, _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(sdx, dx), a)));
+        u = _mm256_add_ps(u, _mm256_mul_ps(ty, _mm256_mul_ps(s, b)));
+        u = _mm256_sub_ps(u, _mm256_mul_ps(tz, sdx));
+        __m256 v = _mm256_mul_ps(tx, b);
+        v = _mm256_add_ps(v, _mm256_mul_ps(ty, _mm256_add_ps(s, _mm256_mul_ps(_mm256_mul_ps(dy, dy), a))));
+        v = _mm256_sub_ps(v, _mm256_mul_ps(tz, dy));
+
+        __m256 invS = _mm256_div_ps(one, _mm256_max_ps(_mm256_add_ps(AX_ABS8(u), AX_ABS8(v)), tiny));
+        u = _mm256_mul_ps(u, invS); v = _mm256_mul_ps(v, invS);
+        __m256 uPositive = _mm256_cmp_ps(u, zero, _CMP_GE_OQ);
+        __m256 pTop    = _mm256_blendv_ps(_mm256_sub_ps(one, u), v, uPositive);                                 // v >= 0
+        __m256 pBottom = _mm256_blendv_ps(_mm256_sub_ps(_mm256_set1_ps(2.0f), v), _mm256_add_ps(_mm256_set1_ps(3.0f), u), uPositive);
+        __m256 p = _mm256_blendv_ps(pBottom, pTop, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+        __m256i qt = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(p, _mm256_set1_ps(AX_OCT_TANGENT_MAX / 4.0f)), half));
+        qt = _mm256_and_si256(qt, _mm256_set1_epi32(2047));
+
+        __m256i packed = _mm256_or_si256(iqx, _mm256_slli_epi32(iqy, 10));
+        packed = _mm256_or_si256(packed, _mm256_slli_epi32(qt, 20));
+        packed = _mm256_or_si256(packed, _mm256_slli_epi32(_mm256_castps_si256(_mm256_cmp_ps(tw, zero, _CMP_LT_OQ)), 31));
+        _mm256_storeu_si256((__m256i*)(dst + i), packed);
+    }
+    #undef AX_ABS8
+    #undef AX_COPYSIGN8
+#elif defined(AX_SUPPORT_SSE)
+    const __m128 one = _mm_set1_ps(1.0f), half = _mm_set1_ps(0.5f), zero = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.0f), tiny = _mm_set1_ps(1e-20f);
+    const __m128 normalMax = _mm_set1_ps(AX_OCT_NORMAL_MAX), decodeScale = _mm_set1_ps(2.0f / AX_OCT_NORMAL_MAX);
+    #define AX_ABS4(x) _mm_andnot_ps(signMask, x)
+    #define AX_COPYSIGN4(x, s) _mm_or_ps(AX_ABS4(x), _mm_and_ps(signMask, s))
+    #define AX_SELECT4(a, b, mask) _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b)) /* mask ? b : a, SSE2 has no blendv */
+    for (; i + 4 < n; i += 4)
+    {
+        __m128 nx = _mm_loadu_ps(&normals[i + 0].x), ny = _mm_loadu_ps(&normals[i + 1].x);
+        __m128 nz = _mm_loadu_ps(&normals[i + 2].x), nw = _mm_loadu_ps(&normals[i + 3].x);
+        _MM_TRANSPOSE4_PS(nx, ny, nz, nw);
+        __m128 tx = _mm_loadu_ps(tangents + i * 4 + 0), ty = _mm_loadu_ps(tangents + i * 4 + 4);
+        __m128 tz = _mm_loadu_ps(tangents + i * 4 + 8), tw = _mm_loadu_ps(tangents + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(tx, ty, tz, tw);
+
+        __m128 invL = _mm_div_ps(one, _mm_max_ps(_mm_add_ps(_mm_add_ps(AX_ABS4(nx), AX_ABS4(ny)), AX_ABS4(nz)), tiny));
+        __m128 ox = _mm_mul_ps(nx, invL), oy = _mm_mul_ps(ny, invL);
+        __m128 lower = _mm_cmplt_ps(nz, zero);
+        __m128 fx = AX_COPYSIGN4(_mm_sub_ps(one, AX_ABS4(oy)), ox);
+        __m128 fy = AX_COPYSIGN4(_mm_sub_ps(one, AX_ABS4(ox)), oy);
+        ox = AX_SELECT4(ox, fx, lower);
+        oy = AX_SELECT4(oy, fy, lower);
+        __m128i iqx = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(ox, half), half), normalMax), half));
+        __m128i iqy = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(oy, half), half), normalMax), half));
+        __m128 qx = _mm_cvtepi32_ps(iqx), qy = _mm_cvtepi32_ps(iqy);
+
+        __m128 dx = _mm_sub_ps(_mm_mul_ps(qx, decodeScale), one);
+        __m128 dy = _mm_sub_ps(_mm_mul_ps(qy, decodeScale), one);
+        __m128 dz = _mm_sub_ps(_mm_sub_ps(one, AX_ABS4(dx)), AX_ABS4(dy));
+        __m128 ex = AX_ABS4(_mm_sub_ps(_mm_add_ps(qx, qx), normalMax));
+        __m128 ey = AX_ABS4(_mm_sub_ps(_mm_add_ps(qy, qy), normalMax));
+        __m128 upper = _mm_cmple_ps(_mm_add_ps(ex, ey), normalMax);
+        fx = AX_COPYSIGN4(_mm_sub_ps(one, AX_ABS4(dy)), dx);
+        fy = AX_COPYSIGN4(_mm_sub_ps(one, AX_ABS4(dx)), dy);
+        dx = AX_SELECT4(fx, dx, upper);
+        dy = AX_SELECT4(fy, dy, upper);
+        __m128 invLen = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz))));
+        dx = _mm_mul_ps(dx, invLen); dy = _mm_mul_ps(dy, invLen); dz = _mm_mul_ps(dz, invLen);
+
+        __m128 s = AX_SELECT4(_mm_set1_ps(-1.0f), one, upper);
+        __m128 a = _mm_div_ps(_mm_set1_ps(-1.0f), _mm_add_ps(s, dz));
+        __m128 b = _mm_mul_ps(_mm_mul_ps(dx, dy), a);
+        __m128 sdx = _mm_mul_ps(s, dx);
+        __m128 u = _mm_mul_ps(tx, _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(sdx, dx), a)));
+        u = _mm_add_ps(u, _mm_mul_ps(ty, _mm_mul_ps(s, b)));
+        u = _mm_sub_ps(u, _mm_mul_ps(tz, sdx));
+        __m128 v = _mm_mul_ps(tx, b);
+        v = _mm_add_ps(v, _mm_mul_ps(ty, _mm_add_ps(s, _mm_mul_ps(_mm_mul_ps(dy, dy), a))));
+        v = _mm_sub_ps(v, _mm_mul_ps(tz, dy));
+
+        __m128 invS = _mm_div_ps(one, _mm_max_ps(_mm_add_ps(AX_ABS4(u), AX_ABS4(v)), tiny));
+        u = _mm_mul_ps(u, invS); v = _mm_mul_ps(v, invS);
+        __m128 uPositive = _mm_cmpge_ps(u, zero);
+        __m128 pTop    = AX_SELECT4(_mm_sub_ps(one, u), v, uPositive);                                 // v >= 0
+        __m128 pBottom = AX_SELECT4(_mm_sub_ps(_mm_set1_ps(2.0f), v), _mm_add_ps(_mm_set1_ps(3.0f), u), uPositive);
+        __m128 p = AX_SELECT4(pBottom, pTop, _mm_cmpge_ps(v, zero));
+        __m128i qt = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(p, _mm_set1_ps(AX_OCT_TANGENT_MAX / 4.0f)), half));
+        qt = _mm_and_si128(qt, _mm_set1_epi32(2047));
+
+        __m128i packed = _mm_or_si128(iqx, _mm_slli_epi32(iqy, 10));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(qt, 20));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(_mm_castps_si128(_mm_cmplt_ps(tw, zero)), 31));
+        _mm_storeu_si128((__m128i*)(dst + i), packed);
+    }
+    #undef AX_ABS4
+    #undef AX_COPYSIGN4
+    #undef AX_SELECT4
+#endif
+    for (; i < n; i++)
+        dst[i] = PackOctahedralTangent(normals[i], tangents + i * 4);
+}
+
 
 uint8_t rTextureTypeToBytesPerPixel(sg_pixel_format type);
 
@@ -160,6 +561,27 @@ Texture rCreateTexture(int width, int height, void* data, sg_pixel_format format
 
 void rDeleteTexture(Texture texture);
 
+// thread safe, reads and decompresses the .dxt file without touching the gpu
+int rLoadSceneImagesCPU(const char* texturePath, int numImages, SceneImages* images);
+
+// main thread only, creates the texture of the image at index
+Texture rUploadSceneImage(SceneImages* images, int index);
+
+void rFreeSceneImages(SceneImages* images);
+
+InstanceBuffer rCreateInstanceBuffer(int capacity, const char* label);
+
+// removes all of the instances, call before pushing the instances of the frame
+void rBeginInstances(InstanceBuffer* instanceBuffer);
+
+// returns the index of the instance or -1 if the buffer is full
+int rPushInstance(InstanceBuffer* instanceBuffer, Matrix4 model, int animRow);
+
+// buffer can be updated once per frame
+void rUploadInstances(InstanceBuffer* instanceBuffer);
+
+void rDeleteInstanceBuffer(InstanceBuffer* instanceBuffer);
+
 
 // // w value is undefined, it could be anything or trash data
 // static inline Vector4x32f GetPosition(GPUMesh* gpu, int index)
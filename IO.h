@@ -12,6 +12,8 @@
 // void   AFileClose(AFile file);
 // bool   AFileExist(AFile file);
 // uint64 AFileSize(AFile file);
+// AMappedFile AFileMap(const char* fileName); // < copy on write mapping of the entire file
+// void   AFileUnmap(AMappedFile* mapped);
 
 // char*  GetFileExtension(path, size);
 // bool   FileHasExtension(path, size, extension);
@@ -46,6 +48,7 @@
     #include <sys/types.h>
     #include <fcntl.h>
     #include <dirent.h>
+    #include <sys/mman.h>
     #define _rmdir rmdir
     #define _mkdir mkdir
     #define _fileno fileno
@@ -318,6 +321,75 @@ inline uint64_t AFileSize(AFile file)
 
 #endif
 
+typedef struct AMappedFile_ {
+    char*    data;
+    uint64_t size;
+#ifdef _WIN32
+    void*    fileHandle;
+    void*    mappingHandle;
+#endif
+} AMappedFile;
+
+// maps entire file into memory as copy on write, so data is writable but changes never goes to the disk.
+// returned data is page aligned, data is NULL if file is not exist
+inline AMappedFile AFileMap(const char* fileName)
+{
+    AMappedFile mapped;
+    MemsetZero(&mapped, sizeof(AMappedFile));
+#ifdef __ANDROID__
+    // assets are inside of the apk, we can't map them copy on write. read at once instead
+    AAsset* asset = AAssetManager_open(g_android_app->activity->assetManager, fileName, AASSET_MODE_BUFFER);
+    if (asset == nullptr) return mapped;
+    mapped.size = AAsset_getLength64(asset);
+    mapped.data = (char*)rpmalloc(mapped.size);
+    AAsset_read(asset, mapped.data, mapped.size);
+    AAsset_close(asset);
+#elif defined(_WIN32)
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return mapped;
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping == NULL) { CloseHandle(file); return mapped; }
+
+    mapped.data = (char*)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (mapped.data == NULL) { CloseHandle(mapping); CloseHandle(file); return mapped; }
+    mapped.size = (uint64_t)fileSize.QuadPart;
+    mapped.fileHandle = file;
+    mapped.mappingHandle = mapping;
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd == -1) return mapped;
+
+    struct stat sb;
+    fstat(fd, &sb);
+    void* data = mmap(NULL, (size_t)sb.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // mapping keeps a reference to the file
+    if (data == MAP_FAILED) return mapped;
+
+    mapped.data = (char*)data;
+    mapped.size = (uint64_t)sb.st_size;
+#endif
+    return mapped;
+}
+
+inline void AFileUnmap(AMappedFile* mapped)
+{
+    if (mapped->data == NULL) return;
+#ifdef __ANDROID__
+    rpfree(mapped->data);
+#elif defined(_WIN32)
+    UnmapViewOfFile(mapped->data);
+    CloseHandle((HANDLE)mapped->mappingHandle);
+    CloseHandle((HANDLE)mapped->fileHandle);
+#else
+    munmap(mapped->data, (size_t)mapped->size);
+#endif
+    MemsetZero(mapped, sizeof(AMappedFile));
+}
+
 inline char* ReadAllFile(const char* fileName, char* buffer)
 {
     AFile file = AFileOpen(fileName, AOpenFlag_ReadBinary);
@@ -0,0 +1,318 @@
+/********************************************************************************
+*    Purpose: Job system with per worker work stealing (Chase-Lev) deques,      *
+*             counters for waiting and dependencies and parallel for            *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#include "JobSystem.h"
+#include "Thread.h"
+#include "Memory.h"
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                          Work Stealing Deque                             */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+// Dynamic Circular Work-Stealing Deque, Chase and Lev 2005
+// Correct and Efficient Work-Stealing for Weak Memory Models, Le et al. 2013
+// owner pushes and pops from the bottom, other threads steals from the top
+typedef struct AJobQueue_
+{
+    AX_ALIGN(64) volatile c89atomic_int64 top;
+    AX_ALIGN(64) volatile c89atomic_int64 bottom;
+    AX_ALIGN(64) AJob jobs[AX_JOB_QUEUE_SIZE];
+} AJobQueue;
+
+static void JobQueue_Push(AJobQueue* queue, AJob job)
+{
+    int64_t b = c89atomic_load_explicit_i64(&queue->bottom, c89atomic_memory_order_relaxed);
+    int64_t t = c89atomic_load_explicit_i64(&queue->top, c89atomic_memory_order_acquire);
+    ASSERT(b - t < AX_JOB_QUEUE_SIZE); // too many jobs, increase AX_JOB_QUEUE_SIZE
+    (void)t;
+    queue->jobs[b & (AX_JOB_QUEUE_SIZE - 1)] = job;
+    c89atomic_thread_fence(c89atomic_memory_order_release);
+    c89atomic_store_explicit_i64(&queue->bottom, b + 1, c89atomic_memory_order_relaxed);
+}
+
+static bool JobQueue_Pop(AJobQueue* queue, AJob* job)
+{
+    int64_t b = c89atomic_load_explicit_i64(&queue->bottom, c89atomic_memory_order_relaxed) - 1;
+    c89atomic_store_explicit_i64(&queue->bottom, b, c89atomic_memory_order_relaxed);
+    c89atomic_thread_fence(c89atomic_memory_order_seq_cst);
+    int64_t t = c89atomic_load_explicit_i64(&queue->top, c89atomic_memory_order_relaxed);
+
+    if (t > b) // empty
+    {
+        c89atomic_store_explicit_i64(&queue->bottom, b + 1, c89atomic_memory_order_relaxed);
+        return false;
+    }
+
+    *job = queue->jobs[b & (AX_JOB_QUEUE_SIZE - 1)];
+    if (t != b) 
+        return true;
+    
+    // last element, race with the thieves
+    bool won = c89atomic_compare_exchange_strong_explicit_i64(&queue->top, &t, t + 1, 
+                                                              c89atomic_memory_order_seq_cst, 
+                                                              c89atomic_memory_order_relaxed);
+    c89atomic_store_explicit_i64(&queue->bottom, b + 1, c89atomic_memory_order_relaxed);
+    return won;
+}
+
+static bool JobQueue_Steal(AJobQueue* queue, AJob* job)
+{
+    int64_t t = c89atomic_load_explicit_i64(&queue->top, c89atomic_memory_order_acquire);
+    c89atomic_thread_fence(c89atomic_memory_order_seq_cst);
+    int64_t b = c89atomic_load_explicit_i64(&queue->bottom, c89atomic_memory_order_acquire);
+    
+    if (t >= b) // empty
+        return false;
+    
+    *job = queue->jobs[t & (AX_JOB_QUEUE_SIZE - 1)];
+    return c89atomic_compare_exchange_strong_explicit_i64(&queue->top, &t, t + 1, 
+                                                          c89atomic_memory_order_seq_cst, 
+                                                          c89atomic_memory_order_relaxed);
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                               Job System                                 */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+typedef struct JobSystem_
+{
+    // queue 0 is main thread's, 1..numThreads-1 are workers, last one is for the threads
+    // that are not part of the job system (asset streaming etc.) guarded by externalMutex
+    AJobQueue* queues;
+    AThread threads[AX_MAX_THREADS];
+    int numThreads; // workers + main thread
+
+    AMutex externalMutex;
+    ASemaphore wakeSemaphore;
+    volatile c89atomic_uint32 numSleeping;
+    volatile c89atomic_uint32 quit;
+} JobSystem;
+
+static JobSystem g_JobSystem = { 0 };
+
+// -1 for the threads that are not created by the job system
+static AX_THREAD_LOCAL int g_JobThreadIndex = -1;
+
+static void JobSystem_PushJob(AJob job)
+{
+    int index = g_JobThreadIndex;
+    if (index >= 0)
+    {
+        JobQueue_Push(&g_JobSystem.queues[index], job);
+    }
+    else
+    {
+        AMutex_Lock(&g_JobSystem.externalMutex);
+        JobQueue_Push(&g_JobSystem.queues[g_JobSystem.numThreads], job);
+        AMutex_Unlock(&g_JobSystem.externalMutex);
+    }
+
+    if (c89atomic_load_32(&g_JobSystem.numSleeping) > 0)
+        ASemaphore_Post(&g_JobSystem.wakeSemaphore);
+}
+
+static bool JobSystem_FindJob(AJob* job)
+{
+    int self = g_JobThreadIndex;
+    if (self >= 0 && JobQueue_Pop(&g_JobSystem.queues[self], job))
+        return true;
+    
+    // try to steal from others, starting from the next thread to spread the contention
+    int numQueues = g_JobSystem.numThreads + 1;
+    int start = self >= 0 ? self + 1 : 0;
+    for (int i = 0; i < numQueues; i++)
+    {
+        int victim = (start + i) % numQueues;
+        if (victim != self && JobQueue_Steal(&g_JobSystem.queues[victim], job))
+            return true;
+    }
+    return false;
+}
+
+static void JobSystem_Execute(AJob job)
+{
+    job.fn(job.data);
+    if (job.counter) 
+        c89atomic_fetch_sub_32(&job.counter->value, 1);
+}
+
+// returns true if a job is executed
+static bool JobSystem_ExecuteOne(void)
+{
+    AJob job;
+    if (!JobSystem_FindJob(&job))
+        return false;
+    
+    // not ready yet, help to finish the dependency. putting the job back to the queue 
+    // could livelock because owner pops the same job again from the bottom
+    if (job.dependency)
+        JobSystem_Wait(job.dependency);
+
+    JobSystem_Execute(job);
+    return true;
+}
+
+static void JobSystem_Worker(void* data)
+{
+    g_JobThreadIndex = (int)(intptr_t)data;
+    int numFails = 0;
+    
+    while (!c89atomic_load_32(&g_JobSystem.quit))
+    {
+        if (JobSystem_ExecuteOne()) {
+            numFails = 0;
+            continue;
+        }
+
+        if (++numFails < 64) {
+            AThread_Yield();
+            continue;
+        }
+
+        // sleep until a job is pushed, pusher checks numSleeping after pushing, 
+        // so either we see the job below or pusher sees us sleeping
+        c89atomic_fetch_add_32(&g_JobSystem.numSleeping, 1);
+        if (!JobSystem_ExecuteOne())
+            ASemaphore_Wait(&g_JobSystem.wakeSemaphore);
+        c89atomic_fetch_sub_32(&g_JobSystem.numSleeping, 1);
+        numFails = 0;
+    }
+}
+
+void JobSystem_Init(int numWorkers)
+{
+    if (numWorkers <= 0)
+        numWorkers = GetNumCores() - 1;
+    numWorkers = MMIN(numWorkers, AX_MAX_THREADS - 1);
+
+    g_JobSystem.numThreads = numWorkers + 1;
+    g_JobSystem.numSleeping = 0;
+    g_JobSystem.quit = 0;
+    
+    int numQueues = g_JobSystem.numThreads + 1; // +1 for external threads
+    g_JobSystem.queues = AllocAligned(sizeof(AJobQueue) * numQueues, 64);
+    MemsetZero(g_JobSystem.queues, sizeof(AJobQueue) * numQueues);
+    
+    AMutex_Init(&g_JobSystem.externalMutex);
+    ASemaphore_Init(&g_JobSystem.wakeSemaphore, 0);
+
+    g_JobThreadIndex = 0; // main thread
+    for (int i = 1; i < g_JobSystem.numThreads; i++)
+    {
+        g_JobSystem.threads[i] = AThread_Create(JobSystem_Worker, (void*)(intptr_t)i);
+    }
+}
+
+void JobSystem_Destroy(void)
+{
+    if (g_JobSystem.numThreads == 0)
+        return;
+
+    c89atomic_store_32(&g_JobSystem.quit, 1);
+    for (int i = 1; i < g_JobSystem.numThreads; i++)
+        ASemaphore_Post(&g_JobSystem.wakeSemaphore);
+    
+    for (int i = 1; i < g_JobSystem.numThreads; i++)
+        AThread_Join(g_JobSystem.threads[i]);
+    
+    AMutex_Destroy(&g_JobSystem.externalMutex);
+    ASemaphore_Destroy(&g_JobSystem.wakeSemaphore);
+    FreeAligned(g_JobSystem.queues);
+    g_JobSystem.queues = NULL;
+    g_JobSystem.numThreads = 0;
+    g_JobThreadIndex = -1;
+}
+
+void JobSystem_RunAfter(AJobCounter* dependency, AJobFn fn, void* data, AJobCounter* counter)
+{
+    AJob job = { fn, data, counter, dependency };
+    
+    if (g_JobSystem.numThreads == 0) 
+    {
+        ASSERT(dependency == NULL || JobSystem_IsDone(dependency)); // nobody can finish the dependency
+        fn(data);
+        return;
+    }
+
+    if (counter) 
+        c89atomic_fetch_add_32(&counter->value, 1);
+    
+    JobSystem_PushJob(job);
+}
+
+void JobSystem_Run(AJobFn fn, void* data, AJobCounter* counter)
+{
+    JobSystem_RunAfter(NULL, fn, data, counter);
+}
+
+bool JobSystem_IsDone(AJobCounter* counter)
+{
+    return c89atomic_load_32(&counter->value) == 0;
+}
+
+void JobSystem_Wait(AJobCounter* counter)
+{
+    while (!JobSystem_IsDone(counter))
+    {
+        if (!JobSystem_ExecuteOne())
+            AThread_Yield();
+    }
+}
+
+int JobSystem_NumThreads(void)
+{
+    return MMAX(g_JobSystem.numThreads, 1);
+}
+
+typedef struct AParallelForBatch_
+{
+    AParallelForFn fn;
+    void* data;
+    int begin, end;
+} AParallelForBatch;
+
+static void JobSystem_ParallelForBatch(void* data)
+{
+    AParallelForBatch* batch = (AParallelForBatch*)data;
+    batch->fn(batch->data, batch->begin, batch->end);
+}
+
+void JobSystem_ParallelFor(int count, int batchSize, AParallelForFn fn, void* data)
+{
+    if (count <= 0)
+        return;
+
+    int numThreads = JobSystem_NumThreads();
+    if (batchSize <= 0) // a few batches per thread for load balancing
+        batchSize = MMAX(count / (numThreads * 4), 1);
+    
+    // don't overflow the job queue
+    batchSize = MMAX(batchSize, (count + (AX_JOB_QUEUE_SIZE / 2) - 1) / (AX_JOB_QUEUE_SIZE / 2));
+
+    int numBatches = (count + batchSize - 1) / batchSize;
+    if (numThreads == 1 || numBatches == 1)
+    {
+        fn(data, 0, count);
+        return;
+    }
+
+    AParallelForBatch* batches = rpmalloc(sizeof(AParallelForBatch) * numBatches);
+    AJobCounter counter = { 0 };
+
+    // first batch is executed by calling thread
+    for (int i = 1; i < numBatches; i++)
+    {
+        batches[i].fn    = fn;
+        batches[i].data  = data;
+        batches[i].begin = i * batchSize;
+        batches[i].end   = MMIN(count, (i + 1) * batchSize);
+        JobSystem_Run(JobSystem_ParallelForBatch, &batches[i], &counter);
+    }
+
+    fn(data, 0, batchSize);
+    JobSystem_Wait(&counter);
+    rpfree(batches);
+}
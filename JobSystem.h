@@ -0,0 +1,57 @@
+/********************************************************************************
+*    Purpose: Job system with per worker work stealing (Chase-Lev) deques,      *
+*             counters for waiting and dependencies and parallel for            *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#pragma once
+
+// void JobSystem_Init(numWorkers);  // 0 or negative: numCores - 1 workers, call from main thread
+// void JobSystem_Destroy();
+// void JobSystem_Run(fn, data, counter);                 // counter can be null
+// void JobSystem_RunAfter(dependency, fn, data, counter); // job starts after dependency reaches zero
+// void JobSystem_Wait(counter);                          // executes other jobs while waiting
+// void JobSystem_ParallelFor(count, batchSize, fn, data); // blocks until all iterations are done
+// int  JobSystem_NumThreads();                           // workers + main thread
+
+#include "Common.h"
+#include "Extern/c89atomic.h"
+
+#define AX_JOB_QUEUE_SIZE 4096 // per thread, must be power of two
+
+typedef void(*AJobFn)(void* data);
+
+// [begin, end) range of the iterations
+typedef void(*AParallelForFn)(void* data, int begin, int end);
+
+// number of unfinished jobs, zero initialize before use
+typedef struct AJobCounter_
+{
+    volatile c89atomic_uint32 value;
+} AJobCounter;
+
+typedef struct AJob_
+{
+    AJobFn fn;
+    void* data;
+    AJobCounter* counter;    // decremented when the job is finished
+    AJobCounter* dependency; // job waits until this reaches zero
+} AJob;
+
+void JobSystem_Init(int numWorkers);
+
+void JobSystem_Destroy(void);
+
+// runs immediately on the calling thread if the job system is not initialized
+void JobSystem_Run(AJobFn fn, void* data, AJobCounter* counter);
+
+void JobSystem_RunAfter(AJobCounter* dependency, AJobFn fn, void* data, AJobCounter* counter);
+
+void JobSystem_Wait(AJobCounter* counter);
+
+bool JobSystem_IsDone(AJobCounter* counter);
+
+// batchSize <= 0 picks a batch size depending on number of threads
+void JobSystem_ParallelFor(int count, int batchSize, AParallelForFn fn, void* data);
+
+int JobSystem_NumThreads(void);
@@ -43,17 +43,38 @@
 #include "Shaders/Cube.glsl.h"
 
 #include "Platform.c"
+#include "JobSystem.c"
 #include "Graphics.c"
 #include "GLTFParser.c"
+#include "Meshlet.c"
+#include "MeshOptimize.c"
+#include "MeshLod.c"
 #include "Animation.c"
 #include "AssetManager.c"
+#include "AssetStream.c"
 
 static struct {
     float rx, ry;
     sg_pipeline pip;
+    sg_pipeline pip16; // same as pip but with uint16 indices
+    sg_shader shader;
     sg_bindings bind;
+    int numDrawnPrimitives;  // primitives that passed the frustum culling last frame
+    int numCulledPrimitives;
+    int numVisibleInstances; // characters of the crowd that passed the frustum culling last frame
 } state;
 
+// maximum number of primitives that can be drawn in a frame
+#define MAX_FRAME_PRIMITIVES 1024
+// skinned vertices moves away from their bind pose, bounds are scaled around the center to cover the animations
+#define SKINNED_BOUNDS_SCALE 1.5f
+// meshlets are culled separately for each of the closest instances, this many instances at most, further ones are drawn instanced without culling
+#define MAX_MESHLET_CULL_INSTANCES 4
+// characters are drawn as CROWD_WIDTH x CROWD_WIDTH grid with one instanced draw per primitive and level of detail
+#define CROWD_WIDTH 10
+#define CROWD_SPACING 8.0f
+#define MAX_INSTANCES 128 // multiple of 4, >= CROWD_WIDTH * CROWD_WIDTH
+
 typedef struct {
     float x, y, z;
     uint32_t color;
@@ -61,24 +82,17 @@ typedef struct {
 } vertex_t;
 
 static Camera camera;
-static SceneBundle* sceneBundle;
+static StreamedScene* characterScene;
+static SceneBundle* sceneBundle; // null until characterScene is streamed in
 static Matrix4* nodeTransforms;
+static ANodeTransforms nodeLocals; // only the dirty nodes and their children are recalculated each frame
 static int characterRootIndex;
-static AnimationController animationController;
+static ACrowd crowd; // one character per instance, character index is the row of the instance in the joint texture
+static AResampledClip* crowdClips;
+static InstanceBuffer instances;
 
 static void _sapp_setup_wave_icon(void);
 
-void Prefab_UpdateGlobalNodeTransforms(SceneBundle* bundle, int nodeIndex, Matrix4 parentMat)
-{
-    ANode* node = &bundle->nodes[nodeIndex];
-    nodeTransforms[nodeIndex] = Matrix4Multiply(parentMat, PositionRotationScalePtr(node->translation, node->rotation, node->scale));
-
-    for (int i = 0; i < node->numChildren; i++)
-    {
-        Prefab_UpdateGlobalNodeTransforms(bundle, node->children[i], nodeTransforms[nodeIndex]);
-    }
-}
-
 
 void Init(void)
 {
@@ -105,38 +119,14 @@ void Init(void)
         .logger.func = slog_func,
     });
 
-    sceneBundle = rpmalloc(sizeof(SceneBundle));
-    if (!LoadSceneBundleBinary("Assets/Meshes/Paladin/Paladin.abm", sceneBundle))
-    {
-        AX_ERROR("gltf scene load failed2");
-        return;
-    }
-
-    nodeTransforms = rpmalloc(sizeof(Matrix4) * sceneBundle->numNodes);
-    characterRootIndex = Prefab_FindAnimRootNodeIndex(sceneBundle);
-    Prefab_UpdateGlobalNodeTransforms(sceneBundle, characterRootIndex, Matrix4Identity());
-
-    AnimationController* ac = &animationController;
-    AnimationController_Create(sceneBundle, &animationController, true, 58);
-    AnimationController_SampleAnimationPose(ac, ac->mAnimPoseA, 0.0f, 0.0f);
-    AnimationController_UploadPose(ac, ac->mAnimPoseA);
+    JobSystem_Init(0);
 
-    Texture textures[8];
-    LoadSceneImagesGeneric("Assets/Meshes/Paladin/Paladin.dxt", textures, sceneBundle->numImages);
+    // file read and decompression happens in the background, uploads are done in Frame
+    AssetStream_Init(2);
+    characterScene = AssetStream_RequestScene("Assets/Meshes/Paladin/Paladin.abm", "Assets/Meshes/Paladin/Paladin.dxt");
 
     Texture img = rImportTexture("Test.jpg", TexFlags_MipMap, "Test Tex");
 
-    sg_buffer vbuf = sg_make_buffer(&(sg_buffer_desc){
-        .data = (sg_range){sceneBundle->allVertices, sceneBundle->totalVertices * sizeof(ASkinedVertex)},
-        .label = "vertices"
-    });
-
-    sg_buffer ibuf = sg_make_buffer(&(sg_buffer_desc){
-        .usage.index_buffer = true,
-        .data = (sg_range){sceneBundle->allIndices, sceneBundle->totalIndices * sizeof(uint32_t)},
-        .label = "indices"
-    });
-
     // the first 4 samplers are just different min-filters
     sg_sampler_desc smp_desc = { .mag_filter = SG_FILTER_LINEAR, };
     smp_desc.min_lod = 0.0f;
@@ -155,13 +145,25 @@ void Init(void)
     animSmpDesc.label = "joint-texture-sampler";
     sg_sampler  jointSampler = sg_make_sampler(&animSmpDesc);
 
-    /* create shader */
-    sg_shader shader = sg_make_shader(cube_shader_desc(sg_query_backend()));
+    /* shader and pipelines are created when the character is streamed in because vertex format depends on the abm file */
+    /* setup resource bindings, buffers and images are set when the character is streamed in */
+    state.bind = (sg_bindings) {
+        .samplers[0] = sampler,
+        .samplers[1] = jointSampler,
+    };
+}
 
-    state.pip = sg_make_pipeline(&(sg_pipeline_desc){
+// quantized positions are unorm16x4, dequantized in the vertex shader
+// octahedral normal tangent is one uint32, read as ubyte4 and decoded in the vertex shader (cube_oct)
+static void CreatePipelines(bool quantizedPositions, bool octahedralTangents)
+{
+    state.shader = sg_make_shader(octahedralTangents ? cube_oct_shader_desc(sg_query_backend()) 
+                                                     : cube_shader_desc(sg_query_backend()));
+    sg_pipeline_desc pipelineDesc = {
         .layout = {
+            .buffers[1].step_func = SG_VERTEXSTEP_PER_INSTANCE,
             .attrs = {
-                [0].format = SG_VERTEXFORMAT_FLOAT3,
+                [0].format = quantizedPositions ? SG_VERTEXFORMAT_USHORT4N : SG_VERTEXFORMAT_FLOAT3,
                 [1].format = SG_VERTEXFORMAT_UINT10_N2,
                 [2].format = SG_VERTEXFORMAT_UINT10_N2,
                 [3].format = SG_VERTEXFORMAT_HALF2,
@@ -169,7 +171,7 @@ void Init(void)
                 [5].format = SG_VERTEXFORMAT_UBYTE4N,
             }
         },
-        .shader = shader,
+        .shader = state.shader,
         .index_type = SG_INDEXTYPE_UINT32,
         .cull_mode = SG_CULLMODE_FRONT,
         .depth = {
@@ -177,23 +179,129 @@ void Init(void)
             .write_enabled = true
         },
         .label = "pipeline"
-    });
-
-    
-    /* setup resource bindings */
-    state.bind = (sg_bindings) {
-        .vertex_buffers[0] = vbuf,
-        .samplers[0] = sampler,
-        .samplers[1] = jointSampler,
-        .images[0] = textures[sceneBundle->materials[0].baseColorTexture.index].handle,
-        .images[1] = animationController.mMatrixTex.handle,
-        .index_buffer = ibuf
     };
+    
+    if (octahedralTangents)
+    {
+        sg_vertex_attr_state* attrs = pipelineDesc.layout.attrs;
+        attrs[ATTR_cube_oct_aNormalTangent].format = SG_VERTEXFORMAT_UBYTE4;
+        attrs[ATTR_cube_oct_aTexCoords].format     = SG_VERTEXFORMAT_HALF2;
+        attrs[ATTR_cube_oct_aJoints].format        = SG_VERTEXFORMAT_UBYTE4;
+        attrs[ATTR_cube_oct_aWeights].format       = SG_VERTEXFORMAT_UBYTE4N;
+        attrs[5].format = SG_VERTEXFORMAT_INVALID;
+    }
+    
+    // AInstance, model rows and the params
+    int firstInstanceAttr = octahedralTangents ? ATTR_cube_oct_iModel0 : ATTR_cube_iModel0;
+    for (int i = 0; i < 4; i++)
+    {
+        pipelineDesc.layout.attrs[firstInstanceAttr + i].format = SG_VERTEXFORMAT_FLOAT4;
+        pipelineDesc.layout.attrs[firstInstanceAttr + i].buffer_index = 1;
+    }
+    state.pip = sg_make_pipeline(&pipelineDesc);
+    
+    pipelineDesc.index_type = SG_INDEXTYPE_UINT16;
+    pipelineDesc.label = "pipeline-16bit-indices";
+    state.pip16 = sg_make_pipeline(&pipelineDesc);
+}
+
+static void OnCharacterLoaded(void)
+{
+    sceneBundle = &characterScene->bundle;
+    CreatePipelines(sceneBundle->quantizedPositions, sceneBundle->octahedralTangents);
+
+    nodeTransforms = rpmalloc(sizeof(Matrix4) * sceneBundle->numNodes);
+    characterRootIndex = Prefab_FindAnimRootNodeIndex(sceneBundle);
+    NodeTransforms_Create(&nodeLocals, sceneBundle);
+
+    // characters are playing different animations with different offsets so the crowd doesn't move in sync
+    Crowd_Create(&crowd, sceneBundle, MAX_INSTANCES);
+    crowdClips = Prefab_ResampleAnimations(sceneBundle, 30.0f);
+    crowd.mClips = crowdClips;
+    for (int i = 0; i < CROWD_WIDTH * CROWD_WIDTH && sceneBundle->numAnimations > 0; i++)
+    {
+        Crowd_Add(&crowd, i % sceneBundle->numAnimations, Fractf((float)i * 0.618034f), 1.0f);
+    }
+
+    state.bind.vertex_buffers[0] = characterScene->vertexBuffer;
+    state.bind.index_buffer = characterScene->indexBuffer;
+    state.bind.images[0] = characterScene->textures[sceneBundle->materials[0].baseColorTexture.index].handle;
+    state.bind.images[1] = crowd.mMatrixTex.handle;
+
+    instances = rCreateInstanceBuffer(MAX_INSTANCES, "instances");
+    state.bind.vertex_buffers[1] = instances.buffer;
+}
+
+// transforms the mesh space box with the model matrix of each instance and culls the boxes in world space,
+// returns the number of instances that can see the box
+static int CullInstancedAABB(const FrustumPlanes* frustum, Vector4x32f min, Vector4x32f max, const Matrix4* models, int numModels, uint8_t* visible)
+{
+    static float centerX[MAX_INSTANCES], centerY[MAX_INSTANCES], centerZ[MAX_INSTANCES];
+    static float extentX[MAX_INSTANCES], extentY[MAX_INSTANCES], extentZ[MAX_INSTANCES];
+    int i = 0;
+    for (; i < numModels; i++)
+    {
+        Vector4x32f center, extent;
+        TransformAABB(min, max, &models[i], &center, &extent);
+        centerX[i] = VecGetX(center); centerY[i] = VecGetY(center); centerZ[i] = VecGetZ(center);
+        extentX[i] = VecGetX(extent); extentY[i] = VecGetY(extent); extentZ[i] = VecGetZ(extent);
+    }
+    // padding for the last batch of four
+    for (; i < ((numModels + 3) & ~3); i++)
+    {
+        centerX[i] = centerY[i] = centerZ[i] = extentX[i] = extentY[i] = extentZ[i] = 0.0f;
+    }
+    return FrustumCullAABBs(frustum, centerX, centerY, centerZ, extentX, extentY, extentZ, visible, numModels);
+}
+
+typedef struct AInstanceDistance_
+{
+    float distance; // from the camera to the bounding sphere of the character
+    int index;      // index of the instance in the crowd
+} AInstanceDistance;
+
+static int CompareInstanceDistance(const void* a, const void* b)
+{
+    float da = ((const AInstanceDistance*)a)->distance, db = ((const AInstanceDistance*)b)->distance;
+    return (da > db) - (da < db);
+}
+
+// lod distances are in mesh space, they are scaled with the largest axis to compare with the world space distances
+static float MaxAxisScale(Matrix4 matrix)
+{
+    Vec3f scale = ExtractScale(matrix);
+    return MMAX(scale.x, MMAX(scale.y, scale.z));
+}
+
+// meshlet bounds are in mesh space, so we are moving the frustum and the camera into mesh space instead
+static void CreateLocalView(Matrix4 localModel, Matrix4 viewProj, FrustumPlanes* localFrustum, Vec3f* localCameraPos)
+{
+    *localFrustum = CreateFrustumPlanes(Matrix4Multiply(localModel, viewProj));
+    Matrix4 invModel = Matrix4Inverse(localModel);
+    Vector4x32f cameraPos = Vector3Transform(VecSetR(camera.position.x, camera.position.y, camera.position.z, 1.0f), invModel.r);
+    *localCameraPos = (Vec3f){ VecGetX(cameraPos), VecGetY(cameraPos), VecGetZ(cameraPos) };
+}
+
+// instanced draws start from the first instance of the bound range of the instance buffer
+static void BindInstanceRange(int firstInstance, int* currentFirstInstance)
+{
+    if (firstInstance == *currentFirstInstance)
+        return;
+    state.bind.vertex_buffer_offsets[1] = firstInstance * (int)sizeof(AInstance);
+    sg_apply_bindings(&state.bind);
+    *currentFirstInstance = firstInstance;
 }
 
 
 void Frame(void)
 {
+    AssetStream_Update(0.002); // 2ms upload budget per frame
+
+    if (sceneBundle == NULL && AssetStream_IsReady(characterScene))
+    {
+        OnCharacterLoaded();
+    }
+
     /* NOTE: the vs_params_t struct has been code-generated by the shader-code-gen */
     vs_params_t vs_params;
     const float w = sapp_widthf();
@@ -214,9 +322,12 @@ void Frame(void)
 
     view_proj = Matrix4Multiply(camera.view, camera.projection);
     vs_params.mvp = Matrix4Multiply(model, view_proj);
-    vs_params.uModel = model;
+    vs_params.uModel = Matrix4Identity(); // node transform of the static primitives, set per primitive
     // vs_params.uLightMatrix;
     vs_params.uViewProj = view_proj;
+    // no dequantization by default, primitives overrides these if the positions are quantized
+    vs_params.uPosScale[0]  = vs_params.uPosScale[1]  = vs_params.uPosScale[2]  = vs_params.uPosScale[3]  = 1.0f;
+    vs_params.uPosOffset[0] = vs_params.uPosOffset[1] = vs_params.uPosOffset[2] = vs_params.uPosOffset[3] = 0.0f;
 
     sg_begin_pass(&(sg_pass) {
         .action = {
@@ -227,10 +338,19 @@ void Frame(void)
         },
         .swapchain = sglue_swapchain()
     });
-    sg_apply_pipeline(state.pip);
-    sg_apply_bindings(&state.bind);
-    sg_apply_uniforms(UB_vs_params, &SG_RANGE(vs_params));
-    
+    if (sceneBundle == NULL) // still streaming, just clear the screen
+    {
+        sg_end_pass();
+        sg_commit();
+        return;
+    }
+
+    // pipeline is chosen per primitive depending on the index type,
+    // base vertex is emulated with the vertex buffer offset because indices are relative to the first vertex of the primitive
+    int vertexSize = SceneBundleVertexSize(sceneBundle);
+    uint32_t currentPipeline = 0;
+    int currentBaseVertex = -1;
+    bool applyUniforms = true;
 
     int numNodes  = sceneBundle->numNodes;
     bool hasScene = sceneBundle->numScenes > 0;
@@ -241,26 +361,59 @@ void Frame(void)
         numNodes = defaultScene.numNodes;
     }
 
+    AIndexRange meshletRanges[256];
+    // lod errors are in mesh space too, distance to the local camera is scaled same as the error, so this works with scaled models
+    float projectionScale = camera.projection.m[1][1] * h * 0.5f;
+
+    Crowd_Update(&crowd, (float)dt);
+    Crowd_Upload(&crowd);
+
+    // world matrices of all of the nodes, static meshes are culled and drawn with these
+    UpdateWorldMatrices(nodeTransforms, &nodeLocals, sceneBundle, 0, sceneBundle->numNodes, Matrix4Identity());
+
+    // gather the primitives and their bounds in mesh space, same bounds are used for all of the instances
+    static APrimitive* primitives[MAX_FRAME_PRIMITIVES];
+    static float centerX[MAX_FRAME_PRIMITIVES], centerY[MAX_FRAME_PRIMITIVES], centerZ[MAX_FRAME_PRIMITIVES];
+    static float extentX[MAX_FRAME_PRIMITIVES], extentY[MAX_FRAME_PRIMITIVES], extentZ[MAX_FRAME_PRIMITIVES];
+    static uint8_t hasBounds[MAX_FRAME_PRIMITIVES];
+    static int primitiveNodes[MAX_FRAME_PRIMITIVES]; // -1 for the skinned primitives
+    int numPrimitives = 0;
+
     int stackLen = 1;
     int nodeStack[256];
     nodeStack[0] = hasScene ? defaultScene.nodes[0] : 0;
-    int x = 0;
 
     while (stackLen > 0)
     {
         int nodeIndex = nodeStack[--stackLen];
         ANode* node = &sceneBundle->nodes[nodeIndex];
         AMesh* mesh = sceneBundle->meshes + node->index;
-        Matrix4 model = nodeTransforms[nodeIndex];
 
         if (node->type == 0 && node->index != -1)
-        for (int j = 0; j < mesh->numPrimitives; ++j)
+        for (int j = 0; j < mesh->numPrimitives && numPrimitives < MAX_FRAME_PRIMITIVES; ++j)
         {
             APrimitive* primitive = &mesh->primitives[j];
-            bool hasMaterial = sceneBundle->materials && primitive->material != UINT16_MAX;
-            AMaterial material = sceneBundle->materials[primitive->material];
-            
-            sg_draw(primitive->indexOffset, primitive->numIndices, 1);
+            int p = numPrimitives++;
+            primitives[p] = primitive;
+            // primitives loaded from gltf doesn't have bounds, they are always drawn
+            hasBounds[p] = primitive->min[0] != primitive->max[0] || primitive->min[1] != primitive->max[1] || primitive->min[2] != primitive->max[2];
+
+            Vector4x32f min = VecSetR(primitive->min[0], primitive->min[1], primitive->min[2], 1.0f);
+            Vector4x32f max = VecSetR(primitive->max[0], primitive->max[1], primitive->max[2], 1.0f);
+            Vector4x32f center, extent;
+            // skinned primitives are placed by their joints, node transform doesn't apply to them
+            primitiveNodes[p] = (primitive->attributes & AAttribType_JOINTS) ? -1 : nodeIndex;
+            if (primitiveNodes[p] == -1)
+            {
+                center = VecMul(VecAdd(min, max), VecSet1(0.5f));
+                extent = VecMul(VecSub(max, min), VecSet1(0.5f * SKINNED_BOUNDS_SCALE));
+            }
+            else
+            {
+                TransformAABB(min, max, &nodeTransforms[nodeIndex], &center, &extent);
+            }
+            centerX[p] = VecGetX(center); centerY[p] = VecGetY(center); centerZ[p] = VecGetZ(center);
+            extentX[p] = VecGetX(extent); extentY[p] = VecGetY(extent); extentZ[p] = VecGetZ(extent);
         }
 
         for (int i = 0; i < node->numChildren; i++)
@@ -269,14 +422,196 @@ void Frame(void)
         }
     }
 
+    // union of the primitive bounds, characters that are out of the frustum are not pushed to the instance buffer.
+    // primitives without bounds can be anywhere, in that case all of the instances are drawn
+    bool sceneHasBounds = numPrimitives > 0;
+    Vector4x32f sceneMin = VecSet1(1e30f), sceneMax = VecSet1(-1e30f);
+    for (int p = 0; p < numPrimitives; p++)
+    {
+        sceneHasBounds &= hasBounds[p];
+        Vector4x32f center = VecSetR(centerX[p], centerY[p], centerZ[p], 1.0f);
+        Vector4x32f extent = VecSetR(extentX[p], extentY[p], extentZ[p], 0.0f);
+        sceneMin = VecMin(sceneMin, VecSub(center, extent));
+        sceneMax = VecMax(sceneMax, VecAdd(center, extent));
+    }
+
+    static Matrix4 crowdModels[MAX_INSTANCES];
+    static Matrix4 visibleModels[MAX_INSTANCES];
+    static uint8_t instanceVisible[MAX_INSTANCES];
+    const int numCrowd = CROWD_WIDTH * CROWD_WIDTH;
+    for (int i = 0; i < numCrowd; i++)
+    {
+        float x = (float)(i % CROWD_WIDTH - CROWD_WIDTH / 2) * CROWD_SPACING;
+        float z = (float)(i / CROWD_WIDTH) * -CROWD_SPACING;
+        crowdModels[i] = Matrix4Multiply(model, MatrixFromPosition(x, 0.0f, z));
+        instanceVisible[i] = 1;
+    }
+
+    FrustumPlanes worldFrustum = CreateFrustumPlanes(view_proj);
+    if (sceneHasBounds)
+        CullInstancedAABB(&worldFrustum, sceneMin, sceneMax, crowdModels, numCrowd, instanceVisible);
+
+    // visible instances are sorted by their distance and each instance selects its own lod with its distance,
+    // lods are increasing with the distance, so the instances that use the same lod of a primitive are next to each other in the instance buffer.
+    // all of the primitives of a character are measured from the bounding sphere of the whole character
+    Vector4x32f sceneCenter = sceneHasBounds ? VecMul(VecAdd(sceneMin, sceneMax), VecSet1(0.5f)) : VecSetR(0.0f, 0.0f, 0.0f, 1.0f);
+    float sceneRadius = sceneHasBounds ? Vec3LenfV(VecSub(sceneMax, sceneMin)) * 0.5f * MaxAxisScale(model) : 0.0f;
+    static AInstanceDistance sortedInstances[MAX_INSTANCES];
+    int numVisible = 0;
+    for (int i = 0; i < numCrowd; i++)
+    {
+        if (!instanceVisible[i])
+            continue;
+        Vector4x32f center = Vector3Transform(sceneCenter, crowdModels[i].r);
+        Vec3f toCamera = Vec3Sub(camera.position, (Vec3f){ VecGetX(center), VecGetY(center), VecGetZ(center) });
+        sortedInstances[numVisible].distance = Vec3Len(toCamera) - sceneRadius;
+        sortedInstances[numVisible].index = i;
+        numVisible++;
+    }
+    if (numVisible > 1)
+        QuickSortFn(sortedInstances, 0, numVisible - 1, sizeof(AInstanceDistance), CompareInstanceDistance);
+
+    rBeginInstances(&instances);
+    for (int v = 0; v < numVisible; v++)
+    {
+        int i = sortedInstances[v].index;
+        rPushInstance(&instances, crowdModels[i], i < crowd.mNumCharacters ? i : 0);
+        visibleModels[v] = crowdModels[i];
+    }
+    rUploadInstances(&instances);
+    state.numVisibleInstances = numVisible;
+
+    float lodScale = 1.0f;
+    int currentNode = -2;
+    int currentFirstInstance = -1;
+
+    state.numDrawnPrimitives  = 0;
+    state.numCulledPrimitives = 0;
+
+    for (int p = 0; p < numPrimitives; ++p)
+    {
+        // primitive is drawn for all of the visible instances if any of them can see it
+        if (numVisible == 0 || (hasBounds[p] &&
+            !CullInstancedAABB(&worldFrustum, VecSetR(centerX[p] - extentX[p], centerY[p] - extentY[p], centerZ[p] - extentZ[p], 1.0f),
+                                              VecSetR(centerX[p] + extentX[p], centerY[p] + extentY[p], centerZ[p] + extentZ[p], 1.0f),
+                                              visibleModels, numVisible, instanceVisible)))
+        {
+            state.numCulledPrimitives++;
+            continue;
+        }
+        state.numDrawnPrimitives++;
+
+        APrimitive* primitive = primitives[p];
+        sg_pipeline pipeline = primitive->indexType == GraphicType_UnsignedShort ? state.pip16 : state.pip;
+        if (pipeline.id != currentPipeline)
+        {
+            sg_apply_pipeline(pipeline);
+            currentPipeline = pipeline.id;
+            currentBaseVertex = -1; // bindings and uniforms has to be applied after the pipeline
+            applyUniforms = true;
+        }
+        
+        if (primitive->baseVertex != currentBaseVertex)
+        {
+            state.bind.vertex_buffer_offsets[0] = primitive->baseVertex * vertexSize;
+            currentBaseVertex = primitive->baseVertex;
+            currentFirstInstance = -1; // bindings are applied with the instance range
+        }
+        
+        if (primitiveNodes[p] != currentNode)
+        {
+            currentNode = primitiveNodes[p];
+            vs_params.uModel = currentNode == -1 ? Matrix4Identity() : nodeTransforms[currentNode];
+            applyUniforms = true;
+
+            // same transform as the vertex shader: node first, then the instance. instances only have translation, all of them has the same scale
+            lodScale = MaxAxisScale(currentNode == -1 ? model : Matrix4Multiply(nodeTransforms[currentNode], model));
+        }
+
+        if (sceneBundle->quantizedPositions)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                vs_params.uPosScale[c]  = primitive->max[c] - primitive->min[c];
+                vs_params.uPosOffset[c] = primitive->min[c];
+            }
+            applyUniforms = true;
+        }
+        
+        if (applyUniforms)
+        {
+            sg_apply_uniforms(UB_vs_params, &SG_RANGE(vs_params));
+            applyUniforms = false;
+        }
+        
+        // one instanced draw for each lod, instances [begin, end) are the ones that are closer than the start of the next lod
+        int numLods = MMAX(primitive->numLods, 1);
+        int begin = 0;
+        for (int lod = 0; lod < numLods && begin < numVisible; lod++)
+        {
+            int end = numVisible;
+            if (lod + 1 < numLods)
+            {
+                float nextLodDistance = PrimitiveLodDistance(primitive, lod + 1, projectionScale, AX_LOD_PIXEL_ERROR) * lodScale;
+                end = begin;
+                while (end < numVisible && sortedInstances[end].distance < nextLodDistance) end++;
+            }
+            if (end == begin)
+                continue;
+
+            // meshlets are built for the full detail mesh, simplified levels are drawn without culling
+            if (lod > 0)
+            {
+                BindInstanceRange(begin, &currentFirstInstance);
+                sg_draw(primitive->lods[lod].indexOffset, primitive->lods[lod].numIndices, end - begin);
+            }
+            // closest instances are drawn one by one with their visible meshlets,
+            // meshlets of the skinned primitives are padded as much as the bounds of the primitive (SKINNED_BOUNDS_SCALE)
+            else if (primitive->numMeshlets > 0 && end - begin <= MAX_MESHLET_CULL_INSTANCES)
+            {
+                float skinPadding = 0.0f;
+                if (currentNode == -1)
+                    skinPadding = (SKINNED_BOUNDS_SCALE - 1.0f) * 0.5f * Vec3Len(Vec3Sub(Vec3FromPtr((float*)primitive->max), Vec3FromPtr((float*)primitive->min)));
+                
+                for (int i = begin; i < end; i++)
+                {
+                    FrustumPlanes localFrustum;
+                    Vec3f localCameraPos;
+                    CreateLocalView(currentNode == -1 ? visibleModels[i] : Matrix4Multiply(nodeTransforms[currentNode], visibleModels[i]), view_proj, &localFrustum, &localCameraPos);
+                    int numRanges = CullMeshlets(primitive, &localFrustum, localCameraPos, skinPadding, meshletRanges, ARRAY_SIZE(meshletRanges));
+                    if (numRanges == 0)
+                        continue;
+                    
+                    BindInstanceRange(i, &currentFirstInstance);
+                    for (int r = 0; r < numRanges; r++)
+                        sg_draw(primitive->indexOffset + meshletRanges[r].offset, meshletRanges[r].count, 1);
+                }
+            }
+            else
+            {
+                BindInstanceRange(begin, &currentFirstInstance);
+                sg_draw(primitive->indexOffset, primitive->numIndices, end - begin);
+            }
+            begin = end;
+        }
+    }
+
     sg_end_pass();
     sg_commit();
 }
 
 void Cleanup(void) {
+    // clips are freed before the scene, number of clips is in the scene
+    if (crowdClips) Prefab_FreeResampledAnimations(crowdClips, sceneBundle->numAnimations);
+    AssetStream_Destroy();
+    AssetStream_FreeScene(characterScene);
+    JobSystem_Destroy();
+    if (instances.instances) rDeleteInstanceBuffer(&instances);
+    Crowd_Destroy(&crowd);
     sg_shutdown();
     rDestroy();
-    rpfree(nodeTransforms);
+    if (nodeTransforms) rpfree(nodeTransforms);
+    NodeTransforms_Destroy(&nodeLocals);
     rpmalloc_finalize();
 }
 
@@ -239,19 +239,21 @@ inline void ConvertFloat8ToHalf8(half* result, const float* float8)
 
 inline void ConvertHalfToFloatN(float* res, const half* x, const int n) 
 {   
-    for (int i = 0; i < n; i += 8, x += 8, res += 8)
+    int i = 0;
+    for (; i + 8 <= n; i += 8, x += 8, res += 8)
         ConvertHalf8ToFloat8(res, x);
  
-    for (int i = 0; i < (n & 7); i++, res++, x++)
+    for (; i < n; i++, res++, x++)
         *res = ConvertHalfToFloat(*x);
 }
 
 inline void ConvertFloatToHalfN(half* res, const float* x, const int n) 
 {   
-    for (int i = 0; i < n; i += 8, x += 8, res += 8)
+    int i = 0;
+    for (; i + 8 <= n; i += 8, x += 8, res += 8)
         ConvertFloat8ToHalf8(res, x);
  
-    for (int i = 0; i < (n & 7); i++, res++, x++)
+    for (; i < n; i++, res++, x++)
         *res = ConvertFloatToHalf(*x);
 }
 
@@ -636,6 +636,56 @@ inline bool VECTORCALL CheckAABBCulled(Vector4x32f min, Vector4x32f max, Frustum
     return true;
 }
 
+// Arvo's method, center of the box is transformed, extents are projected onto the absolute axes of the matrix
+inline void VECTORCALL TransformAABB(Vector4x32f min, Vector4x32f max, const Matrix4* matrix, Vector4x32f* center, Vector4x32f* extent)
+{
+    Vector4x32f half = VecSet1(0.5f);
+    Vector4x32f c = VecMul(VecAdd(min, max), half);
+    Vector4x32f e = VecMul(VecSub(max, min), half);
+    *center = Vector3Transform(c, matrix->r);
+    Vector4x32f r = VecMul(VecFabs(matrix->r[0]), VecSplatX(e));
+    r = VecFmadd(VecFabs(matrix->r[1]), VecSplatY(e), r);
+    *extent = VecFmadd(VecFabs(matrix->r[2]), VecSplatZ(e), r);
+}
+
+// tests four boxes at a time, boxes are center extent form in SoA layout. arrays must be padded to multiple of 4.
+// same planes with CheckAABBCulled, box is visible if center + |normal| * extent is in front of all planes.
+// visible[i] is set to 1 if the box intersects the frustum, returns the number of visible boxes
+inline int FrustumCullAABBs(const FrustumPlanes* frustum, 
+                            const float* centerX, const float* centerY, const float* centerZ,
+                            const float* extentX, const float* extentY, const float* extentZ, uint8_t* visible, int count)
+{
+    int numVisible = 0;
+    for (int i = 0; i < count; i += 4)
+    {
+        Vector4x32f cx = VecLoad(centerX + i), cy = VecLoad(centerY + i), cz = VecLoad(centerZ + i);
+        Vector4x32f ex = VecLoad(extentX + i), ey = VecLoad(extentY + i), ez = VecLoad(extentZ + i);
+        Vector4x32f minDist = VecSet1(1.0f);
+
+        for (int p = 0; p < 5; p++) // make < 6 if you want far plane 
+        {
+            Vector4x32f plane = frustum->planes[p];
+            Vector4x32f absPlane = VecFabs(plane);
+            Vector4x32f d = VecFmadd(VecSplatX(plane), cx, VecSplatW(plane));
+            d = VecFmadd(VecSplatY(plane), cy, d);
+            d = VecFmadd(VecSplatZ(plane), cz, d);
+            d = VecFmadd(VecSplatX(absPlane), ex, d);
+            d = VecFmadd(VecSplatY(absPlane), ey, d);
+            d = VecFmadd(VecSplatZ(absPlane), ez, d);
+            minDist = VecMin(minDist, d);
+        }
+
+        int mask = VecMovemask(VecCmpGe(minDist, VecZero()));
+        int n = MMIN(count - i, 4);
+        for (int j = 0; j < n; j++)
+        {
+            visible[i + j] = (mask >> j) & 1;
+            numVisible += (mask >> j) & 1;
+        }
+    }
+    return numVisible;
+}
+
 inline bool isPointCulled(FrustumPlanes frustum, Vec3f _point, Matrix4 matrix)
 {
     Vector4x32f point = Vector3Transform(VecLoad(&_point.x), matrix.r);
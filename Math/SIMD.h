@@ -88,6 +88,7 @@ purefn Vector4x32f VECTORCALL Vec3Load(void const* x) {
 #define VecNeg(a) _mm_sub_ps(_mm_setzero_ps(), a) /* -a */
 #define VecRcp(a) _mm_rcp_ps(a) /* 1.0f / a */
 #define VecSqrt(a) _mm_sqrt_ps(a)
+#define VecRsqrt(a) _mm_rsqrt_ps(a) /* 1.0f / sqrt(a), estimate */
 
 #define VeciNeg(a) _mm_sub_epi32(_mm_set1_epi32(0), a) /* -a */
 
@@ -262,6 +263,7 @@ typedef uint32x4_t Vector4x32u;
 #define VecFmsub(a, b, c) vfmsq_f32(c, a, b)
 #define VecHadd(a, b)    vpaddq_f32(a, b)
 #define VecSqrt(a)       vsqrtq_f32(a)
+#define VecRsqrt(a)      vrsqrteq_f32(a)
 #define VecRcp(a)        vrecpeq_f32(a)
 #define VecNeg(a)        vnegq_f32(a)
 
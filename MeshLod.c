@@ -0,0 +1,375 @@
+/********************************************************************************
+*    Purpose: Quadric error mesh simplification for level of detail chains,     *
+*             selecting the level of detail from projected size at runtime      *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#include "MeshLod.h"
+#include "MeshOptimize.h"
+#include "Memory.h"
+#include "Algorithm.h"
+#include "Extern/rpmalloc.h"
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              Quadrics                                    */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+// symmetric 4x4 matrix, error of a point is p^T A p + 2 b.p + c
+typedef struct AQuadric_
+{
+    float a00, a11, a22, a01, a02, a12;
+    float b0, b1, b2;
+    float c;
+    float weight; // sum of the triangle areas, error is averaged with this
+} AQuadric;
+
+static void QuadricFromTriangle(AQuadric* q, Vec3f p0, Vec3f p1, Vec3f p2)
+{
+    Vec3f n = Vec3Cross(Vec3Sub(p1, p0), Vec3Sub(p2, p0));
+    float area = Vec3Len(n);
+    if (area > 1e-20f) n = Vec3DivF(n, area);
+    float d = -Vec3Dot(n, p0);
+
+    q->a00 = n.x * n.x * area; q->a11 = n.y * n.y * area; q->a22 = n.z * n.z * area;
+    q->a01 = n.x * n.y * area; q->a02 = n.x * n.z * area; q->a12 = n.y * n.z * area;
+    q->b0  = n.x * d * area;   q->b1  = n.y * d * area;   q->b2  = n.z * d * area;
+    q->c   = d * d * area;
+    q->weight = area;
+}
+
+static void QuadricAdd(AQuadric* a, const AQuadric* b)
+{
+    a->a00 += b->a00; a->a11 += b->a11; a->a22 += b->a22;
+    a->a01 += b->a01; a->a02 += b->a02; a->a12 += b->a12;
+    a->b0  += b->b0;  a->b1  += b->b1;  a->b2  += b->b2;
+    a->c   += b->c;
+    a->weight += b->weight;
+}
+
+// average squared distance to the planes of the quadric
+static float QuadricError(const AQuadric* q, Vec3f p)
+{
+    float rx = q->a00 * p.x + q->a01 * p.y + q->a02 * p.z + q->b0;
+    float ry = q->a01 * p.x + q->a11 * p.y + q->a12 * p.z + q->b1;
+    float rz = q->a02 * p.x + q->a12 * p.y + q->a22 * p.z + q->b2;
+    float error = p.x * rx + p.y * ry + p.z * rz + (q->b0 * p.x + q->b1 * p.y + q->b2 * p.z) + q->c;
+    return Absf(error) / MMAX(q->weight, 1e-20f);
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              Simplify                                    */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+typedef struct ACollapse_
+{
+    float    cost;
+    uint32_t vertex;
+    uint32_t target;
+} ACollapse;
+
+static int CompareCollapseCost(const void* a, const void* b)
+{
+    float ca = ((const ACollapse*)a)->cost, cb = ((const ACollapse*)b)->cost;
+    if (ca != cb) return ca < cb ? -1 : 1;
+    return (int)((const ACollapse*)a)->vertex - (int)((const ACollapse*)b)->vertex;
+}
+
+static inline bool Vec3Equal(Vec3f a, Vec3f b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static inline uint32_t HashPosition(Vec3f p)
+{
+    uint32_t x = BitCast(uint32_t, p.x), y = BitCast(uint32_t, p.y), z = BitCast(uint32_t, p.z);
+    return (x * 73856093u) ^ (y * 19349663u) ^ (z * 83492791u);
+}
+
+// vertices that has the same position are welded, so the seams are connected while finding the borders.
+// returns the first vertex that has the same position for each vertex
+static void WeldPositions(uint32_t* weld, const Vec3f* positions, int numVertices)
+{
+    uint32_t tableSize = (uint32_t)NextPowerOf2_32(numVertices * 2);
+    uint32_t* table = rpmalloc(sizeof(uint32_t) * tableSize);
+    for (uint32_t i = 0; i < tableSize; i++)
+        table[i] = ~0u;
+
+    for (int v = 0; v < numVertices; v++)
+    {
+        uint32_t slot = HashPosition(positions[v]) & (tableSize - 1);
+        while (table[slot] != ~0u && !Vec3Equal(positions[table[slot]], positions[v]))
+            slot = (slot + 1) & (tableSize - 1); // linear probing
+
+        if (table[slot] == ~0u) table[slot] = (uint32_t)v;
+        weld[v] = table[slot];
+    }
+    rpfree(table);
+}
+
+// moving a vertex shouldn't flip the triangles around it
+static bool CollapseFlipsTriangle(const uint32_t* result, const int* offsets, const int* adjacency, const uint32_t* weld,
+                                  const Vec3f* positions, uint32_t vertex, uint32_t target)
+{
+    Vec3f targetPos = positions[target];
+    for (int t = offsets[vertex]; t < offsets[vertex + 1]; t++)
+    {
+        const uint32_t* tri = result + adjacency[t] * 3;
+        if (weld[tri[0]] == weld[target] || weld[tri[1]] == weld[target] || weld[tri[2]] == weld[target])
+            continue; // this triangle will be removed
+
+        Vec3f p[3], q[3];
+        for (int k = 0; k < 3; k++)
+        {
+            p[k] = positions[tri[k]];
+            q[k] = tri[k] == vertex ? targetPos : p[k];
+        }
+        Vec3f before = Vec3Cross(Vec3Sub(p[1], p[0]), Vec3Sub(p[2], p[0]));
+        Vec3f after  = Vec3Cross(Vec3Sub(q[1], q[0]), Vec3Sub(q[2], q[0]));
+        if (Vec3Dot(before, after) <= 0.0f)
+            return true;
+    }
+    return false;
+}
+
+// collapses are done in passes, in each pass cheapest collapses are applied if their neighborhood is not changed by other collapses
+int SimplifyMesh(uint32_t* dst, const uint32_t* indices, int numIndices, const void* vertices, int vertexStride,
+                 uint32_t firstVertex, int numVertices, int targetIndexCount, float targetError, float* resultError)
+{
+    int numTriangles = numIndices / 3;
+    *resultError = 0.0f;
+    if (numTriangles == 0 || numVertices == 0)
+        return 0;
+
+    // positions are normalized to unit cube for precision of the quadrics
+    Vec3f* positions = rpmalloc(sizeof(Vec3f) * numVertices);
+    Vec3f min = { FLT_MAX, FLT_MAX, FLT_MAX }, max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (int v = 0; v < numVertices; v++)
+    {
+        positions[v] = Vec3FromPtr((float*)((const char*)vertices + (uint64_t)(firstVertex + v) * vertexStride));
+        min.x = MMIN(min.x, positions[v].x); min.y = MMIN(min.y, positions[v].y); min.z = MMIN(min.z, positions[v].z);
+        max.x = MMAX(max.x, positions[v].x); max.y = MMAX(max.y, positions[v].y); max.z = MMAX(max.z, positions[v].z);
+    }
+    float scale = MMAX(MMAX(max.x - min.x, max.y - min.y), max.z - min.z);
+    float invScale = scale > 0.0f ? 1.0f / scale : 0.0f;
+    for (int v = 0; v < numVertices; v++)
+        positions[v] = Vec3MulF(Vec3Sub(positions[v], min), invScale);
+
+    uint32_t* weld     = rpmalloc(sizeof(uint32_t) * numVertices);
+    uint32_t* result   = rpmalloc(sizeof(uint32_t) * numTriangles * 3);
+    uint32_t* remap    = rpmalloc(sizeof(uint32_t) * numVertices);
+    uint8_t*  locked   = rpcalloc(numVertices, 1);
+    uint8_t*  touched  = rpmalloc(numVertices);
+    int*      offsets  = rpmalloc(sizeof(int) * (numVertices + 1));
+    int*      adjacency = rpmalloc(sizeof(int) * numTriangles * 3);
+    AQuadric* quadrics = rpcalloc(numVertices, sizeof(AQuadric)); // indexed with welded vertices
+    ACollapse* collapses = rpmalloc(sizeof(ACollapse) * numVertices);
+
+    WeldPositions(weld, positions, numVertices);
+    for (int i = 0; i < numTriangles * 3; i++)
+        result[i] = indices[i] - firstVertex;
+
+    // vertices that are on attribute seams are locked, otherwise the wedges would be separated
+    for (int v = 0; v < numVertices; v++)
+        if (weld[v] != (uint32_t)v) locked[v] = locked[weld[v]] = 1;
+
+    for (int t = 0; t < numTriangles; t++)
+    {
+        const uint32_t* tri = result + t * 3;
+        AQuadric quadric;
+        QuadricFromTriangle(&quadric, positions[tri[0]], positions[tri[1]], positions[tri[2]]);
+        for (int k = 0; k < 3; k++)
+            QuadricAdd(&quadrics[weld[tri[k]]], &quadric);
+    }
+
+    // border vertices are locked, an edge is on the border if the opposite (welded) edge doesn't exist
+    MemsetZero(offsets, sizeof(int) * (numVertices + 1));
+    for (int i = 0; i < numTriangles * 3; i++)
+        offsets[weld[result[i]] + 1]++;
+    for (int v = 0; v < numVertices; v++)
+        offsets[v + 1] += offsets[v];
+    {
+        int* counts = rpcalloc(numVertices, sizeof(int));
+        for (int i = 0; i < numTriangles * 3; i++) // welded edge start -> edge end
+        {
+            uint32_t a = weld[result[i]], b = weld[result[i - i % 3 + (i + 1) % 3]];
+            adjacency[offsets[a] + counts[a]++] = (int)b;
+        }
+        for (int a = 0; a < numVertices; a++)
+        for (int e = offsets[a]; e < offsets[a + 1]; e++)
+        {
+            int b = adjacency[e], hasOpposite = 0;
+            for (int o = offsets[b]; o < offsets[b + 1] && !hasOpposite; o++)
+                hasOpposite = adjacency[o] == a;
+            if (!hasOpposite) locked[a] = locked[b] = 1;
+        }
+        rpfree(counts);
+    }
+    for (int v = 0; v < numVertices; v++)
+        locked[v] |= locked[weld[v]];
+
+    int numResult = numTriangles * 3;
+    float maxError = (targetError * invScale) * (targetError * invScale), resultCost = 0.0f;
+
+    while (numResult > targetIndexCount)
+    {
+        int numCurrent = numResult / 3;
+        // vertex -> triangle adjacency (CSR) of the current mesh
+        MemsetZero(offsets, sizeof(int) * (numVertices + 1));
+        for (int i = 0; i < numResult; i++)
+            offsets[result[i] + 1]++;
+        for (int v = 0; v < numVertices; v++)
+            offsets[v + 1] += offsets[v];
+        for (int i = 0; i < numResult; i++)
+            adjacency[offsets[result[i]]++] = i / 3;
+        for (int v = numVertices; v > 0; v--) // filling moved the offsets to the end of each vertex
+            offsets[v] = offsets[v - 1];
+        offsets[0] = 0;
+
+        // cheapest collapse of each vertex to one of it's neighbors
+        int numCollapses = 0;
+        for (int v = 0; v < numVertices; v++)
+        {
+            if (locked[v] || offsets[v] == offsets[v + 1]) continue;
+            ACollapse best = { FLT_MAX, (uint32_t)v, (uint32_t)v };
+            for (int t = offsets[v]; t < offsets[v + 1]; t++)
+            for (int k = 0; k < 3; k++)
+            {
+                uint32_t target = result[adjacency[t] * 3 + k];
+                if (target == (uint32_t)v) continue;
+                float cost = QuadricError(&quadrics[v], positions[target]) + QuadricError(&quadrics[weld[target]], positions[target]);
+                if (cost < best.cost) best.cost = cost, best.target = target;
+            }
+            if (best.cost <= maxError) collapses[numCollapses++] = best;
+        }
+        if (numCollapses == 0) break;
+
+        QuickSortFn(collapses, 0, numCollapses - 1, sizeof(ACollapse), CompareCollapseCost);
+
+        for (int v = 0; v < numVertices; v++)
+            remap[v] = (uint32_t)v;
+        MemsetZero(touched, numVertices);
+
+        int trianglesToRemove = (numResult - targetIndexCount) / 3, numRemoved = 0, numApplied = 0;
+        for (int c = 0; c < numCollapses && numRemoved < trianglesToRemove; c++)
+        {
+            uint32_t v = collapses[c].vertex, target = collapses[c].target;
+            if (touched[v] || touched[target] || touched[weld[target]]) continue;
+            if (CollapseFlipsTriangle(result, offsets, adjacency, weld, positions, v, target)) continue;
+
+            // neighbors of the vertex are touched, so the flip test above stays valid in this pass
+            for (int t = offsets[v]; t < offsets[v + 1]; t++)
+            {
+                const uint32_t* tri = result + adjacency[t] * 3;
+                for (int k = 0; k < 3; k++)
+                {
+                    touched[tri[k]] = touched[weld[tri[k]]] = 1;
+                    numRemoved += weld[tri[k]] == weld[target];
+                }
+            }
+            remap[v] = target;
+            QuadricAdd(&quadrics[weld[target]], &quadrics[v]);
+            resultCost = MMAX(resultCost, collapses[c].cost);
+            numApplied++;
+        }
+        if (numApplied == 0) break;
+
+        // apply the collapses and remove the degenerate triangles
+        int newResult = 0;
+        for (int t = 0; t < numCurrent; t++)
+        {
+            uint32_t a = remap[result[t * 3 + 0]], b = remap[result[t * 3 + 1]], c = remap[result[t * 3 + 2]];
+            if (weld[a] == weld[b] || weld[b] == weld[c] || weld[a] == weld[c]) continue;
+            result[newResult++] = a;
+            result[newResult++] = b;
+            result[newResult++] = c;
+        }
+        numResult = newResult;
+    }
+
+    for (int i = 0; i < numResult; i++)
+        dst[i] = result[i] + firstVertex;
+    *resultError = Sqrtf(resultCost) * scale;
+
+    rpfree(positions);
+    rpfree(weld);
+    rpfree(result);
+    rpfree(remap);
+    rpfree(locked);
+    rpfree(touched);
+    rpfree(offsets);
+    rpfree(adjacency);
+    rpfree(quadrics);
+    rpfree(collapses);
+    return numResult;
+}
+
+int GenerateLods(ALod* lods, uint32_t* lodIndices, int lodCapacity, const uint32_t* indices, int numIndices, const void* vertices, int vertexStride,
+                 uint32_t firstVertex, int numVertices)
+{
+    Vec3f min = { FLT_MAX, FLT_MAX, FLT_MAX }, max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (int i = 0; i < numIndices; i++)
+    {
+        Vec3f p = Vec3FromPtr((float*)((const char*)vertices + (uint64_t)indices[i] * vertexStride));
+        min.x = MMIN(min.x, p.x); min.y = MMIN(min.y, p.y); min.z = MMIN(min.z, p.z);
+        max.x = MMAX(max.x, p.x); max.y = MMAX(max.y, p.y); max.z = MMAX(max.z, p.z);
+    }
+    float radius = Vec3Len(Vec3Sub(max, min)) * 0.5f;
+
+    // levels are simplified into scratch, only the accepted ones are copied to lodIndices
+    uint32_t* scratch = rpmalloc(sizeof(uint32_t) * MMAX(numIndices, 1));
+    const uint32_t* source = indices;
+    int numSource = numIndices, offset = 0, numLods = 1;
+    float error = 0.0f;
+    for (; numLods < AX_MAX_LODS; numLods++)
+    {
+        int target = (int)(numSource * AX_LOD_REDUCTION) / 3 * 3;
+        float levelError;
+        int count = SimplifyMesh(scratch, source, numSource, vertices, vertexStride, firstVertex, numVertices,
+                                 target, radius * AX_LOD_MAX_ERROR, &levelError);
+        if (count == 0 || count > numSource * AX_LOD_MIN_REDUCTION || count > lodCapacity - offset)
+            break;
+
+        OptimizeVertexCache(scratch, count, firstVertex, numVertices);
+        SmallMemCpy(lodIndices + offset, scratch, sizeof(uint32_t) * count);
+        error += levelError; // each level is simplified from the previous one, so the errors add up
+        lods[numLods].indexOffset = offset;
+        lods[numLods].numIndices  = count;
+        lods[numLods].error       = error;
+
+        source = lodIndices + offset;
+        numSource = count;
+        offset += count;
+    }
+    rpfree(scratch);
+    return numLods;
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              Selection                                   */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+int SelectPrimitiveLod(const APrimitive* primitive, Vec3f localCameraPos, float projectionScale, float pixelError)
+{
+    if (primitive->numLods <= 1)
+        return 0;
+
+    Vec3f min = Vec3FromPtr((float*)primitive->min), max = Vec3FromPtr((float*)primitive->max);
+    Vec3f center = Vec3MulF(Vec3Add(min, max), 0.5f);
+    float radius = Vec3Len(Vec3Sub(max, min)) * 0.5f;
+    float distance = Vec3Len(Vec3Sub(center, localCameraPos)) - radius; // closest point of the sphere
+    if (distance <= 0.0f)
+        return 0;
+
+    // errors are sorted, larger levels has more error
+    float pixelsPerUnit = projectionScale / distance;
+    int lod = 0;
+    while (lod + 1 < primitive->numLods && primitive->lods[lod + 1].error * pixelsPerUnit <= pixelError)
+        lod++;
+    return lod;
+}
+
+float PrimitiveLodDistance(const APrimitive* primitive, int lod, float projectionScale, float pixelError)
+{
+    // inverse of the SelectPrimitiveLod's condition: error * projectionScale / distance <= pixelError
+    return lod == 0 ? 0.0f : primitive->lods[lod].error * projectionScale / pixelError;
+}
@@ -0,0 +1,52 @@
+/********************************************************************************
+*    Purpose: Quadric error mesh simplification for level of detail chains,     *
+*             selecting the level of detail from projected size at runtime      *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#pragma once
+
+// int SimplifyMesh(dst, indices, numIndices, vertices, vertexStride, firstVertex, numVertices, targetIndexCount, targetError, resultError);
+// int GenerateLods(lods, lodIndices, lodCapacity, indices, numIndices, vertices, vertexStride, firstVertex, numVertices); // returns num lods
+// int SelectPrimitiveLod(primitive, localCameraPos, projectionScale, pixelError); // returns lod index
+// float PrimitiveLodDistance(primitive, lod, projectionScale, pixelError); // returns distance that the lod starts
+
+#include "GLTFParser.h"
+#include "Math/Vector.h"
+
+// triangle count is halved for each level
+#define AX_LOD_REDUCTION 0.5f
+// maximum error of a level relative to the radius of the primitive
+#define AX_LOD_MAX_ERROR 0.1f
+// default screen space error for SelectPrimitiveLod, in pixels
+#define AX_LOD_PIXEL_ERROR 1.0f
+// level is rejected if it has more than this fraction of the previous level's triangles (mostly because of locked seams)
+#define AX_LOD_MIN_REDUCTION 0.8f
+// each level has at most AX_LOD_MIN_REDUCTION of the previous level, so lods[1..4) are less than twice of the original (0.8 + 0.64 + 0.512)
+#define AX_LOD_INDEX_CAPACITY(numIndices) ((numIndices) * 2)
+STATIC_ASSERT(AX_MAX_LODS <= 4, "AX_LOD_INDEX_CAPACITY is not enough for more lods");
+
+// all of the indices must be in [firstVertex, firstVertex + numVertices) range.
+// vertices are read from the first 12 bytes (Vec3f position) of each vertex, indexed with the same indices
+
+// Surface Simplification Using Quadric Error Metrics, Garland and Heckbert 1997
+// vertices are not modified, collapses moves a vertex onto one of its neighbors so the result uses subset of the vertices.
+// vertices on the mesh borders and attribute seams (duplicated positions) are not moved, so uv's and skinning stays correct.
+// targetError and resultError are in the units of the vertex positions, returns the number of indices written to dst
+int SimplifyMesh(uint32_t* dst, const uint32_t* indices, int numIndices, const void* vertices, int vertexStride,
+                 uint32_t firstVertex, int numVertices, int targetIndexCount, float targetError, float* resultError);
+
+// simplifies the mesh repeatedly to fill lods[1..AX_MAX_LODS), each level is made from the previous one.
+// lodCapacity is the size of lodIndices, AX_LOD_INDEX_CAPACITY(numIndices) is enough for all levels, generation stops when it is full.
+// lods[i].indexOffset is the offset inside of lodIndices. lods[0] is not written, returns the number of levels including the original mesh
+int GenerateLods(ALod* lods, uint32_t* lodIndices, int lodCapacity, const uint32_t* indices, int numIndices, const void* vertices, int vertexStride,
+                 uint32_t firstVertex, int numVertices);
+
+// projectionScale: pixels per unit at unit distance, projection[1][1] * viewportHeight * 0.5.
+// localCameraPos has to be in primitive's local space, bounding sphere of the primitive is calculated from it's min max.
+// returns the coarsest lod whose error is smaller than pixelError on the screen, zero if the primitive has no lods
+int SelectPrimitiveLod(const APrimitive* primitive, Vec3f localCameraPos, float projectionScale, float pixelError);
+
+// distance from the bounding sphere (in local units) that SelectPrimitiveLod starts to select the lod, zero for the first lod.
+// distances are increasing with the lod, so objects that are sorted by distance can be grouped by their lods without selecting each of them
+float PrimitiveLodDistance(const APrimitive* primitive, int lod, float projectionScale, float pixelError);
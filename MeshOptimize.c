@@ -0,0 +1,271 @@
+/********************************************************************************
+*    Purpose: Reordering triangles and vertices of the meshes for better        *
+*             post transform vertex cache and vertex fetch locality             *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#include "MeshOptimize.h"
+#include "Memory.h"
+#include "Algorithm.h"
+#include "Math/Vector.h"
+#include "Extern/rpmalloc.h"
+
+// FIFO cache with timestamps, time is increased on each miss so the vertex is in the cache
+// if there was less than cache size misses after it is loaded. cacheTimes has to be zero initialized and time starts from cacheSize + 1
+static inline bool VertexCacheMiss(int* cacheTimes, int* time, uint32_t vertex)
+{
+    if (*time - cacheTimes[vertex] <= AX_VERTEX_CACHE_SIZE)
+        return false;
+    cacheTimes[vertex] = (*time)++;
+    return true;
+}
+
+float CalculateACMR(const uint32_t* indices, int numIndices, uint32_t firstVertex, int numVertices)
+{
+    int numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+        return 0.0f;
+
+    int* cacheTimes = rpcalloc(numVertices, sizeof(int));
+    int time = AX_VERTEX_CACHE_SIZE + 1;
+    int numMisses = 0;
+    for (int i = 0; i < numTriangles * 3; i++)
+    {
+        numMisses += VertexCacheMiss(cacheTimes, &time, indices[i] - firstVertex);
+    }
+    rpfree(cacheTimes);
+    return (float)numMisses / (float)numTriangles;
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              Tipsify                                     */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+// emits all of the triangles around a vertex (fan), then continues with a vertex of the fan that
+// will still be in the cache after its own triangles are emitted. if there is none, we go back to recently used vertices (dead end stack)
+void OptimizeVertexCache(uint32_t* indices, int numIndices, uint32_t firstVertex, int numVertices)
+{
+    int numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+        return;
+
+    int*      offsets    = rpcalloc(numVertices + 1, sizeof(int)); // vertex -> triangle adjacency (CSR)
+    int*      adjacency  = rpmalloc(sizeof(int) * numTriangles * 3);
+    int*      liveCounts = rpcalloc(numVertices, sizeof(int));     // number of not emitted triangles that uses the vertex
+    int*      cacheTimes = rpcalloc(numVertices, sizeof(int));
+    int*      deadEnds   = rpmalloc(sizeof(int) * numTriangles * 3);
+    uint8_t*  emitted    = rpcalloc(numTriangles, 1);
+    uint32_t* result     = rpmalloc(sizeof(uint32_t) * numTriangles * 3);
+
+    for (int i = 0; i < numTriangles * 3; i++)
+        offsets[indices[i] - firstVertex + 1]++;
+
+    int maxValence = 0;
+    for (int i = 0; i < numVertices; i++)
+    {
+        maxValence = MMAX(maxValence, offsets[i + 1]);
+        offsets[i + 1] += offsets[i];
+    }
+
+    for (int i = 0; i < numTriangles * 3; i++)
+    {
+        uint32_t vertex = indices[i] - firstVertex;
+        adjacency[offsets[vertex] + liveCounts[vertex]++] = i / 3;
+    }
+
+    int* candidates = rpmalloc(sizeof(int) * maxValence * 3);
+    int time = AX_VERTEX_CACHE_SIZE + 1;
+    int numDeadEnds = 0;
+    int numWritten  = 0;
+    int cursor      = 0; // for finding vertices with remaining triangles when dead end stack is empty
+    int vertex      = (int)(indices[0] - firstVertex);
+
+    while (vertex >= 0)
+    {
+        int numCandidates = 0;
+        for (int t = offsets[vertex]; t < offsets[vertex + 1]; t++)
+        {
+            int triangle = adjacency[t];
+            if (emitted[triangle]) continue;
+            emitted[triangle] = 1;
+
+            for (int k = 0; k < 3; k++)
+            {
+                uint32_t index = indices[triangle * 3 + k];
+                uint32_t v = index - firstVertex;
+                result[numWritten++] = index;
+                deadEnds[numDeadEnds++] = (int)v;
+                candidates[numCandidates++] = (int)v;
+                liveCounts[v]--;
+                VertexCacheMiss(cacheTimes, &time, v);
+            }
+        }
+
+        // choose the oldest vertex that will still be in the cache after emitting its remaining triangles
+        int next = -1, bestPriority = -1;
+        for (int c = 0; c < numCandidates; c++)
+        {
+            int v = candidates[c];
+            if (liveCounts[v] == 0) continue;
+            int age = time - cacheTimes[v];
+            int priority = age + 2 * liveCounts[v] <= AX_VERTEX_CACHE_SIZE ? age : 0;
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        while (next == -1 && numDeadEnds > 0)
+        {
+            int v = deadEnds[--numDeadEnds];
+            if (liveCounts[v] > 0) next = v;
+        }
+
+        while (next == -1 && cursor < numVertices)
+        {
+            if (liveCounts[cursor] > 0) next = cursor;
+            else cursor++;
+        }
+        vertex = next;
+    }
+
+    SmallMemCpy(indices, result, sizeof(uint32_t) * numTriangles * 3);
+    rpfree(offsets);
+    rpfree(adjacency);
+    rpfree(liveCounts);
+    rpfree(cacheTimes);
+    rpfree(deadEnds);
+    rpfree(emitted);
+    rpfree(result);
+    rpfree(candidates);
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                              Overdraw                                    */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+typedef struct ATriangleCluster_
+{
+    float score;
+    int   begin; // first triangle
+    int   end;
+} ATriangleCluster;
+
+static int CompareClusterScore(const void* a, const void* b)
+{
+    float sa = ((const ATriangleCluster*)a)->score, sb = ((const ATriangleCluster*)b)->score;
+    if (sa != sb) return sa > sb ? -1 : 1; // descending
+    return ((const ATriangleCluster*)a)->begin - ((const ATriangleCluster*)b)->begin;
+}
+
+static inline Vec3f OptimizerVertexPos(const char* vertices, int vertexStride, uint32_t index)
+{
+    return Vec3FromPtr((float*)(vertices + (uint64_t)index * vertexStride));
+}
+
+// clusters are starting where all three vertices of the triangle are cache misses, so moving them around doesn't change the acmr much.
+// clusters that are far away from the center and facing outwards are likely to occlude the others, so we draw them first
+void OptimizeOverdraw(uint32_t* indices, int numIndices, const void* vertices, int vertexStride, uint32_t firstVertex, int numVertices)
+{
+    int numTriangles = numIndices / 3;
+    if (numTriangles < 2)
+        return;
+
+    const char* vertexData = (const char*)vertices;
+    int* cacheTimes = rpcalloc(numVertices, sizeof(int));
+    ATriangleCluster* clusters = rpmalloc(sizeof(ATriangleCluster) * numTriangles);
+    int numClusters = 0;
+    int time = AX_VERTEX_CACHE_SIZE + 1;
+
+    for (int t = 0; t < numTriangles; t++)
+    {
+        int numMisses = 0;
+        for (int k = 0; k < 3; k++)
+            numMisses += VertexCacheMiss(cacheTimes, &time, indices[t * 3 + k] - firstVertex);
+
+        if (t == 0 || numMisses == 3)
+        {
+            if (numClusters > 0) clusters[numClusters - 1].end = t;
+            clusters[numClusters].begin = t;
+            numClusters++;
+        }
+    }
+    clusters[numClusters - 1].end = numTriangles;
+    rpfree(cacheTimes);
+
+    if (numClusters == 1)
+    {
+        rpfree(clusters);
+        return;
+    }
+
+    Vec3f meshCenter = Vec3Zero();
+    for (int i = 0; i < numTriangles * 3; i++)
+        meshCenter = Vec3Add(meshCenter, OptimizerVertexPos(vertexData, vertexStride, indices[i]));
+    meshCenter = Vec3DivF(meshCenter, (float)(numTriangles * 3));
+
+    for (int c = 0; c < numClusters; c++)
+    {
+        ATriangleCluster* cluster = &clusters[c];
+        Vec3f center = Vec3Zero(), normal = Vec3Zero();
+        for (int t = cluster->begin; t < cluster->end; t++)
+        {
+            Vec3f a = OptimizerVertexPos(vertexData, vertexStride, indices[t * 3 + 0]);
+            Vec3f b = OptimizerVertexPos(vertexData, vertexStride, indices[t * 3 + 1]);
+            Vec3f d = OptimizerVertexPos(vertexData, vertexStride, indices[t * 3 + 2]);
+            center = Vec3Add(center, Vec3Add(Vec3Add(a, b), d));
+            normal = Vec3Add(normal, Vec3Cross(Vec3Sub(b, a), Vec3Sub(d, a))); // area weighted
+        }
+        center = Vec3DivF(center, (float)((cluster->end - cluster->begin) * 3));
+        float normalLen = Vec3Len(normal);
+        cluster->score = normalLen > 1e-10f ? Vec3Dot(Vec3Sub(center, meshCenter), Vec3DivF(normal, normalLen)) : 0.0f;
+    }
+
+    QuickSortFn(clusters, 0, numClusters - 1, sizeof(ATriangleCluster), CompareClusterScore);
+
+    uint32_t* result = rpmalloc(sizeof(uint32_t) * numTriangles * 3);
+    uint32_t* curr = result;
+    for (int c = 0; c < numClusters; c++)
+    {
+        int count = (clusters[c].end - clusters[c].begin) * 3;
+        SmallMemCpy(curr, indices + clusters[c].begin * 3, sizeof(uint32_t) * count);
+        curr += count;
+    }
+    SmallMemCpy(indices, result, sizeof(uint32_t) * numTriangles * 3);
+    rpfree(result);
+    rpfree(clusters);
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                            Vertex Fetch                                  */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+void OptimizeVertexFetch(void* vertices, int vertexStride, uint32_t* indices, int numIndices, uint32_t firstVertex, int numVertices)
+{
+    int* remap = rpmalloc(sizeof(int) * numVertices);
+    for (int i = 0; i < numVertices; i++)
+        remap[i] = -1;
+
+    int numRemapped = 0;
+    for (int i = 0; i < numIndices; i++)
+    {
+        uint32_t v = indices[i] - firstVertex;
+        if (remap[v] == -1) remap[v] = numRemapped++;
+        indices[i] = firstVertex + (uint32_t)remap[v];
+    }
+
+    // unused vertices goes to the end
+    for (int i = 0; i < numVertices; i++)
+        if (remap[i] == -1) remap[i] = numRemapped++;
+
+    char* primitiveVertices = (char*)vertices + (uint64_t)firstVertex * vertexStride;
+    char* copy = rpmalloc((uint64_t)numVertices * vertexStride);
+    SmallMemCpy(copy, primitiveVertices, (uint64_t)numVertices * vertexStride);
+
+    for (int i = 0; i < numVertices; i++)
+        SmallMemCpy(primitiveVertices + (uint64_t)remap[i] * vertexStride, copy + (uint64_t)i * vertexStride, vertexStride);
+
+    rpfree(copy);
+    rpfree(remap);
+}
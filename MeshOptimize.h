@@ -0,0 +1,32 @@
+/********************************************************************************
+*    Purpose: Reordering triangles and vertices of the meshes for better        *
+*             post transform vertex cache and vertex fetch locality             *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#pragma once
+
+// void  OptimizeVertexCache(indices, numIndices, firstVertex, numVertices);            // tipsify
+// void  OptimizeOverdraw(indices, numIndices, vertices, vertexStride, firstVertex, numVertices); // after OptimizeVertexCache
+// void  OptimizeVertexFetch(vertices, vertexStride, indices, numIndices, firstVertex, numVertices);
+// float CalculateACMR(indices, numIndices, firstVertex, numVertices);                  // average cache miss ratio
+
+#include "Common.h"
+
+// size of the simulated FIFO cache, smaller than the real caches of the gpus so we are not optimizing for a specific gpu
+#define AX_VERTEX_CACHE_SIZE 16
+
+// all of the indices must be in [firstVertex, firstVertex + numVertices) range.
+// vertices are read from the first 12 bytes (Vec3f position) of each vertex, indexed with the same indices
+
+// Fast Triangle Reordering for Vertex Locality and Reduced Overdraw, Sander et al. 2007
+void OptimizeVertexCache(uint32_t* indices, int numIndices, uint32_t firstVertex, int numVertices);
+
+// splits the triangles into clusters where the cache is flushed, then sorts the clusters so outward facing ones drawn first
+void OptimizeOverdraw(uint32_t* indices, int numIndices, const void* vertices, int vertexStride, uint32_t firstVertex, int numVertices);
+
+// vertices are sorted in order of the first use, indices are remapped
+void OptimizeVertexFetch(void* vertices, int vertexStride, uint32_t* indices, int numIndices, uint32_t firstVertex, int numVertices);
+
+// number of vertex shader invocations per triangle, 0.5 is the best case, 3 is the worst case
+float CalculateACMR(const uint32_t* indices, int numIndices, uint32_t firstVertex, int numVertices);
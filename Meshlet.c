@@ -0,0 +1,399 @@
+/********************************************************************************
+*    Purpose: Splitting primitives into small clusters (meshlets) with          *
+*             bounding spheres and normal cones, culling them on the CPU        *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#include "Meshlet.h"
+#include "Memory.h"
+#include "Extern/rpmalloc.h"
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                               Builder                                    */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+typedef struct AMeshletBuilder_
+{
+    const char* vertices;
+    int         vertexStride;
+    uint32_t    minIndex;
+
+    int*      vertexTriangleOffsets; // [numVertices + 1] triangles that uses the welded vertex (CSR)
+    int*      vertexTriangles;       // [numIndices]
+    uint32_t* weld;                  // [numVertices] first local vertex that has the same position
+    int*      vertexTags;            // [numVertices] index of the last meshlet that contains the vertex
+    uint8_t*  emitted;               // [numTriangles]
+    uint32_t* srcIndices;
+
+    uint32_t  meshletVertices[AX_MESHLET_MAX_VERTICES]; // local vertex indices
+    int       numMeshletVertices;
+    Vec3f     centroidSum;
+} AMeshletBuilder;
+
+static inline Vec3f MeshletVertexPos(const AMeshletBuilder* builder, uint32_t index)
+{
+    return Vec3FromPtr((float*)(builder->vertices + (uint64_t)index * builder->vertexStride));
+}
+
+static inline int MeshletNumNewVertices(const AMeshletBuilder* builder, int triangle, int meshletIndex)
+{
+    const uint32_t* tri = builder->srcIndices + triangle * 3;
+    return (builder->vertexTags[tri[0] - builder->minIndex] != meshletIndex) +
+           (builder->vertexTags[tri[1] - builder->minIndex] != meshletIndex) +
+           (builder->vertexTags[tri[2] - builder->minIndex] != meshletIndex);
+}
+
+static void MeshletAddTriangle(AMeshletBuilder* builder, int triangle, int meshletIndex, uint32_t* dst)
+{
+    const uint32_t* tri = builder->srcIndices + triangle * 3;
+    for (int i = 0; i < 3; i++)
+    {
+        uint32_t local = tri[i] - builder->minIndex;
+        dst[i] = tri[i];
+        if (builder->vertexTags[local] == meshletIndex) continue;
+        builder->vertexTags[local] = meshletIndex;
+        builder->meshletVertices[builder->numMeshletVertices++] = local;
+        builder->centroidSum = Vec3Add(builder->centroidSum, MeshletVertexPos(builder, tri[i]));
+    }
+    builder->emitted[triangle] = 1;
+}
+
+static inline bool MeshletPositionEqual(Vec3f a, Vec3f b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static inline uint32_t MeshletHashPosition(Vec3f p)
+{
+    uint32_t x = BitCast(uint32_t, p.x), y = BitCast(uint32_t, p.y), z = BitCast(uint32_t, p.z);
+    uint32_t h = (x * 73856093u) ^ (y * 19349663u) ^ (z * 83492791u);
+    // round numbers has zero low mantissa bits, mix high bits down because the table uses the low bits
+    h ^= h >> 16; h *= 0x85ebca6bu;
+    h ^= h >> 13; h *= 0xc2b2ae35u;
+    return h ^ (h >> 16);
+}
+
+// uv and normal seams splits the vertices, vertices that has the same position are welded,
+// so the triangles on both sides of the seam are adjacent and meshlets can continue over the seams
+static void MeshletWeldPositions(AMeshletBuilder* builder, int numVertices)
+{
+    uint32_t tableSize = (uint32_t)NextPowerOf2_32(numVertices * 2);
+    uint32_t* table = rpmalloc(sizeof(uint32_t) * tableSize);
+    for (uint32_t i = 0; i < tableSize; i++)
+        table[i] = ~0u;
+
+    for (int v = 0; v < numVertices; v++)
+    {
+        Vec3f pos = MeshletVertexPos(builder, v + builder->minIndex);
+        uint32_t slot = MeshletHashPosition(pos) & (tableSize - 1);
+        while (table[slot] != ~0u && !MeshletPositionEqual(MeshletVertexPos(builder, table[slot] + builder->minIndex), pos))
+            slot = (slot + 1) & (tableSize - 1); // linear probing
+
+        if (table[slot] == ~0u) table[slot] = (uint32_t)v;
+        builder->weld[v] = table[slot];
+    }
+    rpfree(table);
+}
+
+// bounding sphere is not minimal, center of the aabb and max distance to that center.
+// cone is the average of triangle normals, cutoff is sin of the angle between axis and the farthest normal
+static void ComputeMeshletBounds(AMeshletBuilder* builder, AMeshlet* meshlet, const uint32_t* indices)
+{
+    Vec3f min = MeshletVertexPos(builder, builder->meshletVertices[0] + builder->minIndex);
+    Vec3f max = min;
+    for (int i = 1; i < builder->numMeshletVertices; i++)
+    {
+        Vec3f pos = MeshletVertexPos(builder, builder->meshletVertices[i] + builder->minIndex);
+        min.x = MMIN(min.x, pos.x); min.y = MMIN(min.y, pos.y); min.z = MMIN(min.z, pos.z);
+        max.x = MMAX(max.x, pos.x); max.y = MMAX(max.y, pos.y); max.z = MMAX(max.z, pos.z);
+    }
+
+    Vec3f center = Vec3MulF(Vec3Add(min, max), 0.5f);
+    float radiusSq = 0.0f;
+    for (int i = 0; i < builder->numMeshletVertices; i++)
+    {
+        Vec3f pos = MeshletVertexPos(builder, builder->meshletVertices[i] + builder->minIndex);
+        radiusSq = MMAX(radiusSq, Vec3DistSqr(pos, center));
+    }
+
+    int numTriangles = meshlet->numIndices / 3;
+    Vec3f normals[AX_MESHLET_MAX_TRIANGLES];
+    Vec3f axis = Vec3Zero();
+    int numNormals = 0;
+    for (int i = 0; i < numTriangles; i++)
+    {
+        Vec3f a = MeshletVertexPos(builder, indices[i * 3 + 0]);
+        Vec3f b = MeshletVertexPos(builder, indices[i * 3 + 1]);
+        Vec3f c = MeshletVertexPos(builder, indices[i * 3 + 2]);
+        Vec3f normal = Vec3Cross(Vec3Sub(b, a), Vec3Sub(c, a)); // counter clockwise front faces (gltf)
+        float area = Vec3Len(normal);
+        if (area < 1e-10f) continue; // degenerate triangle
+        normal = Vec3DivF(normal, area);
+        normals[numNormals++] = normal;
+        axis = Vec3Add(axis, normal);
+    }
+
+    meshlet->center[0] = center.x;
+    meshlet->center[1] = center.y;
+    meshlet->center[2] = center.z;
+    meshlet->radius    = Sqrtf(radiusSq);
+    meshlet->coneAxis[0] = 0.0f; meshlet->coneAxis[1] = 0.0f; meshlet->coneAxis[2] = 0.0f;
+    meshlet->coneCutoff  = 1.0f;
+
+    float axisLen = Vec3Len(axis);
+    if (numNormals == 0 || axisLen < 1e-10f)
+        return;
+
+    axis = Vec3DivF(axis, axisLen);
+    float minDot = 1.0f;
+    for (int i = 0; i < numNormals; i++)
+    {
+        minDot = MMIN(minDot, Vec3Dot(axis, normals[i]));
+    }
+
+    meshlet->coneAxis[0] = axis.x;
+    meshlet->coneAxis[1] = axis.y;
+    meshlet->coneAxis[2] = axis.z;
+    // cone spread is wider than ~84 degrees, it is visible from almost everywhere, no need to test it
+    meshlet->coneCutoff = minDot <= 0.1f ? 1.0f : Sqrtf(1.0f - minDot * minDot);
+}
+
+// greedy: starts from an unused triangle, then adds neighbor triangles that adds the least vertices,
+// if equal we choose the triangle that is closer to the center of the meshlet so meshlets stays compact and bounds are tight
+int BuildMeshlets(AMeshlet* meshlets, uint32_t* indices, int numIndices, const void* vertices, int vertexStride)
+{
+    int numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+        return 0;
+
+    uint32_t minIndex = indices[0], maxIndex = indices[0];
+    for (int i = 1; i < numTriangles * 3; i++)
+    {
+        minIndex = MMIN(minIndex, indices[i]);
+        maxIndex = MMAX(maxIndex, indices[i]);
+    }
+    int numVertices = (int)(maxIndex - minIndex) + 1;
+
+    AMeshletBuilder builder;
+    MemsetZero(&builder, sizeof(AMeshletBuilder));
+    builder.vertices     = (const char*)vertices;
+    builder.vertexStride = vertexStride;
+    builder.minIndex     = minIndex;
+    builder.vertexTriangleOffsets = rpcalloc(numVertices + 1, sizeof(int));
+    builder.vertexTriangles       = rpmalloc(sizeof(int) * numTriangles * 3);
+    builder.vertexTags            = rpmalloc(sizeof(int) * numVertices);
+    builder.weld                  = rpmalloc(sizeof(uint32_t) * numVertices);
+    builder.emitted               = rpcalloc(numTriangles, 1);
+    builder.srcIndices            = rpmalloc(sizeof(uint32_t) * numTriangles * 3);
+    SmallMemCpy(builder.srcIndices, indices, sizeof(uint32_t) * numTriangles * 3);
+
+    for (int i = 0; i < numVertices; i++)
+        builder.vertexTags[i] = -1;
+
+    MeshletWeldPositions(&builder, numVertices);
+
+    // welded vertex -> triangle adjacency, only these triangles are candidates, so building is linear with the number of triangles
+    for (int i = 0; i < numTriangles * 3; i++)
+        builder.vertexTriangleOffsets[builder.weld[indices[i] - minIndex] + 1]++;
+
+    for (int i = 0; i < numVertices; i++)
+        builder.vertexTriangleOffsets[i + 1] += builder.vertexTriangleOffsets[i];
+
+    int* fillCounts = rpcalloc(numVertices, sizeof(int));
+    for (int i = 0; i < numTriangles * 3; i++)
+    {
+        uint32_t welded = builder.weld[indices[i] - minIndex];
+        builder.vertexTriangles[builder.vertexTriangleOffsets[welded] + fillCounts[welded]++] = i / 3;
+    }
+    rpfree(fillCounts);
+
+    int numMeshlets = 0;
+    int numWritten  = 0; // indices
+    int seedCursor  = 0;
+
+    while (numWritten < numTriangles * 3)
+    {
+        while (builder.emitted[seedCursor]) seedCursor++;
+
+        AMeshlet* meshlet = &meshlets[numMeshlets];
+        meshlet->indexOffset = numWritten;
+        builder.numMeshletVertices = 0;
+        builder.centroidSum = Vec3Zero();
+        MeshletAddTriangle(&builder, seedCursor, numMeshlets, indices + numWritten);
+        numWritten += 3;
+        int numMeshletTriangles = 1;
+
+        while (numMeshletTriangles < AX_MESHLET_MAX_TRIANGLES)
+        {
+            Vec3f centroid = Vec3DivF(builder.centroidSum, (float)builder.numMeshletVertices);
+            int   bestTriangle = -1;
+            int   bestNewVertices = 4;
+            float bestDistance = 0.0f;
+
+            // candidates are the unused triangles that shares at least one vertex position with the meshlet
+            for (int v = 0; v < builder.numMeshletVertices; v++)
+            {
+                uint32_t welded = builder.weld[builder.meshletVertices[v]];
+                int end = builder.vertexTriangleOffsets[welded + 1];
+                for (int t = builder.vertexTriangleOffsets[welded]; t < end; t++)
+                {
+                    int triangle = builder.vertexTriangles[t];
+                    if (builder.emitted[triangle]) continue;
+
+                    int newVertices = MeshletNumNewVertices(&builder, triangle, numMeshlets);
+                    if (builder.numMeshletVertices + newVertices > AX_MESHLET_MAX_VERTICES || newVertices > bestNewVertices)
+                        continue;
+
+                    const uint32_t* tri = builder.srcIndices + triangle * 3;
+                    Vec3f triCenter = Vec3Add(Vec3Add(MeshletVertexPos(&builder, tri[0]), MeshletVertexPos(&builder, tri[1])), MeshletVertexPos(&builder, tri[2]));
+                    float distance = Vec3DistSqr(Vec3MulF(triCenter, 1.0f / 3.0f), centroid);
+
+                    if (newVertices < bestNewVertices || distance < bestDistance)
+                    {
+                        bestTriangle    = triangle;
+                        bestNewVertices = newVertices;
+                        bestDistance    = distance;
+                    }
+                }
+            }
+
+            if (bestTriangle == -1)
+                break; // meshlet is full or there is no adjacent triangle left
+
+            MeshletAddTriangle(&builder, bestTriangle, numMeshlets, indices + numWritten);
+            numWritten += 3;
+            numMeshletTriangles++;
+        }
+
+        meshlet->numIndices = numMeshletTriangles * 3;
+        ComputeMeshletBounds(&builder, meshlet, indices + meshlet->indexOffset);
+        numMeshlets++;
+    }
+
+    rpfree(builder.vertexTriangleOffsets);
+    rpfree(builder.vertexTriangles);
+    rpfree(builder.vertexTags);
+    rpfree(builder.weld);
+    rpfree(builder.emitted);
+    rpfree(builder.srcIndices);
+    return numMeshlets;
+}
+
+// meshlets are consecutive triangles of the index order, indices are not reordered. a meshlet ends when it is full.
+// use after OptimizeVertexCache, so the vertex cache order is kept, meshlets are less compact than the ones from BuildMeshlets
+int BuildMeshletsScan(AMeshlet* meshlets, uint32_t* indices, int numIndices, const void* vertices, int vertexStride)
+{
+    int numTriangles = numIndices / 3;
+    if (numTriangles == 0)
+        return 0;
+
+    uint32_t minIndex = indices[0], maxIndex = indices[0];
+    for (int i = 1; i < numTriangles * 3; i++)
+    {
+        minIndex = MMIN(minIndex, indices[i]);
+        maxIndex = MMAX(maxIndex, indices[i]);
+    }
+    int numVertices = (int)(maxIndex - minIndex) + 1;
+
+    AMeshletBuilder builder;
+    MemsetZero(&builder, sizeof(AMeshletBuilder));
+    builder.vertices     = (const char*)vertices;
+    builder.vertexStride = vertexStride;
+    builder.minIndex     = minIndex;
+    builder.vertexTags   = rpmalloc(sizeof(int) * numVertices);
+    builder.emitted      = rpcalloc(numTriangles, 1);
+    builder.srcIndices   = indices;
+
+    for (int i = 0; i < numVertices; i++)
+        builder.vertexTags[i] = -1;
+
+    int numMeshlets = 0;
+    int numMeshletTriangles = 0;
+    for (int i = 0; i < numTriangles; i++)
+    {
+        int newVertices = MeshletNumNewVertices(&builder, i, numMeshlets);
+        if (numMeshletTriangles == AX_MESHLET_MAX_TRIANGLES || builder.numMeshletVertices + newVertices > AX_MESHLET_MAX_VERTICES)
+        {
+            AMeshlet* meshlet = &meshlets[numMeshlets];
+            meshlet->numIndices = numMeshletTriangles * 3;
+            ComputeMeshletBounds(&builder, meshlet, indices + meshlet->indexOffset);
+            numMeshlets++;
+            numMeshletTriangles = 0;
+        }
+
+        if (numMeshletTriangles == 0)
+        {
+            meshlets[numMeshlets].indexOffset = i * 3;
+            builder.numMeshletVertices = 0;
+        }
+        MeshletAddTriangle(&builder, i, numMeshlets, indices + i * 3);
+        numMeshletTriangles++;
+    }
+
+    AMeshlet* meshlet = &meshlets[numMeshlets];
+    meshlet->numIndices = numMeshletTriangles * 3;
+    ComputeMeshletBounds(&builder, meshlet, indices + meshlet->indexOffset);
+    numMeshlets++;
+
+    rpfree(builder.vertexTags);
+    rpfree(builder.emitted);
+    return numMeshlets;
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                               Culling                                    */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+int CullMeshlets(const APrimitive* primitive, const FrustumPlanes* localFrustum, Vec3f localCameraPos, float skinPadding, AIndexRange* ranges, int maxRanges)
+{
+    // planes are not normalized, instead of normalizing we scale the radius with the length of the plane normal
+    AX_ALIGN(16) float planes[5][4];
+    float planeLengths[5];
+    for (int i = 0; i < 5; i++)
+    {
+        VecStoreA(planes[i], localFrustum->planes[i]);
+        planeLengths[i] = Sqrtf(planes[i][0] * planes[i][0] + planes[i][1] * planes[i][1] + planes[i][2] * planes[i][2]);
+    }
+
+    int numRanges = 0;
+    for (int i = 0; i < primitive->numMeshlets; i++)
+    {
+        const AMeshlet* meshlet = &primitive->meshlets[i];
+        const float* c = meshlet->center;
+        float radius = meshlet->radius + skinPadding;
+        bool visible = true;
+        for (int p = 0; p < 5 && visible; p++)
+        {
+            float distance = planes[p][0] * c[0] + planes[p][1] * c[1] + planes[p][2] * c[2] + planes[p][3];
+            visible = distance >= -radius * planeLengths[p];
+        }
+
+        // back facing cone test
+        if (visible && skinPadding == 0.0f)
+        {
+            Vec3f view = { c[0] - localCameraPos.x, c[1] - localCameraPos.y, c[2] - localCameraPos.z };
+            Vec3f axis = { meshlet->coneAxis[0], meshlet->coneAxis[1], meshlet->coneAxis[2] };
+            visible = Vec3Dot(view, axis) < meshlet->coneCutoff * Vec3Len(view) + meshlet->radius;
+        }
+
+        if (!visible)
+            continue;
+
+        AIndexRange* last = numRanges > 0 ? &ranges[numRanges - 1] : NULL;
+        if (last && last->offset + last->count == meshlet->indexOffset)
+        {
+            last->count += meshlet->numIndices; // merge with the previous range
+        }
+        else if (numRanges < maxRanges)
+        {
+            ranges[numRanges].offset = meshlet->indexOffset;
+            ranges[numRanges].count  = meshlet->numIndices;
+            numRanges++;
+        }
+        else // out of ranges, extend the last one, draws the culled meshlets between but it is still correct
+        {
+            last->count = meshlet->indexOffset + meshlet->numIndices - last->offset;
+        }
+    }
+    return numRanges;
+}
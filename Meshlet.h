@@ -0,0 +1,38 @@
+/********************************************************************************
+*    Purpose: Splitting primitives into small clusters (meshlets) with          *
+*             bounding spheres and normal cones, culling them on the CPU        *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#pragma once
+
+// int BuildMeshlets(meshlets, indices, numIndices, vertices, vertexStride); // reorders indices, returns num meshlets
+// int BuildMeshletsScan(meshlets, indices, numIndices, vertices, vertexStride); // keeps index order, returns num meshlets
+// int CullMeshlets(primitive, localFrustum, localCameraPos, skinPadding, ranges, maxRanges); // returns num visible index ranges
+
+#include "GLTFParser.h"
+#include "Math/Matrix.h"
+
+#define AX_MESHLET_MAX_VERTICES  64
+#define AX_MESHLET_MAX_TRIANGLES 124
+
+// offset is relative to primitive's indexOffset
+typedef struct AIndexRange_
+{
+    int offset;
+    int count;
+} AIndexRange;
+
+// meshlets array must have space for numIndices / 3 meshlets (worst case one triangle per meshlet).
+// indices are reordered so each meshlet is a contiguous range, vertices are read from the first 12 bytes (Vec3f position) of each vertex
+int BuildMeshlets(AMeshlet* meshlets, uint32_t* indices, int numIndices, const void* vertices, int vertexStride);
+
+// splits the indices into meshlets in the order of the triangles, so the order from OptimizeVertexCache is kept.
+// same requirements with BuildMeshlets, indices are not modified
+int BuildMeshletsScan(AMeshlet* meshlets, uint32_t* indices, int numIndices, const void* vertices, int vertexStride);
+
+// localFrustum and localCameraPos has to be in primitive's local space. (CreateFrustumPlanes(model * viewProj))
+// visible meshlets that are next to each other are merged into a single range, so we can draw them with one draw call.
+// skinPadding is how far the skinned vertices can move from their bind pose, zero for static meshes. it is added to the radius of the meshlets,
+// back facing cone test is skipped for the skinned meshes because the joints rotates the normals
+int CullMeshlets(const APrimitive* primitive, const FrustumPlanes* localFrustum, Vec3f localCameraPos, float skinPadding, AIndexRange* ranges, int maxRanges);
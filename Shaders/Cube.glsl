@@ -6,6 +6,8 @@ layout(binding = 0) uniform vs_params {
     highp mat4 uModel;
     highp mat4 uLightMatrix;
     highp mat4 uViewProj;
+    highp vec4 uPosScale;  // xyz: max - min of the primitive's AABB if positions are quantized, one otherwise
+    highp vec4 uPosOffset; // xyz: min of the primitive's AABB if positions are quantized, zero otherwise
 };
 
 layout(location = 0) in highp   vec3  aPos;
@@ -14,6 +16,11 @@ layout(location = 2) in lowp    vec4  aTangent;
 layout(location = 3) in mediump vec2  aTexCoords;
 layout(location = 4) in lowp    uvec4 aJoints; // lowp int ranges between 0-255 
 layout(location = 5) in lowp    vec4  aWeights;
+// per instance, AInstance in Graphics.h
+layout(location = 6) in highp   vec4  iModel0; // rows of the model matrix
+layout(location = 7) in highp   vec4  iModel1;
+layout(location = 8) in highp   vec4  iModel2;
+layout(location = 9) in highp   vec4  iParams; // x: row of the joint texture
 
 @image_sample_type uAnimTex unfilterable_float
 layout(binding = 1) uniform texture2D uAnimTex;
@@ -34,31 +41,134 @@ highp mat3 adjoint(in highp mat4 m)
 }
 
 void main() {
-    highp mat4 model = uModel;
-
-    // vBoneIdx = -1;
-    // if (uHasAnimation > 0) 
-    // {
-    //     mediump mat4 animMat = mat4(0.0);
-    //     animMat[3].w = 1.0; // last row is [0.0, 0.0, 0.0, 1.0]
-    // 
-    //     for (int i = 0; i < 4; i++)
-    //     {
-    //         int matIdx = int(aJoints[i]) * 3; // 3 because our matrix is: RGBA16f x 3
-    //         animMat[0] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 0, 0), 0) * aWeights[i];
-    //         animMat[1] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 1, 0), 0) * aWeights[i];
-    //         animMat[2] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 2, 0), 0) * aWeights[i]; 
-    //     }
-    //     // vBoneIdx = int(aJoints[0]);
-    //     model = model * transpose(animMat);
-    // }
+    highp mat4 model = transpose(mat4(iModel0, iModel1, iModel2, vec4(0.0, 0.0, 0.0, 1.0)));
+
+    if (aWeights.x + aWeights.y + aWeights.z + aWeights.w > 0.0) 
+    {
+        highp mat4 animMat = mat4(0.0);
+        animMat[3].w = 1.0; // last row is [0.0, 0.0, 0.0, 1.0]
+        int row = int(iParams.x); // each instance has its own row in the joint texture
+    
+        for (int i = 0; i < 4; i++)
+        {
+            int matIdx = int(aJoints[i]) * 3; // 3 because our matrix is: RGBA16f x 3
+            animMat[0] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 0, row), 0) * aWeights[i];
+            animMat[1] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 1, row), 0) * aWeights[i];
+            animMat[2] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 2, row), 0) * aWeights[i]; 
+        }
+        model = model * transpose(animMat);
+    }
+    else
+    {
+        model = model * uModel; // static meshes are moved by their node
+    }
 
     mediump mat3 normalMatrix = adjoint(model);
     vTBN[0] = normalize(normalMatrix * aTangent.xyz); 
     vTBN[2] = normalize(normalMatrix * aNormal);
     vTBN[1] = cross(vTBN[0], vTBN[2]) * aTangent.w;
     
-    highp vec4 outPos = model * vec4(aPos, 1.0);
+    highp vec3 position = aPos * uPosScale.xyz + uPosOffset.xyz; // dequantize
+    highp vec4 outPos = model * vec4(position, 1.0);
+    vTexCoords  = aTexCoords; 
+    gl_Position = uViewProj * outPos;
+}
+@end
+
+// same as vs, normal and tangent are packed into 4 bytes with octahedral encoding (PackOctahedralTangent in Graphics.h)
+@vs vs_oct
+layout(binding = 0) uniform vs_params {
+    highp mat4 mvp;
+    highp mat4 uModel;
+    highp mat4 uLightMatrix;
+    highp mat4 uViewProj;
+    highp vec4 uPosScale;
+    highp vec4 uPosOffset;
+};
+
+layout(location = 0) in highp   vec3  aPos;
+layout(location = 1) in lowp    uvec4 aNormalTangent; // bytes of the packed uint32
+layout(location = 2) in mediump vec2  aTexCoords;
+layout(location = 3) in lowp    uvec4 aJoints;
+layout(location = 4) in lowp    vec4  aWeights;
+layout(location = 5) in highp   vec4  iModel0;
+layout(location = 6) in highp   vec4  iModel1;
+layout(location = 7) in highp   vec4  iModel2;
+layout(location = 8) in highp   vec4  iParams;
+
+@image_sample_type uAnimTex unfilterable_float
+layout(binding = 1) uniform texture2D uAnimTex;
+
+@sampler_type smp nonfiltering
+layout(binding = 1) uniform sampler smp;
+
+out mediump vec2 vTexCoords;
+out lowp    mat3 vTBN;
+
+highp mat3 adjoint(in highp mat4 m)
+{
+    return mat3(cross(m[1].xyz, m[2].xyz),
+                cross(m[2].xyz, m[0].xyz),
+                cross(m[0].xyz, m[1].xyz));
+}
+
+void main() {
+    highp mat4 model = transpose(mat4(iModel0, iModel1, iModel2, vec4(0.0, 0.0, 0.0, 1.0)));
+
+    if (aWeights.x + aWeights.y + aWeights.z + aWeights.w > 0.0) 
+    {
+        highp mat4 animMat = mat4(0.0);
+        animMat[3].w = 1.0;
+        int row = int(iParams.x);
+    
+        for (int i = 0; i < 4; i++)
+        {
+            int matIdx = int(aJoints[i]) * 3;
+            animMat[0] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 0, row), 0) * aWeights[i];
+            animMat[1] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 1, row), 0) * aWeights[i];
+            animMat[2] += texelFetch(sampler2D(uAnimTex, smp), ivec2(matIdx + 2, row), 0) * aWeights[i]; 
+        }
+        model = model * transpose(animMat);
+    }
+    else
+    {
+        model = model * uModel; // static meshes are moved by their node
+    }
+    
+    highp uint normalTangent = aNormalTangent.x | (aNormalTangent.y << 8u) | (aNormalTangent.z << 16u) | (aNormalTangent.w << 24u);
+    
+    // octahedral normal, hemisphere is decided with integers so the basis below is same as the encoder's
+    highp ivec2 q = ivec2(int(normalTangent & 1023u), int((normalTangent >> 10u) & 1023u));
+    highp vec3 normal = vec3(vec2(q) * (2.0 / 1023.0) - 1.0, 0.0);
+    normal.z = 1.0 - abs(normal.x) - abs(normal.y);
+    bool upper = abs(2 * q.x - 1023) + abs(2 * q.y - 1023) <= 1023;
+    if (!upper) {
+        normal.xy = (1.0 - abs(normal.yx)) * vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+    }
+    normal = normalize(normal);
+    
+    // orthonormal basis around the normal, Duff et al. 2017
+    highp float s = upper ? 1.0 : -1.0;
+    highp float a = -1.0 / (s + normal.z);
+    highp float b = normal.x * normal.y * a;
+    highp vec3 b1 = vec3(1.0 + s * normal.x * normal.x * a, s * b, -s * normal.x);
+    highp vec3 b2 = vec3(b, s + normal.y * normal.y * a, -normal.y);
+    
+    // tangent is a point on the diamond |x| + |y| = 1 in this basis
+    highp float p = float((normalTangent >> 20u) & 2047u) * (4.0 / 2048.0);
+    highp float f = fract(p);
+    int quadrant = int(p);
+    highp vec2 d = quadrant == 0 ? vec2(1.0 - f, f) : quadrant == 1 ? vec2(-f, 1.0 - f) : quadrant == 2 ? vec2(f - 1.0, -f) : vec2(f, f - 1.0);
+    highp vec3 tangent = normalize(b1 * d.x + b2 * d.y);
+    highp float bitangentSign = (normalTangent >> 31u) != 0u ? -1.0 : 1.0;
+    
+    mediump mat3 normalMatrix = adjoint(model);
+    vTBN[0] = normalize(normalMatrix * tangent); 
+    vTBN[2] = normalize(normalMatrix * normal);
+    vTBN[1] = cross(vTBN[0], vTBN[2]) * bitangentSign;
+    
+    highp vec3 position = aPos * uPosScale.xyz + uPosOffset.xyz; // dequantize
+    highp vec4 outPos = model * vec4(position, 1.0);
     vTexCoords  = aTexCoords; 
     gl_Position = uViewProj * outPos;
 }
@@ -77,4 +187,5 @@ void main() {
     frag_color = texture(sampler2D(tex, texSampler), vTexCoords); //  * color;
 }
 @end
-@program cube vs fs
\ No newline at end of file
+@program cube vs fs
+@program cube_oct vs_oct fs
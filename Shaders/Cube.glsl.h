@@ -20,10 +20,36 @@
             ATTR_cube_aTexCoords => 3
             ATTR_cube_aJoints => 4
             ATTR_cube_aWeights => 5
+            ATTR_cube_iModel0 => 6
+            ATTR_cube_iModel1 => 7
+            ATTR_cube_iModel2 => 8
+            ATTR_cube_iParams => 9
+    Shader program: 'cube_oct':
+        Get shader desc: cube_oct_shader_desc(sg_query_backend());
+        Vertex Shader: vs_oct
+        Fragment Shader: fs
+        Attributes:
+            ATTR_cube_oct_aPos => 0
+            ATTR_cube_oct_aNormalTangent => 1
+            ATTR_cube_oct_aTexCoords => 2
+            ATTR_cube_oct_aJoints => 3
+            ATTR_cube_oct_aWeights => 4
+            ATTR_cube_oct_iModel0 => 5
+            ATTR_cube_oct_iModel1 => 6
+            ATTR_cube_oct_iModel2 => 7
+            ATTR_cube_oct_iParams => 8
     Bindings:
         Uniform block 'vs_params':
             C struct: vs_params_t
             Bind slot: UB_vs_params => 0
+        Image 'uAnimTex':
+            Image type: SG_IMAGETYPE_2D
+            Sample type: SG_IMAGESAMPLETYPE_UNFILTERABLE_FLOAT
+            Multisampled: false
+            Bind slot: IMG_uAnimTex => 1
+        Sampler 'smp':
+            Type: SG_SAMPLERTYPE_NONFILTERING
+            Bind slot: SMP_smp => 1
         Image 'tex':
             Image type: SG_IMAGETYPE_2D
             Sample type: SG_IMAGESAMPLETYPE_FLOAT
@@ -49,7 +75,22 @@
 #define ATTR_cube_aTexCoords (3)
 #define ATTR_cube_aJoints (4)
 #define ATTR_cube_aWeights (5)
+#define ATTR_cube_iModel0 (6)
+#define ATTR_cube_iModel1 (7)
+#define ATTR_cube_iModel2 (8)
+#define ATTR_cube_iParams (9)
+#define ATTR_cube_oct_aPos (0)
+#define ATTR_cube_oct_aNormalTangent (1)
+#define ATTR_cube_oct_aTexCoords (2)
+#define ATTR_cube_oct_aJoints (3)
+#define ATTR_cube_oct_aWeights (4)
+#define ATTR_cube_oct_iModel0 (5)
+#define ATTR_cube_oct_iModel1 (6)
+#define ATTR_cube_oct_iModel2 (7)
+#define ATTR_cube_oct_iParams (8)
 #define UB_vs_params (0)
+#define IMG_uAnimTex (1)
+#define SMP_smp (1)
 #define IMG_tex (0)
 #define SMP_texSampler (0)
 #pragma pack(push,1)
@@ -58,6 +99,8 @@ SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
     Matrix4 uModel;
     Matrix4 uLightMatrix;
     Matrix4 uViewProj;
+    float uPosScale[4];
+    float uPosOffset[4];
 } vs_params_t;
 #pragma pack(pop)
 /*
@@ -67,8 +110,12 @@ SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
         row_major float4x4 _62_uModel : packoffset(c4);
         row_major float4x4 _62_uLightMatrix : packoffset(c8);
         row_major float4x4 _62_uViewProj : packoffset(c12);
+        float4 _62_uPosScale : packoffset(c16);
+        float4 _62_uPosOffset : packoffset(c17);
     };
 
+    Texture2D<float4> uAnimTex : register(t1);
+    SamplerState smp : register(s1);
 
     static float4 gl_Position;
     static float3x3 vTBN;
@@ -79,6 +126,10 @@ SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
     static float2 aTexCoords;
     static uint4 aJoints;
     static float4 aWeights;
+    static float4 iModel0;
+    static float4 iModel1;
+    static float4 iModel2;
+    static float4 iParams;
 
     struct SPIRV_Cross_Input
     {
@@ -88,6 +139,10 @@ SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
         float2 aTexCoords : TEXCOORD3;
         uint4 aJoints : TEXCOORD4;
         float4 aWeights : TEXCOORD5;
+        float4 iModel0 : TEXCOORD6;
+        float4 iModel1 : TEXCOORD7;
+        float4 iModel2 : TEXCOORD8;
+        float4 iParams : TEXCOORD9;
     };
 
     struct SPIRV_Cross_Output
@@ -104,13 +159,32 @@ SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
 
     void vert_main()
     {
-        float4x4 param = _62_uModel;
+        float4x4 model = transpose(float4x4(iModel0, iModel1, iModel2, float4(0.0f, 0.0f, 0.0f, 1.0f)));
+        if ((((aWeights.x + aWeights.y) + aWeights.z) + aWeights.w) > 0.0f)
+        {
+            float4x4 animMat = float4x4(0.0f.xxxx, 0.0f.xxxx, 0.0f.xxxx, 0.0f.xxxx);
+            animMat[3].w = 1.0f;
+            int row = int(iParams.x);
+            for (int i = 0; i < 4; i++)
+            {
+                int matIdx = int(aJoints[i]) * 3;
+                animMat[0] += (uAnimTex.Load(int3(int2(matIdx + 0, row), 0)) * aWeights[i]);
+                animMat[1] += (uAnimTex.Load(int3(int2(matIdx + 1, row), 0)) * aWeights[i]);
+                animMat[2] += (uAnimTex.Load(int3(int2(matIdx + 2, row), 0)) * aWeights[i]);
+            }
+            model = mul(transpose(animMat), model);
+        }
+        else
+        {
+            model = mul(_62_uModel, model);
+        }
+        float4x4 param = model;
         float3x3 _70 = adjoint(param);
         vTBN[0] = normalize(mul(aTangent.xyz, _70));
         vTBN[2] = normalize(mul(aNormal, _70));
         vTBN[1] = cross(vTBN[0], vTBN[2]) * aTangent.w;
         vTexCoords = aTexCoords;
-        gl_Position = mul(mul(float4(aPos, 1.0f), _62_uModel), _62_uViewProj);
+        gl_Position = mul(mul(float4((aPos * _62_uPosScale.xyz) + _62_uPosOffset.xyz, 1.0f), model), _62_uViewProj);
     }
 
     SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
@@ -121,6 +195,10 @@ SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
         aTexCoords = stage_input.aTexCoords;
         aJoints = stage_input.aJoints;
         aWeights = stage_input.aWeights;
+        iModel0 = stage_input.iModel0;
+        iModel1 = stage_input.iModel1;
+        iModel2 = stage_input.iModel2;
+        iParams = stage_input.iParams;
         vert_main();
         SPIRV_Cross_Output stage_output;
         stage_output.gl_Position = gl_Position;
@@ -129,7 +207,7 @@ SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
         return stage_output;
     }
 */
-static const uint8_t vs_source_hlsl5[1774] = {
+static const uint8_t vs_source_hlsl5[3139] = {
     0x63,0x62,0x75,0x66,0x66,0x65,0x72,0x20,0x76,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,
     0x73,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x62,0x30,0x29,
     0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,
@@ -145,102 +223,188 @@ static const uint8_t vs_source_hlsl5[1774] = {
     0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,0x20,
     0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x5f,0x36,0x32,0x5f,0x75,0x56,0x69,
     0x65,0x77,0x50,0x72,0x6f,0x6a,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,
-    0x73,0x65,0x74,0x28,0x63,0x31,0x32,0x29,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x0a,0x73,
-    0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x5f,
-    0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,
-    0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x76,0x54,0x42,0x4e,0x3b,0x0a,
-    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x61,0x54,
-    0x61,0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,
-    0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x73,
-    0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x50,0x6f,
-    0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,
-    0x20,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x73,0x74,0x61,
-    0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x61,0x54,0x65,0x78,0x43,
-    0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x75,0x69,
-    0x6e,0x74,0x34,0x20,0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,0x3b,0x0a,0x73,0x74,0x61,
-    0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x61,0x57,0x65,0x69,0x67,
-    0x68,0x74,0x73,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,
-    0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,0x7b,
-    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x50,0x6f,0x73,
-    0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,
-    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,
-    0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,
-    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x61,0x54,0x61,0x6e,0x67,0x65,0x6e,
-    0x74,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x32,0x3b,0x0a,0x20,
-    0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x61,0x54,0x65,0x78,0x43,0x6f,
-    0x6f,0x72,0x64,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x33,
-    0x3b,0x0a,0x20,0x20,0x20,0x20,0x75,0x69,0x6e,0x74,0x34,0x20,0x61,0x4a,0x6f,0x69,
-    0x6e,0x74,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x34,0x3b,
-    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x61,0x57,0x65,0x69,
-    0x67,0x68,0x74,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x35,
-    0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,
-    0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x0a,
-    0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x54,0x65,
-    0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,
-    0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,
-    0x33,0x20,0x76,0x54,0x42,0x4e,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,
-    0x44,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,
-    0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3a,0x20,0x53,0x56,0x5f,
-    0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x66,0x6c,
-    0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x61,0x64,0x6a,0x6f,0x69,0x6e,0x74,0x28,0x66,
-    0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x6d,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,
-    0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,0x33,
-    0x28,0x63,0x72,0x6f,0x73,0x73,0x28,0x6d,0x5b,0x31,0x5d,0x2e,0x78,0x79,0x7a,0x2c,
-    0x20,0x6d,0x5b,0x32,0x5d,0x2e,0x78,0x79,0x7a,0x29,0x2c,0x20,0x63,0x72,0x6f,0x73,
-    0x73,0x28,0x6d,0x5b,0x32,0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x6d,0x5b,0x30,0x5d,
-    0x2e,0x78,0x79,0x7a,0x29,0x2c,0x20,0x63,0x72,0x6f,0x73,0x73,0x28,0x6d,0x5b,0x30,
-    0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x6d,0x5b,0x31,0x5d,0x2e,0x78,0x79,0x7a,0x29,
-    0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x76,0x65,0x72,0x74,0x5f,
-    0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
-    0x61,0x74,0x34,0x78,0x34,0x20,0x70,0x61,0x72,0x61,0x6d,0x20,0x3d,0x20,0x5f,0x36,
-    0x32,0x5f,0x75,0x4d,0x6f,0x64,0x65,0x6c,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
-    0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x5f,0x37,0x30,0x20,0x3d,0x20,0x61,0x64,0x6a,
-    0x6f,0x69,0x6e,0x74,0x28,0x70,0x61,0x72,0x61,0x6d,0x29,0x3b,0x0a,0x20,0x20,0x20,
-    0x20,0x76,0x54,0x42,0x4e,0x5b,0x30,0x5d,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,
-    0x6c,0x69,0x7a,0x65,0x28,0x6d,0x75,0x6c,0x28,0x61,0x54,0x61,0x6e,0x67,0x65,0x6e,
-    0x74,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x5f,0x37,0x30,0x29,0x29,0x3b,0x0a,0x20,0x20,
-    0x20,0x20,0x76,0x54,0x42,0x4e,0x5b,0x32,0x5d,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,
-    0x61,0x6c,0x69,0x7a,0x65,0x28,0x6d,0x75,0x6c,0x28,0x61,0x4e,0x6f,0x72,0x6d,0x61,
-    0x6c,0x2c,0x20,0x5f,0x37,0x30,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x54,
-    0x42,0x4e,0x5b,0x31,0x5d,0x20,0x3d,0x20,0x63,0x72,0x6f,0x73,0x73,0x28,0x76,0x54,
-    0x42,0x4e,0x5b,0x30,0x5d,0x2c,0x20,0x76,0x54,0x42,0x4e,0x5b,0x32,0x5d,0x29,0x20,
-    0x2a,0x20,0x61,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x77,0x3b,0x0a,0x20,0x20,
-    0x20,0x20,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3d,0x20,0x61,
-    0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,
-    0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x6d,0x75,0x6c,
-    0x28,0x6d,0x75,0x6c,0x28,0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,0x61,0x50,0x6f,0x73,
-    0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x5f,0x36,0x32,0x5f,0x75,0x4d,0x6f,
-    0x64,0x65,0x6c,0x29,0x2c,0x20,0x5f,0x36,0x32,0x5f,0x75,0x56,0x69,0x65,0x77,0x50,
-    0x72,0x6f,0x6a,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,
-    0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,
-    0x28,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,
-    0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,
-    0x7b,0x0a,0x20,0x20,0x20,0x20,0x61,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3d,
-    0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x54,0x61,
-    0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x4e,0x6f,0x72,0x6d,
-    0x61,0x6c,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,
-    0x2e,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x50,
-    0x6f,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,
-    0x2e,0x61,0x50,0x6f,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x54,0x65,0x78,0x43,
-    0x6f,0x6f,0x72,0x64,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
-    0x70,0x75,0x74,0x2e,0x61,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,
-    0x20,0x20,0x20,0x20,0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,0x20,0x3d,0x20,0x73,0x74,
-    0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x4a,0x6f,0x69,0x6e,0x74,
-    0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x20,
-    0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x57,
-    0x65,0x69,0x67,0x68,0x74,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x72,0x74,
-    0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x53,0x50,0x49,
-    0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,
-    0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x20,0x20,
-    0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x67,
-    0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x67,0x6c,0x5f,
-    0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,
-    0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x76,0x54,0x42,0x4e,0x20,
-    0x3d,0x20,0x76,0x54,0x42,0x4e,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,
-    0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,
-    0x72,0x64,0x73,0x20,0x3d,0x20,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,
-    0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x74,0x61,
-    0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+    0x73,0x65,0x74,0x28,0x63,0x31,0x32,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x20,0x5f,0x36,0x32,0x5f,0x75,0x50,0x6f,0x73,0x53,0x63,0x61,
+    0x6c,0x65,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,
+    0x63,0x31,0x36,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x20,0x5f,0x36,0x32,0x5f,0x75,0x50,0x6f,0x73,0x4f,0x66,0x66,0x73,0x65,0x74,0x20,
+    0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x31,0x37,
+    0x29,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,
+    0x3c,0x66,0x6c,0x6f,0x61,0x74,0x34,0x3e,0x20,0x75,0x41,0x6e,0x69,0x6d,0x54,0x65,
+    0x78,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x74,0x31,0x29,
+    0x3b,0x0a,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x53,0x74,0x61,0x74,0x65,0x20,0x73,
+    0x6d,0x70,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x73,0x31,
+    0x29,0x3b,0x0a,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x73,
+    0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x76,
+    0x54,0x42,0x4e,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x34,0x20,0x61,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,0x73,0x74,0x61,
+    0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x4e,0x6f,0x72,0x6d,
+    0x61,0x6c,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x33,0x20,0x61,0x50,0x6f,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,
+    0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,
+    0x61,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,
+    0x69,0x63,0x20,0x75,0x69,0x6e,0x74,0x34,0x20,0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,
+    0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x30,0x3b,
+    0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,
+    0x4d,0x6f,0x64,0x65,0x6c,0x31,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x32,0x3b,0x0a,0x73,
+    0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x50,0x61,
+    0x72,0x61,0x6d,0x73,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,
+    0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,
+    0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x50,0x6f,
+    0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x4e,0x6f,0x72,0x6d,0x61,
+    0x6c,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x61,0x54,0x61,0x6e,0x67,0x65,
+    0x6e,0x74,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x32,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x61,0x54,0x65,0x78,0x43,
+    0x6f,0x6f,0x72,0x64,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,0x75,0x69,0x6e,0x74,0x34,0x20,0x61,0x4a,0x6f,
+    0x69,0x6e,0x74,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x34,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x61,0x57,0x65,
+    0x69,0x67,0x68,0x74,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x35,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x4d,
+    0x6f,0x64,0x65,0x6c,0x30,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x36,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x4d,
+    0x6f,0x64,0x65,0x6c,0x31,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x37,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x4d,
+    0x6f,0x64,0x65,0x6c,0x32,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x38,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x50,
+    0x61,0x72,0x61,0x6d,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x39,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,
+    0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x54,
+    0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,
+    0x78,0x33,0x20,0x76,0x54,0x42,0x4e,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,
+    0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3a,0x20,0x53,0x56,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x66,
+    0x6c,0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x61,0x64,0x6a,0x6f,0x69,0x6e,0x74,0x28,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x6d,0x29,0x0a,0x7b,0x0a,0x20,0x20,
+    0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,
+    0x33,0x28,0x63,0x72,0x6f,0x73,0x73,0x28,0x6d,0x5b,0x31,0x5d,0x2e,0x78,0x79,0x7a,
+    0x2c,0x20,0x6d,0x5b,0x32,0x5d,0x2e,0x78,0x79,0x7a,0x29,0x2c,0x20,0x63,0x72,0x6f,
+    0x73,0x73,0x28,0x6d,0x5b,0x32,0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x6d,0x5b,0x30,
+    0x5d,0x2e,0x78,0x79,0x7a,0x29,0x2c,0x20,0x63,0x72,0x6f,0x73,0x73,0x28,0x6d,0x5b,
+    0x30,0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x6d,0x5b,0x31,0x5d,0x2e,0x78,0x79,0x7a,
+    0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x76,0x65,0x72,0x74,
+    0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x20,0x3d,0x20,0x74,
+    0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,
+    0x34,0x28,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x30,0x2c,0x20,0x69,0x4d,0x6f,0x64,0x65,
+    0x6c,0x31,0x2c,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x32,0x2c,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,
+    0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x29,0x29,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x28,0x28,0x28,0x61,0x57,0x65,0x69,0x67,0x68,
+    0x74,0x73,0x2e,0x78,0x20,0x2b,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x2e,
+    0x79,0x29,0x20,0x2b,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x2e,0x7a,0x29,
+    0x20,0x2b,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x2e,0x77,0x29,0x20,0x3e,
+    0x20,0x30,0x2e,0x30,0x66,0x29,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x61,0x6e,
+    0x69,0x6d,0x4d,0x61,0x74,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,
+    0x28,0x30,0x2e,0x30,0x66,0x2e,0x78,0x78,0x78,0x78,0x2c,0x20,0x30,0x2e,0x30,0x66,
+    0x2e,0x78,0x78,0x78,0x78,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2e,0x78,0x78,0x78,0x78,
+    0x2c,0x20,0x30,0x2e,0x30,0x66,0x2e,0x78,0x78,0x78,0x78,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,0x74,0x5b,0x33,0x5d,
+    0x2e,0x77,0x20,0x3d,0x20,0x31,0x2e,0x30,0x66,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x72,0x6f,0x77,0x20,0x3d,0x20,0x69,0x6e,0x74,
+    0x28,0x69,0x50,0x61,0x72,0x61,0x6d,0x73,0x2e,0x78,0x29,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x66,0x6f,0x72,0x20,0x28,0x69,0x6e,0x74,0x20,0x69,0x20,
+    0x3d,0x20,0x30,0x3b,0x20,0x69,0x20,0x3c,0x20,0x34,0x3b,0x20,0x69,0x2b,0x2b,0x29,
+    0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x6d,0x61,0x74,0x49,0x64,
+    0x78,0x20,0x3d,0x20,0x69,0x6e,0x74,0x28,0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,0x5b,
+    0x69,0x5d,0x29,0x20,0x2a,0x20,0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,0x74,0x5b,0x30,0x5d,0x20,
+    0x2b,0x3d,0x20,0x28,0x75,0x41,0x6e,0x69,0x6d,0x54,0x65,0x78,0x2e,0x4c,0x6f,0x61,
+    0x64,0x28,0x69,0x6e,0x74,0x33,0x28,0x69,0x6e,0x74,0x32,0x28,0x6d,0x61,0x74,0x49,
+    0x64,0x78,0x20,0x2b,0x20,0x30,0x2c,0x20,0x72,0x6f,0x77,0x29,0x2c,0x20,0x30,0x29,
+    0x29,0x20,0x2a,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x5b,0x69,0x5d,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x61,0x6e,
+    0x69,0x6d,0x4d,0x61,0x74,0x5b,0x31,0x5d,0x20,0x2b,0x3d,0x20,0x28,0x75,0x41,0x6e,
+    0x69,0x6d,0x54,0x65,0x78,0x2e,0x4c,0x6f,0x61,0x64,0x28,0x69,0x6e,0x74,0x33,0x28,
+    0x69,0x6e,0x74,0x32,0x28,0x6d,0x61,0x74,0x49,0x64,0x78,0x20,0x2b,0x20,0x31,0x2c,
+    0x20,0x72,0x6f,0x77,0x29,0x2c,0x20,0x30,0x29,0x29,0x20,0x2a,0x20,0x61,0x57,0x65,
+    0x69,0x67,0x68,0x74,0x73,0x5b,0x69,0x5d,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,0x74,0x5b,0x32,
+    0x5d,0x20,0x2b,0x3d,0x20,0x28,0x75,0x41,0x6e,0x69,0x6d,0x54,0x65,0x78,0x2e,0x4c,
+    0x6f,0x61,0x64,0x28,0x69,0x6e,0x74,0x33,0x28,0x69,0x6e,0x74,0x32,0x28,0x6d,0x61,
+    0x74,0x49,0x64,0x78,0x20,0x2b,0x20,0x32,0x2c,0x20,0x72,0x6f,0x77,0x29,0x2c,0x20,
+    0x30,0x29,0x29,0x20,0x2a,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x5b,0x69,
+    0x5d,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x20,0x3d,0x20,0x6d,0x75,
+    0x6c,0x28,0x74,0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x61,0x6e,0x69,0x6d,
+    0x4d,0x61,0x74,0x29,0x2c,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x65,0x6c,0x73,0x65,0x0a,0x20,0x20,0x20,
+    0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x6d,0x6f,0x64,0x65,0x6c,
+    0x20,0x3d,0x20,0x6d,0x75,0x6c,0x28,0x5f,0x36,0x32,0x5f,0x75,0x4d,0x6f,0x64,0x65,
+    0x6c,0x2c,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,
+    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x70,0x61,
+    0x72,0x61,0x6d,0x20,0x3d,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x5f,0x37,0x30,0x20,0x3d,0x20,
+    0x61,0x64,0x6a,0x6f,0x69,0x6e,0x74,0x28,0x70,0x61,0x72,0x61,0x6d,0x29,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x76,0x54,0x42,0x4e,0x5b,0x30,0x5d,0x20,0x3d,0x20,0x6e,0x6f,
+    0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x6d,0x75,0x6c,0x28,0x61,0x54,0x61,0x6e,
+    0x67,0x65,0x6e,0x74,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x5f,0x37,0x30,0x29,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x76,0x54,0x42,0x4e,0x5b,0x32,0x5d,0x20,0x3d,0x20,0x6e,
+    0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x6d,0x75,0x6c,0x28,0x61,0x4e,0x6f,
+    0x72,0x6d,0x61,0x6c,0x2c,0x20,0x5f,0x37,0x30,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x76,0x54,0x42,0x4e,0x5b,0x31,0x5d,0x20,0x3d,0x20,0x63,0x72,0x6f,0x73,0x73,
+    0x28,0x76,0x54,0x42,0x4e,0x5b,0x30,0x5d,0x2c,0x20,0x76,0x54,0x42,0x4e,0x5b,0x32,
+    0x5d,0x29,0x20,0x2a,0x20,0x61,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x77,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,
+    0x3d,0x20,0x61,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,
+    0x6d,0x75,0x6c,0x28,0x6d,0x75,0x6c,0x28,0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,0x28,
+    0x61,0x50,0x6f,0x73,0x20,0x2a,0x20,0x5f,0x36,0x32,0x5f,0x75,0x50,0x6f,0x73,0x53,
+    0x63,0x61,0x6c,0x65,0x2e,0x78,0x79,0x7a,0x29,0x20,0x2b,0x20,0x5f,0x36,0x32,0x5f,
+    0x75,0x50,0x6f,0x73,0x4f,0x66,0x66,0x73,0x65,0x74,0x2e,0x78,0x79,0x7a,0x2c,0x20,
+    0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x29,0x2c,0x20,0x5f,
+    0x36,0x32,0x5f,0x75,0x56,0x69,0x65,0x77,0x50,0x72,0x6f,0x6a,0x29,0x3b,0x0a,0x7d,
+    0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,
+    0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x28,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x61,
+    0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,
+    0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x73,0x74,
+    0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x4e,0x6f,0x72,0x6d,0x61,
+    0x6c,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x50,0x6f,0x73,0x20,0x3d,0x20,0x73,0x74,
+    0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x50,0x6f,0x73,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x61,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3d,
+    0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x54,0x65,
+    0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x4a,0x6f,
+    0x69,0x6e,0x74,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,
+    0x75,0x74,0x2e,0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,
+    0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x30,0x20,0x3d,0x20,0x73,
+    0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,0x4d,0x6f,0x64,0x65,
+    0x6c,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x31,0x20,
+    0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,0x4d,
+    0x6f,0x64,0x65,0x6c,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x4d,0x6f,0x64,0x65,
+    0x6c,0x32,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,
+    0x2e,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x32,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x50,
+    0x61,0x72,0x61,0x6d,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
+    0x70,0x75,0x74,0x2e,0x69,0x50,0x61,0x72,0x61,0x6d,0x73,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,
+    0x74,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,
+    0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,
+    0x70,0x75,0x74,0x2e,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,
+    0x3d,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,
+    0x76,0x54,0x42,0x4e,0x20,0x3d,0x20,0x76,0x54,0x42,0x4e,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x76,0x54,
+    0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3d,0x20,0x76,0x54,0x65,0x78,0x43,
+    0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,
+    0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,
+    0x7d,0x0a,0x00,
 };
 /*
     Texture2D<float4> tex : register(t0);
@@ -319,6 +483,433 @@ static const uint8_t fs_source_hlsl5[645] = {
     0x75,0x72,0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,
     0x3b,0x0a,0x7d,0x0a,0x00,
 };
+/*
+    cbuffer vs_params : register(b0)
+    {
+        row_major float4x4 _62_mvp : packoffset(c0);
+        row_major float4x4 _62_uModel : packoffset(c4);
+        row_major float4x4 _62_uLightMatrix : packoffset(c8);
+        row_major float4x4 _62_uViewProj : packoffset(c12);
+        float4 _62_uPosScale : packoffset(c16);
+        float4 _62_uPosOffset : packoffset(c17);
+    };
+
+    Texture2D<float4> uAnimTex : register(t1);
+    SamplerState smp : register(s1);
+
+    static float4 gl_Position;
+    static uint4 aNormalTangent;
+    static float3x3 vTBN;
+    static float3 aPos;
+    static float2 vTexCoords;
+    static float2 aTexCoords;
+    static uint4 aJoints;
+    static float4 aWeights;
+    static float4 iModel0;
+    static float4 iModel1;
+    static float4 iModel2;
+    static float4 iParams;
+
+    struct SPIRV_Cross_Input
+    {
+        float3 aPos : TEXCOORD0;
+        uint4 aNormalTangent : TEXCOORD1;
+        float2 aTexCoords : TEXCOORD2;
+        uint4 aJoints : TEXCOORD3;
+        float4 aWeights : TEXCOORD4;
+        float4 iModel0 : TEXCOORD5;
+        float4 iModel1 : TEXCOORD6;
+        float4 iModel2 : TEXCOORD7;
+        float4 iParams : TEXCOORD8;
+    };
+
+    struct SPIRV_Cross_Output
+    {
+        float2 vTexCoords : TEXCOORD0;
+        float3x3 vTBN : TEXCOORD1;
+        float4 gl_Position : SV_Position;
+    };
+
+    float3x3 adjoint(float4x4 m)
+    {
+        return float3x3(cross(m[1].xyz, m[2].xyz), cross(m[2].xyz, m[0].xyz), cross(m[0].xyz, m[1].xyz));
+    }
+
+    void vert_main()
+    {
+        float4x4 model = transpose(float4x4(iModel0, iModel1, iModel2, float4(0.0f, 0.0f, 0.0f, 1.0f)));
+        if ((((aWeights.x + aWeights.y) + aWeights.z) + aWeights.w) > 0.0f)
+        {
+            float4x4 animMat = float4x4(0.0f.xxxx, 0.0f.xxxx, 0.0f.xxxx, 0.0f.xxxx);
+            animMat[3].w = 1.0f;
+            int row = int(iParams.x);
+            for (int i = 0; i < 4; i++)
+            {
+                int matIdx = int(aJoints[i]) * 3;
+                animMat[0] += (uAnimTex.Load(int3(int2(matIdx + 0, row), 0)) * aWeights[i]);
+                animMat[1] += (uAnimTex.Load(int3(int2(matIdx + 1, row), 0)) * aWeights[i]);
+                animMat[2] += (uAnimTex.Load(int3(int2(matIdx + 2, row), 0)) * aWeights[i]);
+            }
+            model = mul(transpose(animMat), model);
+        }
+        else
+        {
+            model = mul(_62_uModel, model);
+        }
+        uint normalTangent = ((aNormalTangent.x | (aNormalTangent.y << 8u)) | (aNormalTangent.z << 16u)) | (aNormalTangent.w << 24u);
+        int2 q = int2(int(normalTangent & 1023u), int((normalTangent >> 10u) & 1023u));
+        float3 normal = float3((float2(q) * 0.001955034211277961730957031250f) - 1.0f.xx, 0.0f);
+        normal.z = (1.0f - abs(normal.x)) - abs(normal.y);
+        bool upper = (abs((2 * q.x) - 1023) + abs((2 * q.y) - 1023)) <= 1023;
+        if (!upper)
+        {
+            float2 _128 = (1.0f.xx - abs(normal.yx)) * float2((normal.x >= 0.0f) ? 1.0f : (-1.0f), (normal.y >= 0.0f) ? 1.0f : (-1.0f));
+            normal = float3(_128.x, _128.y, normal.z);
+        }
+        normal = normalize(normal);
+        float s = upper ? 1.0f : (-1.0f);
+        float a = (-1.0f) / (s + normal.z);
+        float b = (normal.x * normal.y) * a;
+        float3 b1 = float3(1.0f + (((s * normal.x) * normal.x) * a), s * b, (-s) * normal.x);
+        float3 b2 = float3(b, s + ((normal.y * normal.y) * a), -normal.y);
+        float p = float((normalTangent >> 20u) & 2047u) * 0.001953125f;
+        float f = frac(p);
+        int quadrant = int(p);
+        float2 d;
+        if (quadrant == 0)
+        {
+            d = float2(1.0f - f, f);
+        }
+        else
+        {
+            if (quadrant == 1)
+            {
+                d = float2(-f, 1.0f - f);
+            }
+            else
+            {
+                d = (quadrant == 2) ? float2(f - 1.0f, -f) : float2(f, f - 1.0f);
+            }
+        }
+        float3 tangent = normalize((b1 * d.x) + (b2 * d.y));
+        float bitangentSign = ((normalTangent >> 31u) != 0u) ? (-1.0f) : 1.0f;
+        float4x4 param = model;
+        float3x3 _245 = adjoint(param);
+        vTBN[0] = normalize(mul(tangent, _245));
+        vTBN[2] = normalize(mul(normal, _245));
+        vTBN[1] = cross(vTBN[0], vTBN[2]) * bitangentSign;
+        vTexCoords = aTexCoords;
+        gl_Position = mul(mul(float4((aPos * _62_uPosScale.xyz) + _62_uPosOffset.xyz, 1.0f), model), _62_uViewProj);
+    }
+
+    SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+    {
+        aNormalTangent = stage_input.aNormalTangent;
+        aPos = stage_input.aPos;
+        aTexCoords = stage_input.aTexCoords;
+        aJoints = stage_input.aJoints;
+        aWeights = stage_input.aWeights;
+        iModel0 = stage_input.iModel0;
+        iModel1 = stage_input.iModel1;
+        iModel2 = stage_input.iModel2;
+        iParams = stage_input.iParams;
+        vert_main();
+        SPIRV_Cross_Output stage_output;
+        stage_output.gl_Position = gl_Position;
+        stage_output.vTBN = vTBN;
+        stage_output.vTexCoords = vTexCoords;
+        return stage_output;
+    }
+*/
+static const uint8_t vs_oct_source_hlsl5[4580] = {
+    0x63,0x62,0x75,0x66,0x66,0x65,0x72,0x20,0x76,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,
+    0x73,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x62,0x30,0x29,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x5f,0x36,0x32,0x5f,0x6d,0x76,
+    0x70,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,
+    0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,
+    0x72,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x5f,0x36,0x32,0x5f,0x75,
+    0x4d,0x6f,0x64,0x65,0x6c,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,
+    0x65,0x74,0x28,0x63,0x34,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x6f,0x77,0x5f,
+    0x6d,0x61,0x6a,0x6f,0x72,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x5f,
+    0x36,0x32,0x5f,0x75,0x4c,0x69,0x67,0x68,0x74,0x4d,0x61,0x74,0x72,0x69,0x78,0x20,
+    0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x38,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x5f,0x36,0x32,0x5f,0x75,0x56,0x69,
+    0x65,0x77,0x50,0x72,0x6f,0x6a,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,
+    0x73,0x65,0x74,0x28,0x63,0x31,0x32,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x20,0x5f,0x36,0x32,0x5f,0x75,0x50,0x6f,0x73,0x53,0x63,0x61,
+    0x6c,0x65,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,
+    0x63,0x31,0x36,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x20,0x5f,0x36,0x32,0x5f,0x75,0x50,0x6f,0x73,0x4f,0x66,0x66,0x73,0x65,0x74,0x20,
+    0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x31,0x37,
+    0x29,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,
+    0x3c,0x66,0x6c,0x6f,0x61,0x74,0x34,0x3e,0x20,0x75,0x41,0x6e,0x69,0x6d,0x54,0x65,
+    0x78,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x74,0x31,0x29,
+    0x3b,0x0a,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x53,0x74,0x61,0x74,0x65,0x20,0x73,
+    0x6d,0x70,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x73,0x31,
+    0x29,0x3b,0x0a,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x73,
+    0x74,0x61,0x74,0x69,0x63,0x20,0x75,0x69,0x6e,0x74,0x34,0x20,0x61,0x4e,0x6f,0x72,
+    0x6d,0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x3b,0x0a,0x73,0x74,0x61,0x74,
+    0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x76,0x54,0x42,0x4e,
+    0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,
+    0x61,0x50,0x6f,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x32,0x20,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x61,0x54,
+    0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,
+    0x20,0x75,0x69,0x6e,0x74,0x34,0x20,0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,0x3b,0x0a,
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x61,0x57,
+    0x65,0x69,0x67,0x68,0x74,0x73,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x30,0x3b,0x0a,0x73,
+    0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x4d,0x6f,
+    0x64,0x65,0x6c,0x31,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x32,0x3b,0x0a,0x73,0x74,0x61,
+    0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x69,0x50,0x61,0x72,0x61,
+    0x6d,0x73,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,
+    0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,0x7b,0x0a,
+    0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x61,0x50,0x6f,0x73,0x20,
+    0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x75,0x69,0x6e,0x74,0x34,0x20,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x61,
+    0x6e,0x67,0x65,0x6e,0x74,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x61,0x54,
+    0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x32,0x3b,0x0a,0x20,0x20,0x20,0x20,0x75,0x69,0x6e,0x74,0x34,0x20,
+    0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,
+    0x52,0x44,0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x34,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x30,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x35,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x31,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x36,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x32,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x37,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x20,0x69,0x50,0x61,0x72,0x61,0x6d,0x73,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x38,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,
+    0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,
+    0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,
+    0x20,0x76,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3a,0x20,0x54,0x45,
+    0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x33,0x78,0x33,0x20,0x76,0x54,0x42,0x4e,0x20,0x3a,0x20,0x54,0x45,0x58,
+    0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3a,
+    0x20,0x53,0x56,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x7d,0x3b,
+    0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,0x33,0x20,0x61,0x64,0x6a,0x6f,0x69,
+    0x6e,0x74,0x28,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x6d,0x29,0x0a,0x7b,
+    0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x33,0x78,0x33,0x28,0x63,0x72,0x6f,0x73,0x73,0x28,0x6d,0x5b,0x31,0x5d,0x2e,
+    0x78,0x79,0x7a,0x2c,0x20,0x6d,0x5b,0x32,0x5d,0x2e,0x78,0x79,0x7a,0x29,0x2c,0x20,
+    0x63,0x72,0x6f,0x73,0x73,0x28,0x6d,0x5b,0x32,0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,
+    0x6d,0x5b,0x30,0x5d,0x2e,0x78,0x79,0x7a,0x29,0x2c,0x20,0x63,0x72,0x6f,0x73,0x73,
+    0x28,0x6d,0x5b,0x30,0x5d,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x6d,0x5b,0x31,0x5d,0x2e,
+    0x78,0x79,0x7a,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x76,
+    0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x20,
+    0x3d,0x20,0x74,0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x66,0x6c,0x6f,0x61,
+    0x74,0x34,0x78,0x34,0x28,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x30,0x2c,0x20,0x69,0x4d,
+    0x6f,0x64,0x65,0x6c,0x31,0x2c,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x32,0x2c,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,
+    0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x29,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x28,0x28,0x28,0x61,0x57,0x65,
+    0x69,0x67,0x68,0x74,0x73,0x2e,0x78,0x20,0x2b,0x20,0x61,0x57,0x65,0x69,0x67,0x68,
+    0x74,0x73,0x2e,0x79,0x29,0x20,0x2b,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,
+    0x2e,0x7a,0x29,0x20,0x2b,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x2e,0x77,
+    0x29,0x20,0x3e,0x20,0x30,0x2e,0x30,0x66,0x29,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x78,0x34,
+    0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,0x74,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x78,0x34,0x28,0x30,0x2e,0x30,0x66,0x2e,0x78,0x78,0x78,0x78,0x2c,0x20,0x30,
+    0x2e,0x30,0x66,0x2e,0x78,0x78,0x78,0x78,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2e,0x78,
+    0x78,0x78,0x78,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2e,0x78,0x78,0x78,0x78,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,0x74,
+    0x5b,0x33,0x5d,0x2e,0x77,0x20,0x3d,0x20,0x31,0x2e,0x30,0x66,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x72,0x6f,0x77,0x20,0x3d,0x20,
+    0x69,0x6e,0x74,0x28,0x69,0x50,0x61,0x72,0x61,0x6d,0x73,0x2e,0x78,0x29,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x66,0x6f,0x72,0x20,0x28,0x69,0x6e,0x74,
+    0x20,0x69,0x20,0x3d,0x20,0x30,0x3b,0x20,0x69,0x20,0x3c,0x20,0x34,0x3b,0x20,0x69,
+    0x2b,0x2b,0x29,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x6d,0x61,
+    0x74,0x49,0x64,0x78,0x20,0x3d,0x20,0x69,0x6e,0x74,0x28,0x61,0x4a,0x6f,0x69,0x6e,
+    0x74,0x73,0x5b,0x69,0x5d,0x29,0x20,0x2a,0x20,0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,0x74,0x5b,
+    0x30,0x5d,0x20,0x2b,0x3d,0x20,0x28,0x75,0x41,0x6e,0x69,0x6d,0x54,0x65,0x78,0x2e,
+    0x4c,0x6f,0x61,0x64,0x28,0x69,0x6e,0x74,0x33,0x28,0x69,0x6e,0x74,0x32,0x28,0x6d,
+    0x61,0x74,0x49,0x64,0x78,0x20,0x2b,0x20,0x30,0x2c,0x20,0x72,0x6f,0x77,0x29,0x2c,
+    0x20,0x30,0x29,0x29,0x20,0x2a,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x5b,
+    0x69,0x5d,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,0x74,0x5b,0x31,0x5d,0x20,0x2b,0x3d,0x20,0x28,
+    0x75,0x41,0x6e,0x69,0x6d,0x54,0x65,0x78,0x2e,0x4c,0x6f,0x61,0x64,0x28,0x69,0x6e,
+    0x74,0x33,0x28,0x69,0x6e,0x74,0x32,0x28,0x6d,0x61,0x74,0x49,0x64,0x78,0x20,0x2b,
+    0x20,0x31,0x2c,0x20,0x72,0x6f,0x77,0x29,0x2c,0x20,0x30,0x29,0x29,0x20,0x2a,0x20,
+    0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x5b,0x69,0x5d,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x61,0x6e,0x69,0x6d,0x4d,0x61,
+    0x74,0x5b,0x32,0x5d,0x20,0x2b,0x3d,0x20,0x28,0x75,0x41,0x6e,0x69,0x6d,0x54,0x65,
+    0x78,0x2e,0x4c,0x6f,0x61,0x64,0x28,0x69,0x6e,0x74,0x33,0x28,0x69,0x6e,0x74,0x32,
+    0x28,0x6d,0x61,0x74,0x49,0x64,0x78,0x20,0x2b,0x20,0x32,0x2c,0x20,0x72,0x6f,0x77,
+    0x29,0x2c,0x20,0x30,0x29,0x29,0x20,0x2a,0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,
+    0x73,0x5b,0x69,0x5d,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,
+    0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x20,0x3d,
+    0x20,0x6d,0x75,0x6c,0x28,0x74,0x72,0x61,0x6e,0x73,0x70,0x6f,0x73,0x65,0x28,0x61,
+    0x6e,0x69,0x6d,0x4d,0x61,0x74,0x29,0x2c,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x65,0x6c,0x73,0x65,0x0a,
+    0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x6d,0x6f,
+    0x64,0x65,0x6c,0x20,0x3d,0x20,0x6d,0x75,0x6c,0x28,0x5f,0x36,0x32,0x5f,0x75,0x4d,
+    0x6f,0x64,0x65,0x6c,0x2c,0x20,0x6d,0x6f,0x64,0x65,0x6c,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x75,0x69,0x6e,0x74,0x20,0x6e,0x6f,0x72,
+    0x6d,0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3d,0x20,0x28,0x28,0x61,
+    0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x78,0x20,
+    0x7c,0x20,0x28,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,0x6e,
+    0x74,0x2e,0x79,0x20,0x3c,0x3c,0x20,0x38,0x75,0x29,0x29,0x20,0x7c,0x20,0x28,0x61,
+    0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x7a,0x20,
+    0x3c,0x3c,0x20,0x31,0x36,0x75,0x29,0x29,0x20,0x7c,0x20,0x28,0x61,0x4e,0x6f,0x72,
+    0x6d,0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2e,0x77,0x20,0x3c,0x3c,0x20,
+    0x32,0x34,0x75,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x32,0x20,0x71,
+    0x20,0x3d,0x20,0x69,0x6e,0x74,0x32,0x28,0x69,0x6e,0x74,0x28,0x6e,0x6f,0x72,0x6d,
+    0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x26,0x20,0x31,0x30,0x32,0x33,
+    0x75,0x29,0x2c,0x20,0x69,0x6e,0x74,0x28,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x54,
+    0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3e,0x3e,0x20,0x31,0x30,0x75,0x29,0x20,0x26,
+    0x20,0x31,0x30,0x32,0x33,0x75,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x33,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x33,0x28,0x28,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x71,0x29,0x20,
+    0x2a,0x20,0x30,0x2e,0x30,0x30,0x31,0x39,0x35,0x35,0x30,0x33,0x34,0x32,0x31,0x31,
+    0x32,0x37,0x37,0x39,0x36,0x31,0x37,0x33,0x30,0x39,0x35,0x37,0x30,0x33,0x31,0x32,
+    0x35,0x30,0x66,0x29,0x20,0x2d,0x20,0x31,0x2e,0x30,0x66,0x2e,0x78,0x78,0x2c,0x20,
+    0x30,0x2e,0x30,0x66,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x6e,0x6f,0x72,0x6d,0x61,
+    0x6c,0x2e,0x7a,0x20,0x3d,0x20,0x28,0x31,0x2e,0x30,0x66,0x20,0x2d,0x20,0x61,0x62,
+    0x73,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x78,0x29,0x29,0x20,0x2d,0x20,0x61,
+    0x62,0x73,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x79,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x75,0x70,0x70,0x65,0x72,0x20,0x3d,0x20,0x28,
+    0x61,0x62,0x73,0x28,0x28,0x32,0x20,0x2a,0x20,0x71,0x2e,0x78,0x29,0x20,0x2d,0x20,
+    0x31,0x30,0x32,0x33,0x29,0x20,0x2b,0x20,0x61,0x62,0x73,0x28,0x28,0x32,0x20,0x2a,
+    0x20,0x71,0x2e,0x79,0x29,0x20,0x2d,0x20,0x31,0x30,0x32,0x33,0x29,0x29,0x20,0x3c,
+    0x3d,0x20,0x31,0x30,0x32,0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,
+    0x21,0x75,0x70,0x70,0x65,0x72,0x29,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x5f,0x31,0x32,
+    0x38,0x20,0x3d,0x20,0x28,0x31,0x2e,0x30,0x66,0x2e,0x78,0x78,0x20,0x2d,0x20,0x61,
+    0x62,0x73,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x79,0x78,0x29,0x29,0x20,0x2a,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,
+    0x78,0x20,0x3e,0x3d,0x20,0x30,0x2e,0x30,0x66,0x29,0x20,0x3f,0x20,0x31,0x2e,0x30,
+    0x66,0x20,0x3a,0x20,0x28,0x2d,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x28,0x6e,0x6f,
+    0x72,0x6d,0x61,0x6c,0x2e,0x79,0x20,0x3e,0x3d,0x20,0x30,0x2e,0x30,0x66,0x29,0x20,
+    0x3f,0x20,0x31,0x2e,0x30,0x66,0x20,0x3a,0x20,0x28,0x2d,0x31,0x2e,0x30,0x66,0x29,
+    0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x6e,0x6f,0x72,0x6d,0x61,
+    0x6c,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x5f,0x31,0x32,0x38,0x2e,
+    0x78,0x2c,0x20,0x5f,0x31,0x32,0x38,0x2e,0x79,0x2c,0x20,0x6e,0x6f,0x72,0x6d,0x61,
+    0x6c,0x2e,0x7a,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,
+    0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,
+    0x7a,0x65,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x20,0x73,0x20,0x3d,0x20,0x75,0x70,0x70,0x65,0x72,0x20,
+    0x3f,0x20,0x31,0x2e,0x30,0x66,0x20,0x3a,0x20,0x28,0x2d,0x31,0x2e,0x30,0x66,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x61,0x20,0x3d,0x20,
+    0x28,0x2d,0x31,0x2e,0x30,0x66,0x29,0x20,0x2f,0x20,0x28,0x73,0x20,0x2b,0x20,0x6e,
+    0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x7a,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x20,0x62,0x20,0x3d,0x20,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,
+    0x78,0x20,0x2a,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x79,0x29,0x20,0x2a,0x20,
+    0x61,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x62,0x31,
+    0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x31,0x2e,0x30,0x66,0x20,0x2b,
+    0x20,0x28,0x28,0x28,0x73,0x20,0x2a,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x78,
+    0x29,0x20,0x2a,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x78,0x29,0x20,0x2a,0x20,
+    0x61,0x29,0x2c,0x20,0x73,0x20,0x2a,0x20,0x62,0x2c,0x20,0x28,0x2d,0x73,0x29,0x20,
+    0x2a,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x78,0x29,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x62,0x32,0x20,0x3d,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x33,0x28,0x62,0x2c,0x20,0x73,0x20,0x2b,0x20,0x28,0x28,0x6e,0x6f,0x72,
+    0x6d,0x61,0x6c,0x2e,0x79,0x20,0x2a,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,0x79,
+    0x29,0x20,0x2a,0x20,0x61,0x29,0x2c,0x20,0x2d,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2e,
+    0x79,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x70,0x20,
+    0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x54,
+    0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3e,0x3e,0x20,0x32,0x30,0x75,0x29,0x20,0x26,
+    0x20,0x32,0x30,0x34,0x37,0x75,0x29,0x20,0x2a,0x20,0x30,0x2e,0x30,0x30,0x31,0x39,
+    0x35,0x33,0x31,0x32,0x35,0x66,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x20,0x66,0x20,0x3d,0x20,0x66,0x72,0x61,0x63,0x28,0x70,0x29,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x71,0x75,0x61,0x64,0x72,0x61,0x6e,0x74,0x20,
+    0x3d,0x20,0x69,0x6e,0x74,0x28,0x70,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x32,0x20,0x64,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,
+    0x71,0x75,0x61,0x64,0x72,0x61,0x6e,0x74,0x20,0x3d,0x3d,0x20,0x30,0x29,0x0a,0x20,
+    0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x64,0x20,0x3d,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x31,0x2e,0x30,0x66,0x20,0x2d,0x20,0x66,
+    0x2c,0x20,0x66,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,
+    0x65,0x6c,0x73,0x65,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x71,0x75,0x61,0x64,0x72,0x61,0x6e,0x74,0x20,
+    0x3d,0x3d,0x20,0x31,0x29,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7b,0x0a,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x64,0x20,0x3d,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x2d,0x66,0x2c,0x20,0x31,0x2e,0x30,0x66,0x20,
+    0x2d,0x20,0x66,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x0a,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x65,0x6c,0x73,0x65,0x0a,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x64,0x20,0x3d,0x20,0x28,0x71,0x75,0x61,0x64,0x72,0x61,0x6e,0x74,
+    0x20,0x3d,0x3d,0x20,0x32,0x29,0x20,0x3f,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,
+    0x66,0x20,0x2d,0x20,0x31,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x66,0x29,0x20,0x3a,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x66,0x2c,0x20,0x66,0x20,0x2d,0x20,0x31,0x2e,
+    0x30,0x66,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,
+    0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,
+    0x74,0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,
+    0x69,0x7a,0x65,0x28,0x28,0x62,0x31,0x20,0x2a,0x20,0x64,0x2e,0x78,0x29,0x20,0x2b,
+    0x20,0x28,0x62,0x32,0x20,0x2a,0x20,0x64,0x2e,0x79,0x29,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x62,0x69,0x74,0x61,0x6e,0x67,0x65,0x6e,
+    0x74,0x53,0x69,0x67,0x6e,0x20,0x3d,0x20,0x28,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,
+    0x54,0x61,0x6e,0x67,0x65,0x6e,0x74,0x20,0x3e,0x3e,0x20,0x33,0x31,0x75,0x29,0x20,
+    0x21,0x3d,0x20,0x30,0x75,0x29,0x20,0x3f,0x20,0x28,0x2d,0x31,0x2e,0x30,0x66,0x29,
+    0x20,0x3a,0x20,0x31,0x2e,0x30,0x66,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x78,0x34,0x20,0x70,0x61,0x72,0x61,0x6d,0x20,0x3d,0x20,0x6d,0x6f,
+    0x64,0x65,0x6c,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x78,
+    0x33,0x20,0x5f,0x32,0x34,0x35,0x20,0x3d,0x20,0x61,0x64,0x6a,0x6f,0x69,0x6e,0x74,
+    0x28,0x70,0x61,0x72,0x61,0x6d,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x54,0x42,
+    0x4e,0x5b,0x30,0x5d,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,
+    0x28,0x6d,0x75,0x6c,0x28,0x74,0x61,0x6e,0x67,0x65,0x6e,0x74,0x2c,0x20,0x5f,0x32,
+    0x34,0x35,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x54,0x42,0x4e,0x5b,0x32,
+    0x5d,0x20,0x3d,0x20,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x69,0x7a,0x65,0x28,0x6d,0x75,
+    0x6c,0x28,0x6e,0x6f,0x72,0x6d,0x61,0x6c,0x2c,0x20,0x5f,0x32,0x34,0x35,0x29,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x54,0x42,0x4e,0x5b,0x31,0x5d,0x20,0x3d,0x20,
+    0x63,0x72,0x6f,0x73,0x73,0x28,0x76,0x54,0x42,0x4e,0x5b,0x30,0x5d,0x2c,0x20,0x76,
+    0x54,0x42,0x4e,0x5b,0x32,0x5d,0x29,0x20,0x2a,0x20,0x62,0x69,0x74,0x61,0x6e,0x67,
+    0x65,0x6e,0x74,0x53,0x69,0x67,0x6e,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x54,0x65,
+    0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3d,0x20,0x61,0x54,0x65,0x78,0x43,0x6f,
+    0x6f,0x72,0x64,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,
+    0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x6d,0x75,0x6c,0x28,0x6d,0x75,0x6c,0x28,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,0x28,0x61,0x50,0x6f,0x73,0x20,0x2a,0x20,0x5f,
+    0x36,0x32,0x5f,0x75,0x50,0x6f,0x73,0x53,0x63,0x61,0x6c,0x65,0x2e,0x78,0x79,0x7a,
+    0x29,0x20,0x2b,0x20,0x5f,0x36,0x32,0x5f,0x75,0x50,0x6f,0x73,0x4f,0x66,0x66,0x73,
+    0x65,0x74,0x2e,0x78,0x79,0x7a,0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x6d,
+    0x6f,0x64,0x65,0x6c,0x29,0x2c,0x20,0x5f,0x36,0x32,0x5f,0x75,0x56,0x69,0x65,0x77,
+    0x50,0x72,0x6f,0x6a,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,
+    0x6e,0x28,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,
+    0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x61,
+    0x6e,0x67,0x65,0x6e,0x74,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
+    0x70,0x75,0x74,0x2e,0x61,0x4e,0x6f,0x72,0x6d,0x61,0x6c,0x54,0x61,0x6e,0x67,0x65,
+    0x6e,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x50,0x6f,0x73,0x20,0x3d,0x20,0x73,
+    0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x50,0x6f,0x73,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x61,0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,
+    0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x54,
+    0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x61,0x4a,
+    0x6f,0x69,0x6e,0x74,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
+    0x70,0x75,0x74,0x2e,0x61,0x4a,0x6f,0x69,0x6e,0x74,0x73,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x57,0x65,0x69,0x67,0x68,0x74,0x73,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x30,0x20,0x3d,0x20,
+    0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,0x4d,0x6f,0x64,
+    0x65,0x6c,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x31,
+    0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x69,
+    0x4d,0x6f,0x64,0x65,0x6c,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x4d,0x6f,0x64,
+    0x65,0x6c,0x32,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,
+    0x74,0x2e,0x69,0x4d,0x6f,0x64,0x65,0x6c,0x32,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,
+    0x50,0x61,0x72,0x61,0x6d,0x73,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,
+    0x6e,0x70,0x75,0x74,0x2e,0x69,0x50,0x61,0x72,0x61,0x6d,0x73,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,
+    0x75,0x74,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,
+    0x75,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,
+    0x74,0x70,0x75,0x74,0x2e,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,
+    0x20,0x3d,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,
+    0x2e,0x76,0x54,0x42,0x4e,0x20,0x3d,0x20,0x76,0x54,0x42,0x4e,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x76,
+    0x54,0x65,0x78,0x43,0x6f,0x6f,0x72,0x64,0x73,0x20,0x3d,0x20,0x76,0x54,0x65,0x78,
+    0x43,0x6f,0x6f,0x72,0x64,0x73,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,
+    0x72,0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,
+    0x0a,0x7d,0x0a,0x00,
+};
 static inline const sg_shader_desc* cube_shader_desc(sg_backend backend) {
     if (backend == SG_BACKEND_D3D11) {
         static sg_shader_desc desc;
@@ -349,9 +940,21 @@ static inline const sg_shader_desc* cube_shader_desc(sg_backend backend) {
             desc.attrs[5].base_type = SG_SHADERATTRBASETYPE_FLOAT;
             desc.attrs[5].hlsl_sem_name = "TEXCOORD";
             desc.attrs[5].hlsl_sem_index = 5;
+            desc.attrs[6].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[6].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[6].hlsl_sem_index = 6;
+            desc.attrs[7].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[7].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[7].hlsl_sem_index = 7;
+            desc.attrs[8].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[8].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[8].hlsl_sem_index = 8;
+            desc.attrs[9].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[9].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[9].hlsl_sem_index = 9;
             desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
             desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
-            desc.uniform_blocks[0].size = 256;
+            desc.uniform_blocks[0].size = 288;
             desc.uniform_blocks[0].hlsl_register_b_n = 0;
             desc.images[0].stage = SG_SHADERSTAGE_FRAGMENT;
             desc.images[0].image_type = SG_IMAGETYPE_2D;
@@ -364,9 +967,91 @@ static inline const sg_shader_desc* cube_shader_desc(sg_backend backend) {
             desc.image_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
             desc.image_sampler_pairs[0].image_slot = 0;
             desc.image_sampler_pairs[0].sampler_slot = 0;
+            desc.images[1].stage = SG_SHADERSTAGE_VERTEX;
+            desc.images[1].image_type = SG_IMAGETYPE_2D;
+            desc.images[1].sample_type = SG_IMAGESAMPLETYPE_UNFILTERABLE_FLOAT;
+            desc.images[1].multisampled = false;
+            desc.images[1].hlsl_register_t_n = 1;
+            desc.samplers[1].stage = SG_SHADERSTAGE_VERTEX;
+            desc.samplers[1].sampler_type = SG_SAMPLERTYPE_NONFILTERING;
+            desc.samplers[1].hlsl_register_s_n = 1;
+            desc.image_sampler_pairs[1].stage = SG_SHADERSTAGE_VERTEX;
+            desc.image_sampler_pairs[1].image_slot = 1;
+            desc.image_sampler_pairs[1].sampler_slot = 1;
             desc.label = "cube_shader";
         }
         return &desc;
     }
     return 0;
 }
+static inline const sg_shader_desc* cube_oct_shader_desc(sg_backend backend) {
+    if (backend == SG_BACKEND_D3D11) {
+        static sg_shader_desc desc;
+        static bool valid;
+        if (!valid) {
+            valid = true;
+            desc.vertex_func.source = (const char*)vs_oct_source_hlsl5;
+            desc.vertex_func.d3d11_target = "vs_5_0";
+            desc.vertex_func.entry = "main";
+            desc.fragment_func.source = (const char*)fs_source_hlsl5;
+            desc.fragment_func.d3d11_target = "ps_5_0";
+            desc.fragment_func.entry = "main";
+            desc.attrs[0].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[0].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[0].hlsl_sem_index = 0;
+            desc.attrs[1].base_type = SG_SHADERATTRBASETYPE_UINT;
+            desc.attrs[1].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[1].hlsl_sem_index = 1;
+            desc.attrs[2].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[2].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[2].hlsl_sem_index = 2;
+            desc.attrs[3].base_type = SG_SHADERATTRBASETYPE_UINT;
+            desc.attrs[3].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[3].hlsl_sem_index = 3;
+            desc.attrs[4].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[4].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[4].hlsl_sem_index = 4;
+            desc.attrs[5].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[5].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[5].hlsl_sem_index = 5;
+            desc.attrs[6].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[6].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[6].hlsl_sem_index = 6;
+            desc.attrs[7].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[7].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[7].hlsl_sem_index = 7;
+            desc.attrs[8].base_type = SG_SHADERATTRBASETYPE_FLOAT;
+            desc.attrs[8].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[8].hlsl_sem_index = 8;
+            desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
+            desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+            desc.uniform_blocks[0].size = 288;
+            desc.uniform_blocks[0].hlsl_register_b_n = 0;
+            desc.images[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.images[0].image_type = SG_IMAGETYPE_2D;
+            desc.images[0].sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+            desc.images[0].multisampled = false;
+            desc.images[0].hlsl_register_t_n = 0;
+            desc.samplers[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+            desc.samplers[0].hlsl_register_s_n = 0;
+            desc.image_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.image_sampler_pairs[0].image_slot = 0;
+            desc.image_sampler_pairs[0].sampler_slot = 0;
+            desc.images[1].stage = SG_SHADERSTAGE_VERTEX;
+            desc.images[1].image_type = SG_IMAGETYPE_2D;
+            desc.images[1].sample_type = SG_IMAGESAMPLETYPE_UNFILTERABLE_FLOAT;
+            desc.images[1].multisampled = false;
+            desc.images[1].hlsl_register_t_n = 1;
+            desc.samplers[1].stage = SG_SHADERSTAGE_VERTEX;
+            desc.samplers[1].sampler_type = SG_SAMPLERTYPE_NONFILTERING;
+            desc.samplers[1].hlsl_register_s_n = 1;
+            desc.image_sampler_pairs[1].stage = SG_SHADERSTAGE_VERTEX;
+            desc.image_sampler_pairs[1].image_slot = 1;
+            desc.image_sampler_pairs[1].sampler_slot = 1;
+            desc.label = "cube_oct_shader";
+        }
+        return &desc;
+    }
+    return 0;
+}
@@ -0,0 +1,193 @@
+/********************************************************************************
+*    Purpose: Creating and Joining threads, number of cores                     *
+*    Author : Anilcan Gulkaya 2025 anilcangulkaya7@gmail.com github @benanil    *
+********************************************************************************/
+
+#ifndef THREAD_H
+#define THREAD_H
+
+// AThread AThread_Create(fn, data);
+// void    AThread_Join(thread);
+// void    AThread_Yield();
+// int     GetNumCores(); // < number of logical processors
+// void    AMutex_Init(mutex); AMutex_Lock(mutex); AMutex_Unlock(mutex); AMutex_Destroy(mutex);
+// void    ASemaphore_Init(sem, initialCount); ASemaphore_Wait(sem); ASemaphore_Post(sem); ASemaphore_Destroy(sem);
+
+#include "Common.h"
+#include "Extern/rpmalloc.h"
+#include "Extern/c89atomic.h"
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <unistd.h>
+    #include <semaphore.h>
+#endif
+
+#define AX_MAX_THREADS 64
+
+typedef void(*AThreadFn)(void* data);
+
+typedef struct AThread_
+{
+    void* handle;
+} AThread;
+
+typedef struct AThreadStart_
+{
+    AThreadFn fn;
+    void* data;
+} AThreadStart;
+
+// every thread has to have it's own rpmalloc heap
+#ifdef _WIN32
+static DWORD WINAPI AThread_Start(LPVOID param)
+#else
+static void* AThread_Start(void* param)
+#endif
+{
+    AThreadStart start = *(AThreadStart*)param;
+    rpfree(param);
+    rpmalloc_thread_initialize();
+    start.fn(start.data);
+    rpmalloc_thread_finalize();
+    return 0;
+}
+
+static inline AThread AThread_Create(AThreadFn fn, void* data)
+{
+    AThreadStart* start = rpmalloc(sizeof(AThreadStart));
+    start->fn = fn;
+    start->data = data;
+
+    AThread thread;
+#ifdef _WIN32
+    thread.handle = CreateThread(NULL, 0, AThread_Start, start, 0, NULL);
+#else
+    pthread_t pthread;
+    pthread_create(&pthread, NULL, AThread_Start, start);
+    thread.handle = (void*)pthread;
+#endif
+    ASSERT(thread.handle);
+    return thread;
+}
+
+static inline void AThread_Join(AThread thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject((HANDLE)thread.handle, INFINITE);
+    CloseHandle((HANDLE)thread.handle);
+#else
+    pthread_join((pthread_t)thread.handle, NULL);
+#endif
+}
+
+static inline void AThread_Yield(void)
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static inline int GetNumCores(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int numCores = (int)info.dwNumberOfProcessors;
+#else
+    int numCores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return MMAX(MMIN(numCores, AX_MAX_THREADS), 1);
+}
+
+/*//////////////////////////////////////////////////////////////////////////*/
+/*                          Mutex and Semaphore                             */
+/*//////////////////////////////////////////////////////////////////////////*/
+
+#ifdef _WIN32
+typedef SRWLOCK AMutex;
+typedef HANDLE  ASemaphore;
+#else
+typedef pthread_mutex_t AMutex;
+typedef sem_t           ASemaphore;
+#endif
+
+static inline void AMutex_Init(AMutex* mutex)
+{
+#ifdef _WIN32
+    InitializeSRWLock(mutex);
+#else
+    pthread_mutex_init(mutex, NULL);
+#endif
+}
+
+static inline void AMutex_Lock(AMutex* mutex)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(mutex);
+#else
+    pthread_mutex_lock(mutex);
+#endif
+}
+
+static inline void AMutex_Unlock(AMutex* mutex)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(mutex);
+#else
+    pthread_mutex_unlock(mutex);
+#endif
+}
+
+static inline void AMutex_Destroy(AMutex* mutex)
+{
+#ifdef _WIN32
+    (void)mutex; // SRW locks doesn't need to be destroyed
+#else
+    pthread_mutex_destroy(mutex);
+#endif
+}
+
+static inline void ASemaphore_Init(ASemaphore* semaphore, int initialCount)
+{
+#ifdef _WIN32
+    *semaphore = CreateSemaphoreA(NULL, initialCount, INT32_MAX, NULL);
+#else
+    sem_init(semaphore, 0, (unsigned)initialCount);
+#endif
+}
+
+// blocks until the count is greater than zero, then decrements it
+static inline void ASemaphore_Wait(ASemaphore* semaphore)
+{
+#ifdef _WIN32
+    WaitForSingleObject(*semaphore, INFINITE);
+#else
+    while (sem_wait(semaphore) != 0) { } // retry if interrupted by a signal
+#endif
+}
+
+static inline void ASemaphore_Post(ASemaphore* semaphore)
+{
+#ifdef _WIN32
+    ReleaseSemaphore(*semaphore, 1, NULL);
+#else
+    sem_post(semaphore);
+#endif
+}
+
+static inline void ASemaphore_Destroy(ASemaphore* semaphore)
+{
+#ifdef _WIN32
+    CloseHandle(*semaphore);
+#else
+    sem_destroy(semaphore);
+#endif
+}
+
+#endif // THREAD_H